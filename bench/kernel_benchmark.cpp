@@ -0,0 +1,171 @@
+//
+// Created by 芦yafei  on 17/8/30.
+//
+
+#include "activation_function.h"
+#include "loss_function.h"
+#include "optimizer.h"
+#include "random.h"
+#include "cpu_dispatch.h"
+#include <benchmark/benchmark.h>
+
+using namespace lu_net;
+
+// Run the kernels of the level given by the first argument, false if the CPU lacks it.
+static bool use_level(benchmark::State &state) {
+    const cpu_level level = cpu_level(state.range(0));
+    if (level > detect_cpu_level()) {
+        state.SkipWithError("cpu level not supported");
+        return false;
+    }
+    set_cpu_level(level);
+    state.SetLabel(cpu_level_name(level));
+    return true;
+}
+
+// Args: size.
+template <typename Activation>
+static void BM_ActivationF(benchmark::State &state) {
+    Eigen::VectorXf x = Eigen::VectorXf::Random(state.range(0));
+    for (auto _ : state) {
+        Eigen::VectorXf a = Activation::f(x);
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Activation>
+static void BM_ActivationDf(benchmark::State &state) {
+    Eigen::VectorXf x = Eigen::VectorXf::Random(state.range(0));
+    for (auto _ : state) {
+        Eigen::VectorXf d = Activation::df(x);
+        benchmark::DoNotOptimize(d.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Sigmoid of the batched farward. Args: cpu_level, size.
+static void BM_SigmoidKernel(benchmark::State &state) {
+    if (!use_level(state)) return;
+    Eigen::VectorXf z = Eigen::VectorXf::Random(state.range(1));
+    Eigen::VectorXf a(z.size());
+    for (auto _ : state) {
+        kernels().sigmoid(z.data(), a.data(), z.size());
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    set_cpu_level(detect_cpu_level());
+}
+
+// Sigmoid and dropout of a training farward, a new mask every call. Args: cpu_level, size.
+static void BM_SigmoidDropoutKernel(benchmark::State &state) {
+    if (!use_level(state)) return;
+    Eigen::VectorXf z = Eigen::VectorXf::Random(state.range(1));
+    Eigen::VectorXf a(z.size());
+    std::vector<uint32_t> mask((z.size() + 31) / 32);
+    random_stream rng(1, 0);
+    for (auto _ : state) {
+        rng.bernoulli(mask.data(), z.size(), 0.5f);
+        kernels().sigmoid_dropout(z.data(), a.data(), mask.data(), 2.0f, z.size());
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    set_cpu_level(detect_cpu_level());
+}
+
+// Loss and gradient of one sample. Args: outputs.
+template <typename E>
+static void BM_Loss(benchmark::State &state) {
+    Eigen::VectorXf y = (Eigen::VectorXf::Random(state.range(0)).array() + 1) / 2;
+    Eigen::VectorXf t = Eigen::VectorXf::Zero(state.range(0));
+    t(0) = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(E::f(y, t));
+        Eigen::VectorXf d = E::df(y, t);
+        benchmark::DoNotOptimize(d.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// One update of a parameter block. Args: cpu_level, parameters.
+template <typename Optimizer>
+static void BM_Optimizer(benchmark::State &state) {
+    if (!use_level(state)) return;
+    Eigen::VectorXf W = Eigen::VectorXf::Random(state.range(1));
+    Eigen::VectorXf dW = Eigen::VectorXf::Random(state.range(1)) * 1e-3;
+    Optimizer optimizer;
+    for (auto _ : state) {
+        optimizer.update(W.data(), dW.data(), W.size(), 1e-3);
+        benchmark::DoNotOptimize(W.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.SetBytesProcessed(state.iterations() * state.range(1) * sizeof(float));
+    set_cpu_level(detect_cpu_level());
+}
+
+// Bulk Philox uniforms or normals, against mt19937 with std::normal_distribution. Args: cpu_level, size.
+static void BM_PhiloxUniform(benchmark::State &state) {
+    if (!use_level(state)) return;
+    Eigen::VectorXf x(state.range(1));
+    random_stream rng(1, 0);
+    for (auto _ : state) {
+        rng.uniform(x.data(), x.size(), 0, 1);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    set_cpu_level(detect_cpu_level());
+}
+
+static void BM_PhiloxGaussian(benchmark::State &state) {
+    if (!use_level(state)) return;
+    Eigen::VectorXf x(state.range(1));
+    random_stream rng(1, 0);
+    for (auto _ : state) {
+        rng.gaussian(x.data(), x.size(), 0, 1);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    set_cpu_level(detect_cpu_level());
+}
+
+// Args: size.
+static void BM_StdGaussian(benchmark::State &state) {
+    Eigen::VectorXf x(state.range(0));
+    std::mt19937 gen(1);
+    std::normal_distribution<float> normal(0, 1);
+    for (auto _ : state) {
+        for (long i = 0; i < x.size(); i++) x[i] = normal(gen);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void LevelArgs(benchmark::internal::Benchmark *b) {
+    for (int level = int(cpu_level::generic); level <= int(cpu_level::avx512); level++) {
+        for (int size : {1 << 12, 1 << 20}) {
+            b->Args({level, size});
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ActivationF, activation::sigmoid)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_ActivationDf, activation::sigmoid)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_ActivationF, activation::relu)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_ActivationDf, activation::relu)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_ActivationF, activation::tanh)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_ActivationDf, activation::tanh)->Arg(1 << 12);
+BENCHMARK(BM_SigmoidKernel)->Apply(LevelArgs);
+BENCHMARK(BM_SigmoidDropoutKernel)->Apply(LevelArgs);
+BENCHMARK(BM_PhiloxUniform)->Apply(LevelArgs);
+BENCHMARK(BM_PhiloxGaussian)->Apply(LevelArgs);
+BENCHMARK(BM_StdGaussian)->Arg(1 << 12)->Arg(1 << 20);
+
+BENCHMARK_TEMPLATE(BM_Loss, MSE)->Arg(10)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_Loss, cross_entropy)->Arg(10)->Arg(1000);
+
+BENCHMARK_TEMPLATE(BM_Optimizer, optimizer::gradient_descent)->Apply(LevelArgs);
+BENCHMARK_TEMPLATE(BM_Optimizer, optimizer::momentum)->Apply(LevelArgs);
+BENCHMARK_TEMPLATE(BM_Optimizer, optimizer::adagrad)->Apply(LevelArgs);
+BENCHMARK_TEMPLATE(BM_Optimizer, optimizer::RMSprop)->Apply(LevelArgs);
+BENCHMARK_TEMPLATE(BM_Optimizer, optimizer::adam)->Apply(LevelArgs);
+BENCHMARK_TEMPLATE(BM_Optimizer, optimizer::adamw)->Apply(LevelArgs);
@@ -0,0 +1,75 @@
+//
+// Created by 芦yafei  on 17/8/18.
+//
+
+#include "lstm.h"
+#include "gru.h"
+#include <benchmark/benchmark.h>
+
+using namespace lu_net;
+
+static const int kSteps = 32;
+
+// Args: hidden size (= input size), batch size. Items are samples times steps.
+template <typename Param, typename Layer>
+static void BM_RecurrentFarward(benchmark::State &state) {
+    const int H = int(state.range(0)), B = int(state.range(1));
+    Param param(H, H);
+    Layer layer(param);
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(H, kSteps * B);
+
+    for (auto _ : state) {
+        layer.farward_prop(x, B);
+        benchmark::DoNotOptimize(layer.h().data());
+    }
+    state.SetItemsProcessed(state.iterations() * kSteps * B);
+}
+
+template <typename Param, typename Layer>
+static void BM_RecurrentTrain(benchmark::State &state) {
+    const int H = int(state.range(0)), B = int(state.range(1));
+    Param param(H, H);
+    Layer layer(param);
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(H, kSteps * B);
+    Eigen::MatrixXf top_diff_h = Eigen::MatrixXf::Random(H, kSteps * B);
+
+    for (auto _ : state) {
+        layer.farward_prop(x, B);
+        layer.back_prop(top_diff_h);
+        benchmark::DoNotOptimize(param.w_diff.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kSteps * B);
+}
+
+// One step of independent streaming sessions. Args: hidden size (= input size), sessions.
+template <typename Param, typename Inference, typename Session>
+static void BM_RecurrentStep(benchmark::State &state) {
+    const int H = int(state.range(0)), B = int(state.range(1));
+    Param param(H, H);
+    Inference inference(param);
+    std::vector<Session> sessions(B, inference.new_session());
+    std::vector<Session *> session_ptrs;
+    for (auto &session : sessions) session_ptrs.push_back(&session);
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(H, B);
+
+    for (auto _ : state) {
+        inference.step(session_ptrs, x);
+        benchmark::DoNotOptimize(sessions[0].h.data());
+    }
+    state.SetItemsProcessed(state.iterations() * B);
+}
+
+static void RecurrentArgs(benchmark::internal::Benchmark *b) {
+    for (int H : {64, 256}) {
+        for (int B : {1, 16, 64}) {
+            b->Args({H, B});
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_RecurrentFarward, LstmParam, LstmLayer)->Apply(RecurrentArgs);
+BENCHMARK_TEMPLATE(BM_RecurrentTrain, LstmParam, LstmLayer)->Apply(RecurrentArgs);
+BENCHMARK_TEMPLATE(BM_RecurrentFarward, GruParam, GruLayer)->Apply(RecurrentArgs);
+BENCHMARK_TEMPLATE(BM_RecurrentTrain, GruParam, GruLayer)->Apply(RecurrentArgs);
+BENCHMARK_TEMPLATE(BM_RecurrentStep, LstmParam, LstmInference, LstmSession)->Apply(RecurrentArgs);
+BENCHMARK_TEMPLATE(BM_RecurrentStep, GruParam, GruInference, GruSession)->Apply(RecurrentArgs);
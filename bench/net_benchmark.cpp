@@ -0,0 +1,222 @@
+//
+// Created by 芦yafei  on 17/8/30.
+//
+
+#include "net.h"
+#include "loss_function.h"
+#include "optimizer.h"
+#include "random.h"
+#include "mnist_parser.h"
+#include "alloc_tracker.h"
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+using namespace lu_net;
+
+// Keep the INFO logs of initNet and train out of the measurements.
+static const int kQuietLogs = (FLAGS_minloglevel = 1, 0);
+
+// Layer shapes selected by the first argument, MNIST sized inputs.
+static const std::vector<std::vector<int> > kShapes = {{784, 30, 10}, {784, 100, 10}, {784, 300, 100, 10}};
+
+// Minibatches per train() call of BM_NetTrain
+static const int kTrainBatches = 8;
+
+static void init_net(Net &net, int shape) {
+    net.initNet(kShapes[shape], 0.1, 0);
+    net.initWeights();
+    net.initBias();
+}
+
+static void random_samples(int shape, int size, std::vector<vec_t> &inputs, std::vector<label_t> &labels) {
+    const int input_dim = kShapes[shape].front();
+    const int classes = kShapes[shape].back();
+    inputs.assign(size, vec_t(input_dim));
+    labels.resize(size);
+    for (int i = 0; i < size; i++) {
+        for (auto &e : inputs[i]) e = uniform_rand(0.0f, 1.0f);
+        labels[i] = label_t(uniform_rand(0, classes - 1));
+    }
+}
+
+static std::string temp_path(const std::string &name) {
+    const char *dir = std::getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/lu_net_bench_" + name;
+}
+
+static long file_size(const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    return long(file.tellg());
+}
+
+// Farward of one sample. Args: shape.
+static void BM_NetPredict(benchmark::State &state) {
+    Net net;
+    init_net(net, int(state.range(0)));
+    std::vector<vec_t> inputs;
+    std::vector<label_t> labels;
+    random_samples(int(state.range(0)), 1, inputs, labels);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(net.predict_one(inputs[0]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Batched farward of test(). Args: shape, samples.
+static void BM_NetTest(benchmark::State &state) {
+    Net net;
+    init_net(net, int(state.range(0)));
+    std::vector<vec_t> inputs;
+    std::vector<label_t> labels;
+    random_samples(int(state.range(0)), int(state.range(1)), inputs, labels);
+
+    for (auto _ : state) {
+        result r = net.test(inputs, labels);
+        benchmark::DoNotOptimize(r.num_success);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+// One epoch of farward, backward and update over kTrainBatches minibatches. Args: shape, batch size, mixed precision.
+static void BM_NetTrain(benchmark::State &state) {
+    const int batch_size = int(state.range(1));
+    Net net;
+    init_net(net, int(state.range(0)));
+    net.mixed_precision = state.range(2) != 0;
+    std::vector<vec_t> inputs;
+    std::vector<label_t> labels;
+    random_samples(int(state.range(0)), batch_size * kTrainBatches, inputs, labels);
+    optimizer::gradient_descent optimizer;
+
+    alloc_tracker::reset_peak();
+    alloc_tracker::usage before = alloc_tracker::current();
+    for (auto _ : state) {
+        net.train<cross_entropy>(optimizer, inputs, labels, batch_size, 1);
+        benchmark::DoNotOptimize(net.get_params().data());
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size * kTrainBatches);
+
+    // heap use of the training, to keep allocation regressions visible in the JSON results
+    if (alloc_tracker::enabled()) {
+        alloc_tracker::usage after = alloc_tracker::current();
+        state.counters["allocs_per_batch"] = double(after.allocations - before.allocations) /
+                                             (state.iterations() * kTrainBatches);
+        state.counters["heap_peak_mb"] = (after.peak_bytes - before.in_use_bytes) / (1024.0 * 1024.0);
+    }
+}
+
+// Args: shape, file_format.
+static void BM_NetSave(benchmark::State &state) {
+    const file_format format = file_format(state.range(1));
+    const std::string filename = temp_path("save");
+    Net net;
+    init_net(net, int(state.range(0)));
+
+    for (auto _ : state) {
+        net.save(filename, content_type::weights_and_model, format);
+    }
+    state.SetBytesProcessed(state.iterations() * file_size(filename));
+    std::remove(filename.c_str());
+}
+
+// Args: shape, file_format.
+static void BM_NetLoad(benchmark::State &state) {
+    const file_format format = file_format(state.range(1));
+    const std::string filename = temp_path("load");
+    {
+        Net net;
+        init_net(net, int(state.range(0)));
+        net.save(filename, content_type::weights_and_model, format);
+    }
+
+    Net net;
+    for (auto _ : state) {
+        if (!net.load(filename, content_type::weights_and_model, format)) {
+            state.SkipWithError("load failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * file_size(filename));
+    std::remove(filename.c_str());
+}
+
+static void write_big_endian(std::ofstream &file, int v) {
+    const char bytes[4] = {char(v >> 24), char(v >> 16), char(v >> 8), char(v)};
+    file.write(bytes, 4);
+}
+
+// Parse images and labels in the MNIST idx format. Args: number of 28 x 28 images.
+static void BM_MnistLoad(benchmark::State &state) {
+    const int size = int(state.range(0));
+    const std::string images_file = temp_path("images.idx3-ubyte");
+    const std::string labels_file = temp_path("labels.idx1-ubyte");
+    {
+        std::ofstream images(images_file, std::ios::binary);
+        write_big_endian(images, 2051);
+        write_big_endian(images, size);
+        write_big_endian(images, 28);
+        write_big_endian(images, 28);
+        std::ofstream labels(labels_file, std::ios::binary);
+        write_big_endian(labels, 2049);
+        write_big_endian(labels, size);
+        for (int i = 0; i < size; i++) {
+            for (int k = 0; k < 28 * 28; k++) images.put(char(uniform_rand(0, 255)));
+            labels.put(char(uniform_rand(0, 9)));
+        }
+    }
+
+    for (auto _ : state) {
+        std::vector<vec_t> images;
+        std::vector<label_t> labels;
+        read_Mnist_Images(images_file, images);
+        read_Mnist_Label(labels_file, labels);
+        benchmark::DoNotOptimize(images.data());
+        benchmark::DoNotOptimize(labels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * (file_size(images_file) + file_size(labels_file)));
+    std::remove(images_file.c_str());
+    std::remove(labels_file.c_str());
+}
+
+static void ShapeArgs(benchmark::internal::Benchmark *b) {
+    for (int shape = 0; shape < int(kShapes.size()); shape++) {
+        b->Args({shape});
+    }
+}
+
+static void ShapeBatchArgs(benchmark::internal::Benchmark *b) {
+    for (int shape = 0; shape < int(kShapes.size()); shape++) {
+        for (int batch : {1, 32, 256}) {
+            b->Args({shape, batch});
+        }
+    }
+}
+
+static void TrainArgs(benchmark::internal::Benchmark *b) {
+    for (int shape = 0; shape < int(kShapes.size()); shape++) {
+        // train() skips minibatches of one sample
+        for (int batch : {8, 32, 128}) {
+            b->Args({shape, batch, 0});
+        }
+        b->Args({shape, 128, 1});
+    }
+}
+
+static void FileArgs(benchmark::internal::Benchmark *b) {
+    for (int shape = 0; shape < int(kShapes.size()); shape++) {
+        b->Args({shape, int(file_format::binary)});
+        b->Args({shape, int(file_format::json)});
+    }
+}
+
+BENCHMARK(BM_NetPredict)->Apply(ShapeArgs);
+BENCHMARK(BM_NetTest)->Apply(ShapeBatchArgs);
+BENCHMARK(BM_NetTrain)->Apply(TrainArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NetSave)->Apply(FileArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NetLoad)->Apply(FileArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MnistLoad)->Arg(1000)->Unit(benchmark::kMillisecond);
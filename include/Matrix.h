@@ -9,11 +9,37 @@
 #include "../proto/lu.pb.h"
 
 namespace lu_net {
-    inline void ReadMatrix(const MatrixMsg &msg, Eigen::MatrixXf *mat) {
+    // false if msg is not a well formed dense or CSR matrix, e.g. of a truncated or corrupt file
+    inline bool ReadMatrix(const MatrixMsg &msg, Eigen::MatrixXf *mat) {
+        if (msg.row_ptr_size() > 0) {
+            // CSR
+            if (msg.row_ptr_size() != int64_t(msg.rows()) + 1 || msg.row_ptr(0) != 0 ||
+                msg.col_index_size() != msg.data_size() || msg.row_ptr(msg.rows()) != uint32_t(msg.data_size())) {
+                return false;
+            }
+            *mat = Eigen::MatrixXf::Zero(msg.rows(), msg.cols());
+            for (int ii = 0; ii < int(msg.rows()); ii++) {
+                if (msg.row_ptr(ii) > msg.row_ptr(ii + 1)) {
+                    return false;
+                }
+                for (uint32_t kk = msg.row_ptr(ii); kk < msg.row_ptr(ii + 1); kk++) {
+                    if (msg.col_index(kk) >= msg.cols()) {
+                        return false;
+                    }
+                    mat->operator()(ii, msg.col_index(kk)) = msg.data(kk);
+                }
+            }
+            return true;
+        }
+
+        if (msg.rows() == 0 || msg.data_size() % msg.rows() != 0) {
+            return false;
+        }
         mat->resize(msg.rows(), msg.data_size() / msg.rows());
         for (int ii = 0; ii < msg.data_size(); ii++) {
             mat->operator()(ii) = msg.data(ii);
         }
+        return true;
     }
 
     inline void ReadVector(const VectorMsg &msg, Eigen::VectorXf *vec) {
@@ -23,15 +49,34 @@ namespace lu_net {
         }
     }
 
-    inline void WriteMatrix(const Eigen::MatrixXf &mat, MatrixMsg *msg) {
+    inline void WriteMatrix(const Eigen::Ref<const Eigen::MatrixXf> &mat, MatrixMsg *msg) {
         msg->set_rows(mat.rows());
         msg->mutable_data()->Reserve(mat.rows() * mat.cols());
-        for (int ii = 0; ii < mat.cols() * mat.rows(); ii++) {
-            msg->add_data(mat(ii));
+        // column major
+        for (int jj = 0; jj < mat.cols(); jj++) {
+            for (int ii = 0; ii < mat.rows(); ii++) {
+                msg->add_data(mat(ii, jj));
+            }
+        }
+    }
+
+    // CSR of the non-zeros of mat, smaller than WriteMatrix when less than about half of mat is non-zero
+    inline void WriteSparseMatrix(const Eigen::Ref<const Eigen::MatrixXf> &mat, MatrixMsg *msg) {
+        msg->set_rows(mat.rows());
+        msg->set_cols(mat.cols());
+        msg->add_row_ptr(0);
+        for (int ii = 0; ii < mat.rows(); ii++) {
+            for (int jj = 0; jj < mat.cols(); jj++) {
+                if (mat(ii, jj) != 0) {
+                    msg->add_col_index(jj);
+                    msg->add_data(mat(ii, jj));
+                }
+            }
+            msg->add_row_ptr(msg->data_size());
         }
     }
 
-    inline void WriteVector(const Eigen::VectorXf &mat, VectorMsg *msg) {
+    inline void WriteVector(const Eigen::Ref<const Eigen::VectorXf> &mat, VectorMsg *msg) {
         msg->mutable_data()->Reserve(mat.rows());
         for (int ii = 0; ii < mat.rows(); ii++) {
             msg->add_data(mat(ii));
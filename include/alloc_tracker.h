@@ -0,0 +1,91 @@
+//
+// Created by 芦yafei  on 17/9/9.
+//
+#ifndef LU_NET_ALLOC_TRACKER_H
+#define LU_NET_ALLOC_TRACKER_H
+
+#include <cstdint>
+#include <ostream>
+
+namespace lu_net {
+    namespace alloc_tracker {
+
+        // Owners of heap memory, set by LU_NET_ALLOC_TAG around the allocations
+        enum class subsystem {
+            other,              // not tagged
+            dataset,            // training data and the copies of it made for the minibatches
+            params,             // weights and bias
+            grads,              // gradients of the params
+            optimizer_state,    // moments and step counts of the optimizers
+            activations         // weighted inputs, activations and errors of farward and backward
+        };
+
+        const int kSubsystems = 6;
+
+        const char *subsystem_name(subsystem s);
+
+        /**
+         * Heap usage of the process. Counts are cumulative since the start of the process,
+         * bytes are the requested sizes without the allocator overhead.
+         **/
+        struct usage {
+            long allocations = 0;
+            long frees = 0;
+            uint64_t allocated_bytes = 0;
+            int64_t in_use_bytes = 0;
+            int64_t peak_bytes = 0;                         // high-water mark of in_use_bytes since reset_peak()
+            int64_t subsystem_bytes[kSubsystems] = {0, 0, 0, 0, 0, 0};   // in use, by the tag at allocation
+        };
+
+        /**
+         * true if built with LU_NET_TRACK_ALLOC (cmake -DLU_NET_TRACK_ALLOC=ON).
+         *
+         * The tracker replaces the global operator new and delete, and on glibc malloc, calloc, realloc,
+         * free and the aligned variants too, which is where the heap memory of Eigen comes from.
+         * Every block carries a 32 byte header with its size and tag. Without LU_NET_TRACK_ALLOC nothing
+         * is replaced and usage() stays zero.
+         **/
+        bool enabled();
+
+        usage current();
+
+        // start a new high-water mark from the bytes in use now
+        void reset_peak();
+
+        // usage as a table of the subsystems
+        void print(std::ostream &out);
+
+        /**
+         * Allocations of the calling thread are tagged with s until the tag is destroyed,
+         * use it through LU_NET_ALLOC_TAG. Blocks keep their tag when they are freed by other code.
+         **/
+        class tag {
+        public:
+            explicit tag(subsystem s);
+
+            ~tag();
+
+            tag(const tag &) = delete;
+            tag &operator=(const tag &) = delete;
+
+        private:
+            int previous_;
+        };
+    }
+}
+
+#define LU_NET_ALLOC_TAG_CONCAT_(a, b) a##b
+#define LU_NET_ALLOC_TAG_CONCAT(a, b) LU_NET_ALLOC_TAG_CONCAT_(a, b)
+
+/**
+ * Tag the allocations of the rest of the enclosing block with subsystem s (a lu_net::alloc_tracker::subsystem
+ * name). Builds without LU_NET_TRACK_ALLOC compile it to nothing.
+ **/
+#ifdef LU_NET_TRACK_ALLOC
+#define LU_NET_ALLOC_TAG(s) \
+    ::lu_net::alloc_tracker::tag LU_NET_ALLOC_TAG_CONCAT(lu_net_alloc_tag_, __LINE__)(::lu_net::alloc_tracker::subsystem::s)
+#else
+#define LU_NET_ALLOC_TAG(s) do {} while (0)
+#endif
+
+#endif //LU_NET_ALLOC_TRACKER_H
@@ -0,0 +1,83 @@
+//
+// Created by 芦yafei  on 17/8/28.
+//
+#ifndef LU_NET_CPU_DISPATCH_H
+#define LU_NET_CPU_DISPATCH_H
+
+#include <cstdint>
+
+namespace lu_net {
+
+    /**
+     * Instruction set levels the hot kernels are compiled for, each includes the ones before.
+     * avx2 also needs FMA, avx512 needs F, BW, DQ, VL and VNNI.
+     **/
+    enum class cpu_level {
+        generic,    // baseline of the target, SSE2 on x86-64
+        sse42,
+        avx2,
+        avx512
+    };
+
+    /**
+     * Hot loops which do not go through Eigen, compiled once per cpu_level.
+     * Eigen GEMMs keep the instruction set the whole tree is compiled for, compiling Eigen templates
+     * for several levels would let the linker mix their inline functions.
+     **/
+    struct kernel_table {
+        cpu_level level;
+
+        // a = 1 / (1 + exp(-z)), a may be z
+        void (*sigmoid)(const float *z, float *a, long size);
+
+        // optimizer updates, see optimizer.h
+        void (*gradient_descent)(float *W, const float *dW, long size, float alpha, float lambda);
+        void (*momentum)(float *W, float *V, const float *dW, long size, float alpha, float lambda, float mu);
+        void (*adagrad)(float *W, float *g, const float *dW, long size, float alpha, float eps);
+        void (*rmsprop)(float *W, float *g, const float *dW, long size, float alpha, float mu, float eps);
+        void (*adam)(float *W, float *mt, float *vt, const float *dW, long size,
+                     float b1, float b2, float step, float eps_hat, float decay);
+
+        // q = clamp(int(x * inv_scale + offset), 0, 127), see quantize.h
+        void (*quantize_u8)(const float *x, uint8_t *q, long size, float inv_scale, float offset);
+
+        // dot products of two uint8 columns a0, a1 with four int8 rows w[0] ~ w[3], size multiple of 32
+        void (*dot4x2_u8s8)(const uint8_t *a0, const uint8_t *a1, const int8_t *const *w, int size,
+                            int32_t *out0, int32_t *out1);
+
+        // size values of the Philox4x32-10 blocks (block, stream), (block + 1, stream) ~, four per block,
+        // see random_stream in random.h. Uniform in [min, max), or normal by Box-Muller.
+        void (*philox_uniform)(const uint32_t *key, uint64_t stream, uint64_t block, float *out, long size,
+                               float min, float max);
+        void (*philox_gaussian)(const uint32_t *key, uint64_t stream, uint64_t block, float *out, long size,
+                                float mean, float sigma);
+        // bit j of the (size + 31) / 32 words of mask is set if value j is below threshold, values as above
+        void (*philox_mask)(const uint32_t *key, uint64_t stream, uint64_t block, uint32_t *mask, long size,
+                            uint32_t threshold);
+
+        // a = scale / (1 + exp(-z)) where the bit of mask is set, 0 elsewhere: sigmoid then dropout, a may be z
+        void (*sigmoid_dropout)(const float *z, float *a, const uint32_t *mask, float scale, long size);
+    };
+
+    // Highest level the CPU and the OS support.
+    cpu_level detect_cpu_level();
+
+    /**
+     * Level of the kernels in use. The first call picks detect_cpu_level(), or the level named by the
+     * environment variable LU_NET_CPU_LEVEL (generic, sse42, avx2, avx512) if it is supported.
+     **/
+    cpu_level get_cpu_level();
+
+    /**
+     * Force a level, e.g. to test the kernels of older CPUs. Levels above detect_cpu_level() are lowered to it.
+     * Kernel calls running in other threads may still finish with the previous level.
+     **/
+    void set_cpu_level(cpu_level level);
+
+    const char *cpu_level_name(cpu_level level);
+
+    // Kernels of the current level.
+    const kernel_table &kernels();
+}
+
+#endif //LU_NET_CPU_DISPATCH_H
@@ -4,7 +4,11 @@
 #ifndef LU_NET_DROPOUT_H
 #define LU_NET_DROPOUT_H
 
+#include <cstdint>
+#include <vector>
 #include <eigen3/Eigen/Dense>
+#include "net.h"
+#include "random.h"
 
 namespace lu_net{
     /**
@@ -12,26 +16,57 @@ namespace lu_net{
     * With probability keep_prob, outputs the input element scaled up by 1 / keep_prob, otherwise outputs 0.
     * The scaling is so that the expected sum is unchanged.
      * @keep_prob : The probability that each element is kept.
+     *
+     * The mask of the last forward is kept for backward as packed bits, one per unit, drawn in bulk from rng.
+     * Units may be a single sample (in_dim) or the columns of a batch (in_dim times the batch size).
     **/
     class dropout_layer {
     public:
-        dropout_layer(int in_dim, float_t keep_prob, net_phase phase = net_phase::train)
-                : keep_prob_(keep_prob),
-                  phase_(phase),
+        dropout_layer(int in_dim, float_t keep_prob, net_phase phase = net_phase::train,
+                      random_stream rng = random_stream())
+                : phase_(phase),
+                  keep_prob_(keep_prob),
                   scale_(1.0 / keep_prob),
-                  in_size_(in_dim)
+                  in_size_(in_dim),
+                  rng_(rng)
         {
-            mask_.Zero(in_dim);
+            assert(keep_prob > 0 && keep_prob <= 1);
         }
 
+        void set_phase(net_phase phase) { phase_ = phase; }
+
+        net_phase phase() const { return phase_; }
+
+        float_t keep_prob() const { return keep_prob_; }
+
+        int in_size() const { return in_size_; }
+
+        // draw the mask of size units
+        void new_mask(long size);
+
+        // sigmoid then dropout, a = sigmoid(z) * mask * scale in one pass over the size units of z.
+        // Draws a new mask in the train phase, test phase is the plain sigmoid.
+        void forward_sigmoid(const float *z, float *a, long size);
+
+        // out = in * mask * scale over size units with a new mask in the train phase, out = in at test, out may be in
+        void forward(const float *in, float *out, long size);
+
+        // in_grad = out_grad * mask * scale with the mask of the last forward, in_grad may be out_grad
+        void backward(const float *out_grad, float *in_grad, long size);
+
         void forward_propagation(const Eigen::VectorXf &in_data, Eigen::VectorXf &out_data);
-        void back_propagation(Eigen::VectorXf &out_grad, Eigen::VectorXf &in_grad);
+
+        // in_grad = out_grad * mask * scale with the mask of the last forward, in_grad may be out_grad
+        void back_propagation(const Eigen::VectorXf &out_grad, Eigen::VectorXf &in_grad);
+
     private:
         net_phase phase_;
         float_t keep_prob_;
         float_t scale_;
         int in_size_;
-        Eigen::VectorXi mask_;
+        random_stream rng_;
+        std::vector<uint32_t> mask_;    // bit j of mask_[j / 32] is set if unit j is kept
+        long mask_size_ = 0;            // units of mask_
     };
 }
 
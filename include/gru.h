@@ -0,0 +1,181 @@
+//
+// Created by 芦yafei  on 17/8/14.
+//
+#ifndef LU_NET_GRU_H
+#define LU_NET_GRU_H
+
+#include <eigen3/Eigen/Dense>
+#include "optimizer.h"
+#include "recurrent.h"
+#include <vector>
+
+namespace lu_net{
+    /**
+     * Gated recurrent unit
+     *
+     * K Cho, B van Merrienboer, C Gulcehre, D Bahdanau, F Bougares, H Schwenk and Y Bengio,
+     * Learning Phrase Representations using RNN Encoder-Decoder for Statistical Machine Translation, 2014.
+     *
+     * r = sigmoid(W_r x(t) + U_r h(t - 1) + b_r)
+     * z = sigmoid(W_z x(t) + U_z h(t - 1) + b_z)
+     * n = tanh(W_n x(t) + r * (U_n h(t - 1) + b_hn) + b_n)
+     * h(t) = (1 - z) * n + z * h(t - 1)
+     *
+     * The reset gate is applied after U_n as in cuDNN, so all recurrent weights are one GEMM per step.
+     **/
+    class GruParam {
+    public:
+        GruParam(int mem_cell_num, int x_dim);
+
+        ~GruParam();
+
+        void param_update(float lr);
+
+        int mem_cell_num_ = 0;      // GRU cell num
+        int x_dim_ = 0;             // Dimensions of input x
+        int concat_len_ = 0;        // GRU cell num + dimensions of input x
+
+        // Weight matrices of the three gates stacked by rows: reset gate r, update gate z, candidate n.
+        // Columns follow the concatenated input [x(t), h(t - 1)], so w is 3H x concat_len_.
+        Eigen::MatrixXf w;
+
+        // Bias terms of the input side, stacked as w
+        Eigen::VectorXf b;
+
+        // Bias of U_n h(t - 1), inside the reset gate
+        Eigen::VectorXf b_hn;
+
+        // Diffs (derivative of loss function for all parameters)
+        Eigen::MatrixXf w_diff;
+        Eigen::VectorXf b_diff;
+        Eigen::VectorXf b_hn_diff;
+
+        // Columns of w applied to x(t) and to h(t - 1)
+        Eigen::MatrixXf::ColsBlockXpr w_x() { return w.leftCols(x_dim_); }
+        Eigen::MatrixXf::ColsBlockXpr w_h() { return w.rightCols(mem_cell_num_); }
+        Eigen::MatrixXf::ConstColsBlockXpr w_x() const { return w.leftCols(x_dim_); }
+        Eigen::MatrixXf::ConstColsBlockXpr w_h() const { return w.rightCols(mem_cell_num_); }
+    };
+
+
+    /**
+     * States of a minibatch of GRU sequences, gates hold the activations of [r; z; n] followed by
+     * U_n h(t - 1) + b_hn, which the back propagation of the reset gate needs.
+     **/
+    class GruSequenceState : public SequenceState {
+    public:
+        GruSequenceState(int mem_cell_num, int x_dim, int batch_size = 1);
+    };
+
+
+    /**
+     * GRU over a minibatch of sequences, same layout and GEMM structure as LstmLayer:
+     * the input projection of all steps is one GEMM, then one recurrent GEMM per step
+     * over the sequences still running.
+     **/
+    class GruLayer {
+    public:
+        GruLayer(GruParam &gruParam);
+
+        ~GruLayer();
+
+        /**
+         * Forward propagation from zero initial states.
+         * @x: x_dim x (steps * batch_size) inputs
+         * **/
+        void farward_prop(const Eigen::MatrixXf &x, int batch_size);
+
+        /**
+         * Forward propagation of packed sequences of different lengths from zero initial states,
+         * see SequenceState for the layout.
+         * @x: x_dim x sum(batch_sizes) inputs
+         * @batch_sizes: sequences still running at each step, non-increasing
+         * **/
+        void farward_prop(const Eigen::MatrixXf &x, const std::vector<int> &batch_sizes);
+
+        /**
+         * Forward propagation of more steps of the stored sequences, continues from their last states.
+         * @x: x_dim x (steps * batch_size) inputs
+         * **/
+        void farward_append(const Eigen::MatrixXf &x);
+
+        /**
+         * Back propagation through time, accumulates into the diffs of the GruParam.
+         * @top_diff_h: mem_cell_num x columns derivative of loss with respect to h, same layout as h()
+         * **/
+        void back_prop(const Eigen::MatrixXf &top_diff_h);
+
+        // Drop the stored steps and start from zero states
+        void reset() { state_.reset(); }
+
+        void reset(int batch_size) { state_.reset(batch_size); }
+
+        GruSequenceState &state() { return state_; }
+
+        // Outputs of all steps, same layout as the inputs
+        Eigen::MatrixXf::ConstColsBlockXpr h() const { return state_.h(); }
+
+        int steps() const { return state_.steps(); }
+
+        int batch_size() const { return state_.batch_size(); }
+
+    private:
+        // input projection of the steps from first to the last stored one, then the cells one by one
+        void farward_from(int first, const Eigen::MatrixXf &x);
+
+        GruParam &param_;
+        GruSequenceState state_;
+        Eigen::MatrixXf gh_;        // U h(t - 1) of one step
+        Eigen::MatrixXf dgx_;       // derivative of loss with respect to the input side of the gates, all steps
+        Eigen::MatrixXf dgh_;       // derivative of loss with respect to U h(t - 1), all steps
+        Eigen::MatrixXf h_prev_;    // h(t - 1) of all steps
+    };
+
+
+    /**
+     * State of one stream for GruInference, only the current h.
+     * Copy it to snapshot the stream and assign the copy back to restore it.
+     **/
+    class GruSession {
+    public:
+        explicit GruSession(int mem_cell_num = 0);
+
+        Eigen::VectorXf h;
+    };
+
+
+    /**
+     * Stateful streaming inference, pushes one step of input at a time and keeps no history.
+     * Sessions stepped together share one input GEMM and one recurrent GEMM.
+     **/
+    class GruInference {
+    public:
+        GruInference(const GruParam &gruParam);
+
+        ~GruInference();
+
+        // Session with zero state
+        GruSession new_session() const;
+
+        /**
+         * Advance one session by one step, the output is session.h
+         * **/
+        void step(GruSession &session, const Eigen::VectorXf &x);
+
+        /**
+         * Advance several sessions by one step each.
+         * @x: x_dim x sessions.size() inputs, column n goes to sessions[n]
+         * **/
+        void step(const std::vector<GruSession*> &sessions, const Eigen::MatrixXf &x);
+
+    private:
+        const GruParam &param_;
+
+        // workspace of the sessions stepped together
+        Eigen::MatrixXf gates_;
+        Eigen::MatrixXf h_prev_;
+        Eigen::MatrixXf h_;
+        Eigen::MatrixXf gh_;
+    };
+}
+#endif //LU_NET_GRU_H
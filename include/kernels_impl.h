@@ -0,0 +1,436 @@
+//
+// Created by 芦yafei  on 17/8/28.
+//
+// Bodies of the kernels of cpu_dispatch.h, included once per instruction set level by the
+// src/kernels_*.cpp files after defining LU_NET_KERNEL_LEVEL. The compile flags of each file pick
+// the intrinsics below and let the plain loops vectorize.
+//
+// Everything here is static and uses no inline functions of other headers, so that code built for
+// a higher level can never be linked into a lower one.
+//
+#ifndef LU_NET_KERNEL_LEVEL
+#error "define LU_NET_KERNEL_LEVEL before including kernels_impl.h"
+#endif
+
+#include <cstdint>
+#include "cpu_dispatch.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace lu_net {
+namespace cpu_kernels {
+namespace LU_NET_KERNEL_LEVEL {
+
+    // int8 rows and columns are padded to kAlign bytes, one 256 bit register
+    static const int kAlign = 32;
+
+    // Largest quantized activation, 7 bits
+    static const int kQuantMax = 127;
+
+    /**
+     * exp(x) for x in [-87, 88], Cephes expf: x = k * ln2 + r, exp(r) by a polynomial, 2^k in the exponent bits.
+     * Branch free so the callers vectorize.
+     **/
+    static inline float exp_poly(float x) {
+        x = x < -87.0f ? -87.0f : x;
+        x = x > 88.0f ? 88.0f : x;
+
+        // k = round(x / ln2), the bias keeps the truncation on positive numbers
+        int k = int(x * 1.44269504088896341f + 127.5f) - 127;
+        float fk = float(k);
+        float r = x - fk * 0.693359375f + fk * 2.12194440e-4f;
+
+        float p = 1.9875691500e-4f;
+        p = p * r + 1.3981999507e-3f;
+        p = p * r + 8.3334519073e-3f;
+        p = p * r + 4.1665795894e-2f;
+        p = p * r + 1.6666665459e-1f;
+        p = p * r + 5.0000001201e-1f;
+        p = p * r * r + r + 1.0f;
+
+        union { int32_t i; float f; } scale;
+        scale.i = (k + 127) << 23;
+        return p * scale.f;
+    }
+
+    static void sigmoid(const float *z, float *a, long size) {
+        for (long i = 0; i < size; i++) {
+            a[i] = 1.0f / (1.0f + exp_poly(-z[i]));
+        }
+    }
+
+    static void sigmoid_dropout(const float *z, float *a, const uint32_t *mask, float scale, long size) {
+        long i = 0;
+        for (; i + 32 <= size; i += 32) {
+            const uint32_t bits = mask[i / 32];
+            float keep[32];
+            for (int b = 0; b < 32; b++) {
+                keep[b] = scale * float((bits >> b) & 1u);
+            }
+            for (int b = 0; b < 32; b++) {
+                a[i + b] = keep[b] / (1.0f + exp_poly(-z[i + b]));
+            }
+        }
+        for (; i < size; i++) {
+            float keep = scale * float((mask[i / 32] >> (i % 32)) & 1u);
+            a[i] = keep / (1.0f + exp_poly(-z[i]));
+        }
+    }
+
+    static void gradient_descent(float *W, const float *dW, long size, float alpha, float lambda) {
+        for (long i = 0; i < size; i++) {
+            W[i] = W[i] - alpha * (dW[i] + lambda * W[i]);
+        }
+    }
+
+    static void momentum(float *W, float *V, const float *dW, long size, float alpha, float lambda, float mu) {
+        for (long i = 0; i < size; i++) {
+            V[i] = mu * V[i] - alpha * (dW[i] + lambda * W[i]);
+            W[i] = W[i] + V[i];
+        }
+    }
+
+    static void adagrad(float *W, float *g, const float *dW, long size, float alpha, float eps) {
+        for (long i = 0; i < size; i++) {
+            g[i] += dW[i] * dW[i];
+            W[i] -= alpha * dW[i] / (__builtin_sqrtf(g[i]) + eps);
+        }
+    }
+
+    static void rmsprop(float *W, float *g, const float *dW, long size, float alpha, float mu, float eps) {
+        for (long i = 0; i < size; i++) {
+            g[i] = mu * g[i] + (1 - mu) * dW[i] * dW[i];
+            W[i] -= alpha * dW[i] / __builtin_sqrtf(g[i] + eps);
+        }
+    }
+
+    static void adam(float *W, float *mt, float *vt, const float *dW, long size,
+                     float b1, float b2, float step, float eps_hat, float decay) {
+        for (long i = 0; i < size; i++) {
+            mt[i] = b1 * mt[i] + (1 - b1) * dW[i];
+            vt[i] = b2 * vt[i] + (1 - b2) * dW[i] * dW[i];
+            W[i] -= step * mt[i] / (__builtin_sqrtf(vt[i]) + eps_hat) + decay * W[i];
+        }
+    }
+
+    static void quantize_u8(const float *x, uint8_t *q, long size, float inv_scale, float offset) {
+        long k = 0;
+#if defined(__AVX2__)
+        // 32 values at a time, the saturating packs clamp to [0, 255], then min to kQuantMax
+        const __m256 vs = _mm256_set1_ps(inv_scale);
+        const __m256 vo = _mm256_set1_ps(offset);
+        const __m256i vmax = _mm256_set1_epi8(kQuantMax);
+        const __m256i lanes = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        for (; k + 32 <= size; k += 32) {
+            __m256i i0 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + k), vs), vo));
+            __m256i i1 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + k + 8), vs), vo));
+            __m256i i2 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + k + 16), vs), vo));
+            __m256i i3 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + k + 24), vs), vo));
+            __m256i v = _mm256_packus_epi16(_mm256_packs_epi32(i0, i1), _mm256_packs_epi32(i2, i3));
+            v = _mm256_min_epu8(_mm256_permutevar8x32_epi32(v, lanes), vmax);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(q + k), v);
+        }
+#elif defined(__SSE2__)
+        const __m128 vs = _mm_set1_ps(inv_scale);
+        const __m128 vo = _mm_set1_ps(offset);
+        const __m128i vmax = _mm_set1_epi8(kQuantMax);
+        for (; k + 16 <= size; k += 16) {
+            __m128i i0 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + k), vs), vo));
+            __m128i i1 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + k + 4), vs), vo));
+            __m128i i2 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + k + 8), vs), vo));
+            __m128i i3 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + k + 12), vs), vo));
+            __m128i v = _mm_packus_epi16(_mm_packs_epi32(i0, i1), _mm_packs_epi32(i2, i3));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(q + k), _mm_min_epu8(v, vmax));
+        }
+#endif
+        for (; k < size; k++) {
+            // round half up by truncation, negative values are clamped to 0 anyway
+            int v = int(x[k] * inv_scale + offset);
+            v = v < 0 ? 0 : v;
+            q[k] = uint8_t(v > kQuantMax ? kQuantMax : v);
+        }
+    }
+
+#if defined(__AVX2__)
+    // acc + dot products of u8 a and s8 w in groups of four bytes
+    static inline __m256i dot_u8s8(__m256i acc, __m256i a, __m256i w) {
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+        return _mm256_dpbusd_epi32(acc, a, w);
+#elif defined(__AVXVNNI__)
+        return _mm256_dpbusd_avx_epi32(acc, a, w);
+#else
+        // u8 x s8 pairs into int16, no saturation as a <= 127, then pairs into int32
+        return _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_maddubs_epi16(a, w), _mm256_set1_epi16(1)));
+#endif
+    }
+
+    static inline int32_t hsum_epi32(__m256i v) {
+        __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        s = _mm_hadd_epi32(s, s);
+        s = _mm_hadd_epi32(s, s);
+        return _mm_cvtsi128_si32(s);
+    }
+#elif defined(__SSE2__)
+    // acc + dot products of u8 a and s8 w in groups of four bytes, widened to int16
+    static inline __m128i dot_u8s8(__m128i acc, __m128i a, __m128i w) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i a_lo = _mm_unpacklo_epi8(a, zero);
+        __m128i a_hi = _mm_unpackhi_epi8(a, zero);
+        __m128i w_lo = _mm_srai_epi16(_mm_unpacklo_epi8(w, w), 8);
+        __m128i w_hi = _mm_srai_epi16(_mm_unpackhi_epi8(w, w), 8);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(a_lo, w_lo));
+        return _mm_add_epi32(acc, _mm_madd_epi16(a_hi, w_hi));
+    }
+
+    static inline int32_t hsum_epi32(__m128i s) {
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(s);
+    }
+#endif
+
+    static void dot4x2_u8s8(const uint8_t *a0, const uint8_t *a1, const int8_t *const *w, int n,
+                            int32_t *out0, int32_t *out1) {
+#if defined(__AVX2__)
+        // eight independent accumulators hide the latency of the multiply-adds
+        __m256i acc00 = _mm256_setzero_si256(), acc01 = _mm256_setzero_si256();
+        __m256i acc02 = _mm256_setzero_si256(), acc03 = _mm256_setzero_si256();
+        __m256i acc10 = _mm256_setzero_si256(), acc11 = _mm256_setzero_si256();
+        __m256i acc12 = _mm256_setzero_si256(), acc13 = _mm256_setzero_si256();
+        for (int k = 0; k < n; k += kAlign) {
+            __m256i va0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a0 + k));
+            __m256i va1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a1 + k));
+            __m256i vw = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w[0] + k));
+            acc00 = dot_u8s8(acc00, va0, vw);
+            acc10 = dot_u8s8(acc10, va1, vw);
+            vw = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w[1] + k));
+            acc01 = dot_u8s8(acc01, va0, vw);
+            acc11 = dot_u8s8(acc11, va1, vw);
+            vw = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w[2] + k));
+            acc02 = dot_u8s8(acc02, va0, vw);
+            acc12 = dot_u8s8(acc12, va1, vw);
+            vw = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w[3] + k));
+            acc03 = dot_u8s8(acc03, va0, vw);
+            acc13 = dot_u8s8(acc13, va1, vw);
+        }
+        out0[0] = hsum_epi32(acc00);
+        out0[1] = hsum_epi32(acc01);
+        out0[2] = hsum_epi32(acc02);
+        out0[3] = hsum_epi32(acc03);
+        out1[0] = hsum_epi32(acc10);
+        out1[1] = hsum_epi32(acc11);
+        out1[2] = hsum_epi32(acc12);
+        out1[3] = hsum_epi32(acc13);
+#elif defined(__SSE2__)
+        for (int r = 0; r < 4; r++) {
+            __m128i acc0 = _mm_setzero_si128();
+            __m128i acc1 = _mm_setzero_si128();
+            for (int k = 0; k < n; k += 16) {
+                __m128i vw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(w[r] + k));
+                acc0 = dot_u8s8(acc0, _mm_loadu_si128(reinterpret_cast<const __m128i *>(a0 + k)), vw);
+                acc1 = dot_u8s8(acc1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(a1 + k)), vw);
+            }
+            out0[r] = hsum_epi32(acc0);
+            out1[r] = hsum_epi32(acc1);
+        }
+#else
+        for (int r = 0; r < 4; r++) {
+            int32_t s0 = 0, s1 = 0;
+            for (int k = 0; k < n; k++) {
+                s0 += int32_t(a0[k]) * w[r][k];
+                s1 += int32_t(a1[k]) * w[r][k];
+            }
+            out0[r] = s0;
+            out1[r] = s1;
+        }
+#endif
+    }
+
+    // Philox blocks generated together, the rounds run over the lanes so the loops vectorize
+    static const int kPhiloxLanes = 16;
+
+    /**
+     * Philox4x32-10 of the counters (block + l, stream), l < kPhiloxLanes, the same as philox4x32_10 of random.h.
+     * x[i][l] is word i of block + l.
+     **/
+    static void philox_blocks(const uint32_t *key, uint64_t stream, uint64_t block, uint32_t x[4][kPhiloxLanes]) {
+        for (int l = 0; l < kPhiloxLanes; l++) {
+            uint64_t b = block + uint64_t(l);
+            x[0][l] = uint32_t(b);
+            x[1][l] = uint32_t(b >> 32);
+            x[2][l] = uint32_t(stream);
+            x[3][l] = uint32_t(stream >> 32);
+        }
+        uint32_t k0 = key[0];
+        uint32_t k1 = key[1];
+        for (int r = 0; r < 10; r++) {
+            for (int l = 0; l < kPhiloxLanes; l++) {
+                uint64_t p0 = uint64_t(0xD2511F53u) * x[0][l];
+                uint64_t p1 = uint64_t(0xCD9E8D57u) * x[2][l];
+                uint32_t c1 = x[1][l];
+                uint32_t c3 = x[3][l];
+                x[0][l] = uint32_t(p1 >> 32) ^ c1 ^ k0;
+                x[1][l] = uint32_t(p1);
+                x[2][l] = uint32_t(p0 >> 32) ^ c3 ^ k1;
+                x[3][l] = uint32_t(p0);
+            }
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+    }
+
+    // [0, 1) from the high 24 bits
+    static inline float u32_to_unit(uint32_t x) {
+        return float(x >> 8) * (1.0f / 16777216.0f);
+    }
+
+    /**
+     * log(x) for normal x > 0, Cephes logf: x = m * 2^e with m in [sqrt(0.5), sqrt(2)), log(m) by a polynomial.
+     * Branch free so the callers vectorize.
+     **/
+    static inline float log_poly(float x) {
+        union { float f; int32_t i; } bits;
+        bits.f = x;
+        int32_t e = ((bits.i >> 23) & 0xff) - 126;
+        int32_t m = (bits.i & 0x007fffff) | 0x3f000000;   // bits of the mantissa in [0.5, 1)
+        // 1 if m < sqrt(0.5), then m is doubled. Integer only, so it vectorizes without -fno-trapping-math too.
+        int32_t small = ((m - 0x3f3504f3) >> 31) & 1;
+        e -= small;
+        bits.i = m + (small << 23);
+        float r = bits.f - 1.0f;
+        float fe = float(e);
+
+        float z = r * r;
+        float p = 7.0376836292e-2f;
+        p = p * r - 1.1514610310e-1f;
+        p = p * r + 1.1676998740e-1f;
+        p = p * r - 1.2420140846e-1f;
+        p = p * r + 1.4249322787e-1f;
+        p = p * r - 1.6668057665e-1f;
+        p = p * r + 2.0000714765e-1f;
+        p = p * r - 2.4999993993e-1f;
+        p = p * r + 3.3333331174e-1f;
+        float y = p * r * z;
+        y += fe * -2.12194440e-4f;
+        y -= 0.5f * z;
+        return r + y + fe * 0.693359375f;
+    }
+
+    /**
+     * sin and cos of 2 pi t for t in [0, 1). t is reduced to a quarter turn q and an angle in [-pi/4, pi/4],
+     * the Cephes sinf and cosf polynomials, then the quadrant swaps and negates them.
+     **/
+    static inline void sincos_turn(float t, float &s, float &c) {
+        int q = int(t * 4.0f + 0.5f);
+        float a = (t - float(q) * 0.25f) * 6.28318530717958648f;
+        float z = a * a;
+        float ps = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * a + a;
+        float pc = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z
+                   - 0.5f * z + 1.0f;
+        q &= 3;
+        float sq = (q & 1) ? pc : ps;
+        float cq = (q & 1) ? ps : pc;
+        s = (q & 2) ? -sq : sq;
+        c = ((q + 1) & 2) ? -cq : cq;
+    }
+
+    // value i of block l is v[i][l], out[4 * l + i], at most n of them
+    static inline void philox_store(const float v[4][kPhiloxLanes], float *out, long n) {
+        if (n >= 4 * kPhiloxLanes) {
+            for (int l = 0; l < kPhiloxLanes; l++) {
+                for (int i = 0; i < 4; i++) {
+                    out[4 * l + i] = v[i][l];
+                }
+            }
+            return;
+        }
+        for (long j = 0; j < n; j++) {
+            out[j] = v[j % 4][j / 4];
+        }
+    }
+
+    static void philox_uniform(const uint32_t *key, uint64_t stream, uint64_t block, float *out, long size,
+                               float min, float max) {
+        uint32_t x[4][kPhiloxLanes];
+        const float scale = max - min;
+        for (long k = 0; k < size; k += 4 * kPhiloxLanes, block += kPhiloxLanes) {
+            philox_blocks(key, stream, block, x);
+            float u[4][kPhiloxLanes];
+            for (int i = 0; i < 4; i++) {
+                for (int l = 0; l < kPhiloxLanes; l++) {
+                    u[i][l] = min + scale * u32_to_unit(x[i][l]);
+                }
+            }
+            philox_store(u, out + k, size - k);
+        }
+    }
+
+    // words 0 and 1 of a block give values 0 and 1, words 2 and 3 give values 2 and 3
+    static void philox_gaussian(const uint32_t *key, uint64_t stream, uint64_t block, float *out, long size,
+                                float mean, float sigma) {
+        uint32_t x[4][kPhiloxLanes];
+        for (long k = 0; k < size; k += 4 * kPhiloxLanes, block += kPhiloxLanes) {
+            philox_blocks(key, stream, block, x);
+            float g[4][kPhiloxLanes];
+            for (int h = 0; h < 2; h++) {
+                for (int l = 0; l < kPhiloxLanes; l++) {
+                    // u1 in (0, 1] so that the log is finite
+                    float u1 = float((x[2 * h][l] >> 8) + 1) * (1.0f / 16777216.0f);
+                    float r = sigma * __builtin_sqrtf(-2.0f * log_poly(u1));
+                    float s, c;
+                    sincos_turn(u32_to_unit(x[2 * h + 1][l]), s, c);
+                    g[2 * h][l] = mean + r * c;
+                    g[2 * h + 1][l] = mean + r * s;
+                }
+            }
+            philox_store(g, out + k, size - k);
+        }
+    }
+
+    // a philox_blocks call gives 64 bits, two words of mask
+    static void philox_mask(const uint32_t *key, uint64_t stream, uint64_t block, uint32_t *mask, long size,
+                            uint32_t threshold) {
+        uint32_t x[4][kPhiloxLanes];
+        const long words = (size + 31) / 32;
+        for (long k = 0; k < words; k += 2, block += kPhiloxLanes) {
+            philox_blocks(key, stream, block, x);
+            // 4 bits of block l, then 8 blocks per word
+            uint32_t nibbles[kPhiloxLanes];
+            for (int l = 0; l < kPhiloxLanes; l++) {
+                nibbles[l] = uint32_t(x[0][l] < threshold) | uint32_t(x[1][l] < threshold) << 1 |
+                             uint32_t(x[2][l] < threshold) << 2 | uint32_t(x[3][l] < threshold) << 3;
+            }
+            uint32_t bits[2] = {0, 0};
+            for (int l = 0; l < kPhiloxLanes; l++) {
+                bits[l / 8] |= nibbles[l] << (4 * (l % 8));
+            }
+            mask[k] = bits[0];
+            if (k + 1 < words) mask[k + 1] = bits[1];
+        }
+        // no bits past size
+        if (size % 32 != 0) {
+            mask[words - 1] &= (1u << (size % 32)) - 1;
+        }
+    }
+
+    extern const kernel_table table = {
+            cpu_level::LU_NET_KERNEL_LEVEL,
+            sigmoid,
+            gradient_descent,
+            momentum,
+            adagrad,
+            rmsprop,
+            adam,
+            quantize_u8,
+            dot4x2_u8s8,
+            philox_uniform,
+            philox_gaussian,
+            philox_mask,
+            sigmoid_dropout
+    };
+}
+}
+}
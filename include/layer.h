@@ -0,0 +1,164 @@
+//
+// Created by 芦yafei  on 17/9/14.
+//
+#ifndef LU_NET_LAYER_H
+#define LU_NET_LAYER_H
+
+#include <memory>
+#include <eigen3/Eigen/Dense>
+#include "net.h"
+#include "random.h"
+#include "weight_init.h"
+#include "dropout_layer.h"
+
+namespace lu_net {
+
+    // A minibatch, one column per sample, contiguous. Views into the buffers of the executor.
+    typedef Eigen::Map<Eigen::MatrixXf> batch_t;
+    typedef Eigen::Map<const Eigen::MatrixXf> const_batch_t;
+
+    /**
+     * Layer of a sequential net, farward and backward over a minibatch.
+     *
+     * Shapes: the executor passes the rows of the input of every layer to out_size() in order, so only
+     * the input of the first layer is given by the user. Outputs have as many columns as inputs.
+     * Parameters: a layer owns none, setup() hands it param_size() floats of the flat parameter and
+     * gradient buffers of the executor, so one optimizer step updates every layer.
+     * Memory: back_prop only gets the input and output asked for by backward_needs_input() and
+     * backward_needs_output(), the executor lets the other activations share buffers.
+     **/
+    class layer {
+    public:
+        virtual ~layer() = default;
+
+        virtual const char *layer_type() const = 0;
+
+        // rows of the output for in_size rows of input, 0 if the layer can not take in_size
+        virtual long out_size(long in_size) const = 0;
+
+        // floats of parameters for in_size rows of input
+        virtual long param_size(long in_size) const { return 0; }
+
+        // called once with the rows of the input and param_size(in_size) floats of value and grad
+        virtual void setup(long in_size, float *value, float *grad) {}
+
+        // initialize the parameters, rng is a stream of this layer only
+        virtual void init_params(random_stream &rng) {}
+
+        virtual bool backward_needs_input() const { return false; }
+
+        virtual bool backward_needs_output() const { return false; }
+
+        // out = f(in), out has the shape of out_size() and is never in
+        virtual void farward_prop(const const_batch_t &in, batch_t &out, net_phase phase) = 0;
+
+        /**
+         * add the gradient of the parameters to grad and compute in_grad from out_grad.
+         * in and out are those of the last train farward_prop if asked for, empty otherwise.
+         * in_grad is nullptr for the first layer, nobody needs the gradient of the input.
+         **/
+        virtual void back_prop(const const_batch_t &in, const const_batch_t &out, const const_batch_t &out_grad,
+                               batch_t *in_grad) = 0;
+    };
+
+
+    namespace layers {
+
+        // out = W * in + b, W is out_size x in_size
+        class fully_connected : public layer {
+        public:
+            explicit fully_connected(long out_size, weight_init::scheme init = weight_init::scheme::lecun)
+                    : out_size_(out_size), init_(init) {}
+
+            const char *layer_type() const override { return "fully_connected"; }
+
+            long out_size(long in_size) const override { return out_size_; }
+
+            long param_size(long in_size) const override { return out_size_ * in_size + out_size_; }
+
+            void setup(long in_size, float *value, float *grad) override;
+
+            // weights by the scheme of the constructor, bias zero
+            void init_params(random_stream &rng) override;
+
+            bool backward_needs_input() const override { return true; }
+
+            void farward_prop(const const_batch_t &in, batch_t &out, net_phase phase) override;
+
+            void back_prop(const const_batch_t &in, const const_batch_t &out, const const_batch_t &out_grad,
+                           batch_t *in_grad) override;
+
+            Eigen::Map<Eigen::MatrixXf> weights() { return Eigen::Map<Eigen::MatrixXf>(W_, out_size_, in_size_); }
+
+            Eigen::Map<Eigen::VectorXf> bias() { return Eigen::Map<Eigen::VectorXf>(b_, out_size_); }
+
+        private:
+            long out_size_;
+            long in_size_ = 0;
+            weight_init::scheme init_;
+            float *W_ = nullptr;    // views into the buffers of the executor, bias after the weights
+            float *b_ = nullptr;
+            float *dW_ = nullptr;
+            float *db_ = nullptr;
+        };
+
+
+        // out = 1 / (1 + exp(-in)), backward from the output
+        class sigmoid : public layer {
+        public:
+            const char *layer_type() const override { return "sigmoid"; }
+
+            long out_size(long in_size) const override { return in_size; }
+
+            bool backward_needs_output() const override { return true; }
+
+            void farward_prop(const const_batch_t &in, batch_t &out, net_phase phase) override;
+
+            void back_prop(const const_batch_t &in, const const_batch_t &out, const const_batch_t &out_grad,
+                           batch_t *in_grad) override;
+        };
+
+
+        // out = max(in, 0), backward from the output
+        class relu : public layer {
+        public:
+            const char *layer_type() const override { return "relu"; }
+
+            long out_size(long in_size) const override { return in_size; }
+
+            bool backward_needs_output() const override { return true; }
+
+            void farward_prop(const const_batch_t &in, batch_t &out, net_phase phase) override;
+
+            void back_prop(const const_batch_t &in, const const_batch_t &out, const const_batch_t &out_grad,
+                           batch_t *in_grad) override;
+        };
+
+
+        // dropout_layer over a minibatch, the mask of the last train farward is kept as bits, no activation is
+        class dropout : public layer {
+        public:
+            explicit dropout(float_t keep_prob) : keep_prob_(keep_prob) {}
+
+            const char *layer_type() const override { return "dropout"; }
+
+            long out_size(long in_size) const override { return in_size; }
+
+            void setup(long in_size, float *value, float *grad) override;
+
+            // the masks are drawn from rng
+            void init_params(random_stream &rng) override;
+
+            void farward_prop(const const_batch_t &in, batch_t &out, net_phase phase) override;
+
+            void back_prop(const const_batch_t &in, const const_batch_t &out, const const_batch_t &out_grad,
+                           batch_t *in_grad) override;
+
+        private:
+            float_t keep_prob_;
+            std::unique_ptr<dropout_layer> dropout_;
+        };
+    }
+}
+
+#endif //LU_NET_LAYER_H
@@ -0,0 +1,209 @@
+//
+// Created by 芦yafei  on 17/8/1.
+//
+#ifndef LU_NET_LR_SCHEDULER_H
+#define LU_NET_LR_SCHEDULER_H
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <algorithm>
+
+namespace lu_net {
+    namespace lr_scheduler {
+
+        /**
+         * base class of learning rate scheduler
+         *
+         * Net::train calls begin() once, lr() before every minibatch and epoch_end() after every epoch,
+         * or with a validation set only after the epochs which ran a validation.
+         * Iterations are counted over the whole training run, starting from 0.
+         **/
+        class lr_scheduler {
+        public:
+            lr_scheduler() = default;
+            virtual ~lr_scheduler() = default;
+
+            /**
+             * @param base_lr          learning rate of the net when training starts
+             * @param iters_per_epoch  number of minibatches in one epoch
+             * @param epochs           number of training epochs
+             **/
+            virtual void begin(float base_lr, long iters_per_epoch, int epochs) {
+                base_lr_ = base_lr;
+                iters_per_epoch_ = iters_per_epoch;
+                total_iters_ = iters_per_epoch * epochs;
+            }
+
+            // learning rate used by the minibatch of iteration iter
+            virtual float lr(long iter) = 0;
+
+            // metric is the fresh validation loss if the net has a validation set, otherwise the mean minibatch loss of the epoch
+            virtual void epoch_end(int epoch, float metric) {}
+
+        protected:
+            float base_lr_ = 0;
+            long iters_per_epoch_ = 0;
+            long total_iters_ = 0;
+        };
+
+
+        /**
+         * multiply the learning rate by gamma every step_size iterations
+         **/
+        class step : public lr_scheduler {
+        public:
+            long step_size;
+            float gamma;
+
+            step(long step_size, float gamma = 0.1) : step_size(step_size), gamma(gamma) {
+                assert(step_size > 0);
+            }
+
+            float lr(long iter) override {
+                return base_lr_ * std::pow(gamma, float(iter / step_size));
+            }
+        };
+
+
+        /**
+         * cosine annealing from the base learning rate down to min_lr at the last iteration
+         *
+         * I Loshchilov and F Hutter,
+         * SGDR: Stochastic Gradient Descent with Warm Restarts, ICLR 2017.
+         **/
+        class cosine : public lr_scheduler {
+        public:
+            float min_lr;
+
+            cosine(float min_lr = 0) : min_lr(min_lr) {}
+
+            float lr(long iter) override {
+                float progress = std::min(1.0f, float(iter) / std::max(1L, total_iters_));
+                return min_lr + (base_lr_ - min_lr) * 0.5f * (1 + std::cos(float(M_PI) * progress));
+            }
+        };
+
+
+        /**
+         * 1cycle policy, the base learning rate is the peak of the cycle.
+         * Anneals from base_lr / div_factor up to base_lr during the first pct_start of the run,
+         * then down to base_lr / (div_factor * final_div_factor), both with cosine shape.
+         *
+         * L N Smith and N Topin,
+         * Super-Convergence: Very Fast Training of Neural Networks Using Large Learning Rates, 2017.
+         **/
+        class one_cycle : public lr_scheduler {
+        public:
+            float pct_start;
+            float div_factor;
+            float final_div_factor;
+
+            one_cycle(float pct_start = 0.3, float div_factor = 25, float final_div_factor = 1e4)
+                    : pct_start(pct_start),
+                      div_factor(div_factor),
+                      final_div_factor(final_div_factor) {}
+
+            float lr(long iter) override {
+                const float initial_lr = base_lr_ / div_factor;
+                const float final_lr = initial_lr / final_div_factor;
+                const float up_iters = std::max(1.0f, pct_start * total_iters_);
+                const float down_iters = std::max(1.0f, total_iters_ - up_iters);
+
+                if (iter < up_iters) {
+                    return anneal(initial_lr, base_lr_, iter / up_iters);
+                }
+                return anneal(base_lr_, final_lr, std::min(1.0f, (iter - up_iters) / down_iters));
+            }
+
+        private:
+            static float anneal(float start, float end, float progress) {
+                return end + (start - end) * 0.5f * (1 + std::cos(float(M_PI) * progress));
+            }
+        };
+
+
+        /**
+         * linear warmup from start_factor * base_lr to base_lr during the first warmup_iters iterations,
+         * then hands over to the wrapped scheduler (or keeps base_lr if there is none).
+         **/
+        class warmup : public lr_scheduler {
+        public:
+            long warmup_iters;
+            float start_factor;
+
+            warmup(long warmup_iters, std::shared_ptr<lr_scheduler> after = nullptr, float start_factor = 0)
+                    : warmup_iters(warmup_iters),
+                      start_factor(start_factor),
+                      after_(after) {}
+
+            void begin(float base_lr, long iters_per_epoch, int epochs) override {
+                lr_scheduler::begin(base_lr, iters_per_epoch, epochs);
+                if (after_) after_->begin(base_lr, iters_per_epoch, epochs);
+            }
+
+            float lr(long iter) override {
+                if (iter < warmup_iters) {
+                    float factor = start_factor + (1 - start_factor) * float(iter) / warmup_iters;
+                    return base_lr_ * factor;
+                }
+                return after_ ? after_->lr(iter) : base_lr_;
+            }
+
+            void epoch_end(int epoch, float metric) override {
+                if (after_) after_->epoch_end(epoch, metric);
+            }
+
+        private:
+            std::shared_ptr<lr_scheduler> after_;
+        };
+
+
+        /**
+         * multiply the learning rate by factor when the epoch metric has not improved
+         * by more than threshold (relative) for patience epochs, counted in validations when the net has a validation set.
+         **/
+        class reduce_on_plateau : public lr_scheduler {
+        public:
+            float factor;
+            int patience;
+            float threshold;
+            float min_lr;
+
+            reduce_on_plateau(float factor = 0.1, int patience = 10, float threshold = 1e-4, float min_lr = 0)
+                    : factor(factor),
+                      patience(patience),
+                      threshold(threshold),
+                      min_lr(min_lr) {}
+
+            void begin(float base_lr, long iters_per_epoch, int epochs) override {
+                lr_scheduler::begin(base_lr, iters_per_epoch, epochs);
+                lr_ = base_lr;
+                best_ = std::numeric_limits<float>::infinity();
+                bad_epochs_ = 0;
+            }
+
+            float lr(long iter) override {
+                return lr_;
+            }
+
+            void epoch_end(int epoch, float metric) override {
+                if (metric < best_ * (1 - threshold)) {
+                    best_ = metric;
+                    bad_epochs_ = 0;
+                } else if (++bad_epochs_ > patience) {
+                    lr_ = std::max(min_lr, lr_ * factor);
+                    bad_epochs_ = 0;
+                }
+            }
+
+        private:
+            float lr_ = 0;
+            float best_ = std::numeric_limits<float>::infinity();
+            int bad_epochs_ = 0;
+        };
+    }
+}
+
+#endif //LU_NET_LR_SCHEDULER_H
@@ -8,6 +8,7 @@
 #include "activation_function.h"
 #include "loss_function.h"
 #include "optimizer.h"
+#include "recurrent.h"
 #include <vector>
 
 namespace lu_net{
@@ -21,86 +22,200 @@ namespace lu_net{
 
         int mem_cell_num_ = 0;      // LSTM cell num
         int x_dim_ = 0;             // Dimensions of input x
+        int concat_len_ = 0;        // Input dimensions of LSTM cell(LSTM cell num + dimensions of input x)
 
-        // Weight matrices
-        Eigen::MatrixXf wg;         // Input node
-        Eigen::MatrixXf wi;         // Input gate
-        Eigen::MatrixXf wf;         // Forget gate
-        Eigen::MatrixXf wo;         // Output gate
-
-        // Bias terms
-        Eigen::VectorXf bg;         // Input node
-        Eigen::VectorXf bi;         // Input gate
-        Eigen::VectorXf bf;         // Forget gate
-        Eigen::VectorXf bo;         // Output gate
+        // Weight matrices of the four gates stacked by rows: input node g, input gate i, forget gate f,
+        // output gate o. Columns follow the concatenated input [x(t), h(t - 1)], so w is 4H x concat_len_.
+        Eigen::MatrixXf w;
 
-        int concat_len_ = 0;        // Input dimensions of LSTM cell(LSTM cell num + dimensions of input x)
+        // Bias terms, stacked as w
+        Eigen::VectorXf b;
 
         // Diffs (derivative of loss function for all parameters)
-        Eigen::MatrixXf wg_diff;
-        Eigen::MatrixXf wi_diff;
-        Eigen::MatrixXf wf_diff;
-        Eigen::MatrixXf wo_diff;
-
-        Eigen::VectorXf bg_diff;
-        Eigen::VectorXf bi_diff;
-        Eigen::VectorXf bf_diff;
-        Eigen::VectorXf bo_diff;
+        Eigen::MatrixXf w_diff;
+        Eigen::VectorXf b_diff;
+
+        // Columns of w applied to x(t) and to h(t - 1)
+        Eigen::MatrixXf::ColsBlockXpr w_x() { return w.leftCols(x_dim_); }
+        Eigen::MatrixXf::ColsBlockXpr w_h() { return w.rightCols(mem_cell_num_); }
     };
 
 
-    class LstmState {
+    /**
+     * States of a minibatch of LSTM sequences, gates hold the activations of [g; i; f; o].
+     **/
+    class LstmSequenceState : public SequenceState {
     public:
-        LstmState(int mem_cell_num, int x_dim);
+        LstmSequenceState(int mem_cell_num, int x_dim, int batch_size = 1);
+    };
 
-        ~LstmState();
 
-        // State of all LSTM cell.
-        Eigen::VectorXf g;
-        Eigen::VectorXf i;
-        Eigen::VectorXf f;
-        Eigen::VectorXf o;
-        Eigen::VectorXf s;              // internal state
-        Eigen::VectorXf h;              // the values output by each memory cell in the hidden layer
-        Eigen::VectorXf bottom_diff_h;
-        Eigen::VectorXf bottom_diff_s;
+    /**
+     * LSTM over a minibatch of sequences, states are kept in a LstmSequenceState.
+     * Sequences of different lengths are packed, each step only computes the sequences still running.
+     *
+     * The input projection w_x * x of all steps is done by one GEMM before the time loop, each step
+     * then adds w_h * h(t - 1) of the whole minibatch with one GEMM.
+     **/
+    class LstmLayer {
+    public:
+        LstmLayer(LstmParam &lstmParam);
 
-    };
+        ~LstmLayer();
 
+        /**
+         * Forward propagation from zero initial states.
+         * @x: x_dim x (steps * batch_size) inputs
+         * **/
+        void farward_prop(const Eigen::MatrixXf &x, int batch_size);
 
-    class LstmNode {
-    public:
-        LstmNode(LstmParam &lstmParam, LstmState &lstmState);
+        /**
+         * Forward propagation of packed sequences of different lengths from zero initial states,
+         * see SequenceState for the layout.
+         * @x: x_dim x sum(batch_sizes) inputs
+         * @batch_sizes: sequences still running at each step, non-increasing
+         * **/
+        void farward_prop(const Eigen::MatrixXf &x, const std::vector<int> &batch_sizes);
+
+        /**
+         * Forward propagation of more steps of the stored sequences, continues from their last states.
+         * @x: x_dim x (steps * batch_size) inputs
+         * **/
+        void farward_append(const Eigen::MatrixXf &x);
 
-        ~LstmNode();
+        /**
+         * Forward propagation of one more step of the stored sequences.
+         * @x: x_dim x batch_size inputs
+         * **/
+        void farward_step(const Eigen::MatrixXf &x);
 
         /**
-        * Forward propagation
-        * **/
-        void farward_prop(Eigen::VectorXf x);
+         * Back propagation through time, accumulates into w_diff and b_diff of the LstmParam.
+         * @top_diff_h: mem_cell_num x columns derivative of loss with respect to h, same layout as h()
+         * **/
+        void back_prop(const Eigen::MatrixXf &top_diff_h);
+
+        // Drop the stored steps and start from zero states
+        void reset() { state_.reset(); }
+
+        void reset(int batch_size) { state_.reset(batch_size); }
+
+        LstmSequenceState &state() { return state_; }
+
+        // Outputs of all steps, same layout as the inputs
+        Eigen::MatrixXf::ConstColsBlockXpr h() const { return state_.h(); }
+
+        Eigen::MatrixXf::ConstColsBlockXpr s() const { return state_.s(); }
+
+        int steps() const { return state_.steps(); }
+
+        int batch_size() const { return state_.batch_size(); }
+
+    private:
+        // add the recurrent input of step t and apply the gates, gates(t) holds w_x * x(t) + b
+        void cell_farward(int t);
+
+        // input projection of the steps from first to the last stored one, then the cells one by one
+        void farward_from(int first, const Eigen::MatrixXf &x);
+
+        LstmParam &param_;
+        LstmSequenceState state_;
+        Eigen::MatrixXf dgates_;    // derivative of loss with respect to the weighted inputs of all steps
+        Eigen::MatrixXf xc_;        // [x(t), h(t - 1)] of all steps
+    };
+
+
+    /**
+     * Truncated back propagation through time, BPTT(k1, k2) of
+     * R J Williams and J Peng, An efficient gradient-based algorithm for on-line training of
+     * recurrent network trajectories, Neural Computation 2(4):490-501, 1990.
+     *
+     * Every k1 steps the loss of those steps is back propagated through the last k2 steps and the
+     * LstmParam is updated. States are carried across windows, so at most k2 steps are stored
+     * whatever the stream length. The loss is MSE between the first y_dim elements of h and the targets.
+     **/
+    class LstmTbpttTrainer {
+    public:
+        LstmTbpttTrainer(LstmParam &lstmParam, int k1, int k2, float lr);
+
+        ~LstmTbpttTrainer();
 
         /**
-         * Forward propagation
-         * @s_prev: s in t - 1
-         * @h_prev: h in t - 1
+         * Train on the next part of batch_size streams, may be called again with the following part.
+         * @x: x_dim x (steps * batch_size) inputs, column t * batch_size + n belongs to stream n
+         * @y: y_dim x (steps * batch_size) targets
+         * @return mean loss per step of the windows finished by this call
          * **/
-        void farward_prop(Eigen::VectorXf x, Eigen::VectorXf s_prev, Eigen::VectorXf h_prev);
+        float train(const Eigen::MatrixXf &x, const Eigen::MatrixXf &y, int batch_size);
+
+        // Start new streams, the stored steps and the pending targets are dropped
+        void reset();
+
+        float lr_;
+
+    private:
+        LstmParam &param_;
+        LstmLayer lstm_layer_;
+        int k1_;
+        int k2_;
+        int pending_ = 0;           // steps since the last update
+        bool running_ = false;      // streams started since the last reset
+        Eigen::MatrixXf y_pending_; // targets of the pending steps
+    };
+
+
+    /**
+     * State of one stream for LstmInference, only the current s and h.
+     * Copy it to snapshot the stream and assign the copy back to restore it.
+     **/
+    class LstmSession {
+    public:
+        explicit LstmSession(int mem_cell_num = 0);
 
+        Eigen::VectorXf s;
+        Eigen::VectorXf h;
+    };
+
+
+    /**
+     * Stateful streaming inference, pushes one step of input at a time and keeps no history.
+     * Independent sessions stepped together share one GEMM w * [x(t), h(t - 1)] for all of them.
+     **/
+    class LstmInference {
+    public:
+        LstmInference(const LstmParam &lstmParam);
 
-        void top_diff_is(Eigen::VectorXf top_diff_h, Eigen::VectorXf top_diff_s);
+        ~LstmInference();
+
+        // Session with zero states
+        LstmSession new_session() const;
+
+        /**
+         * Advance one session by one step, the output is session.h
+         * **/
+        void step(LstmSession &session, const Eigen::VectorXf &x);
 
-        LstmState state_;
+        /**
+         * Advance several sessions by one step each.
+         * @x: x_dim x sessions.size() inputs, column n goes to sessions[n]
+         * **/
+        void step(const std::vector<LstmSession*> &sessions, const Eigen::MatrixXf &x);
 
     private:
-        LstmParam param_;
-        Eigen::VectorXf xc_;
-        Eigen::VectorXf s_prev_;
-        Eigen::VectorXf h_prev_;
+        const LstmParam &param_;
+
+        // workspace of the sessions stepped together
+        Eigen::MatrixXf xc_;
+        Eigen::MatrixXf gates_;
+        Eigen::MatrixXf s_prev_;
+        Eigen::MatrixXf s_;
+        Eigen::MatrixXf h_;
     };
 
 
     class LstmNetwork {
-        LstmNetwork(LstmParam lstmParam);
+    public:
+        LstmNetwork(LstmParam &lstmParam);
 
         ~LstmNetwork();
 
@@ -116,10 +231,14 @@ namespace lu_net{
          * **/
         void build_x_list(const Eigen::VectorXf& x);
 
+        /**
+         * Start a new input sequence, the state memory is kept for reuse.
+         * **/
+        void x_list_clear();
+
     private:
-        LstmParam lstmParam_;
-        std::vector<LstmNode*> lstm_node_list;
-        std::vector<Eigen::VectorXf> x_list;    // input sequence
+        LstmParam &lstmParam_;
+        LstmLayer lstm_layer_;      // states of the input sequence
     };
 }
 #endif //LU_NET_LSTM_H
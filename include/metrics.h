@@ -0,0 +1,124 @@
+//
+// Created by 芦yafei  on 17/9/4.
+//
+#ifndef LU_NET_METRICS_H
+#define LU_NET_METRICS_H
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "alloc_tracker.h"
+
+namespace lu_net {
+    namespace metrics {
+
+        // Parts of a training step timed by Net::train
+        enum class phase {
+            data,       // copying the minibatch into the net
+            farward,
+            backward,
+            update      // optimizer step
+        };
+
+        const int kPhases = 4;
+
+        typedef std::chrono::steady_clock clock;
+
+        /**
+         * Throughput of the minibatches between two reports.
+         * FLOPs are derived from layers_neuron_num, a multiply-add of the matrix products counts as two
+         * and the elementwise work (bias, activation, loss) is not counted.
+         **/
+        struct report {
+            int epoch = 0;
+            long iteration = 0;         // iteration of the last minibatch, counted over the whole training
+            long batches = 0;
+            long samples = 0;
+            double seconds = 0;         // wall time, including validation and logging
+            double samples_per_sec = 0;
+            double batches_per_sec = 0;
+            float loss = 0;             // mean minibatch loss
+            double phase_seconds[kPhases] = {0, 0, 0, 0};   // the rest of seconds is other
+            std::vector<double> farward_gflops;     // per layer, index 0 (the input layer) unused
+            std::vector<double> backward_gflops;
+            double peak_rss_mb = 0;
+
+            // heap usage, only with alloc_tracker::enabled()
+            double allocations_per_batch = 0;
+            double heap_mb = 0;                     // in use at the report
+            double heap_peak_mb = 0;                // high-water mark since the start of the training
+            double subsystem_mb[alloc_tracker::kSubsystems] = {0, 0, 0, 0, 0, 0};
+        };
+
+
+        /**
+         * Training metrics of Net::train, reported every interval minibatches and at the end of the training.
+         * Each report is logged and, if json_file is set, appended to it as one JSON object per line.
+         *
+         * Net times the phases only when metrics are set, each timed part costs two clock reads.
+         **/
+        class training_metrics {
+        public:
+            long interval;          // minibatches between two reports
+            std::string json_file;  // JSON lines output, none if empty
+
+            explicit training_metrics(long interval = 100, const std::string &json_file = "");
+
+            virtual ~training_metrics() = default;
+
+            // start of Net::train
+            void begin(const std::vector<int> &layers_neuron_num);
+
+            /**
+             * add the time since since to phase p, and to layer (1 ~ num_layers - 1) if given.
+             * @return now, the start of the next timed part
+             **/
+            clock::time_point lap(phase p, clock::time_point since, int layer = 0) {
+                clock::time_point now = clock::now();
+                double seconds = std::chrono::duration<double>(now - since).count();
+                phase_seconds_[int(p)] += seconds;
+                if (layer > 0) {
+                    (p == phase::farward ? farward_seconds_ : backward_seconds_)[layer] += seconds;
+                }
+                return now;
+            }
+
+            // after every minibatch, reports when interval minibatches are done
+            void batch_end(int epoch, long iteration, int samples, float loss);
+
+            // end of Net::train, reports the minibatches since the last report
+            void end();
+
+            // last report, all zeros before the first one
+            const report &last_report() const { return last_; }
+
+            // peak resident set size of the process, 0 where unknown
+            static double peak_rss_mb();
+
+        protected:
+            // log the report and append it to json_file
+            virtual void emit(const report &r);
+
+        private:
+            void make_report();
+
+            std::vector<double> farward_flops_;     // per sample and layer
+            std::vector<double> backward_flops_;
+            std::vector<double> farward_seconds_;   // since the last report, per layer
+            std::vector<double> backward_seconds_;
+            double phase_seconds_[kPhases] = {0, 0, 0, 0};
+            clock::time_point start_;
+            int epoch_ = 0;
+            long iteration_ = 0;
+            long batches_ = 0;
+            long samples_ = 0;
+            long allocations_ = 0;  // allocations of the process at the start of the interval
+            double sum_loss_ = 0;
+            report last_;
+            std::ofstream json_;
+        };
+    }
+}
+
+#endif //LU_NET_METRICS_H
@@ -4,6 +4,8 @@
 #include <vector>
 #include "net.h"
 #include <glog/logging.h>
+#include "profiler.h"
+#include "alloc_tracker.h"
 
 using namespace std;
 using namespace lu_net;
@@ -18,6 +20,8 @@ int ReverseInt(int i) {
 }
 
 void read_Mnist_Label(string filename, vector<label_t> &labels) {
+    LU_NET_PROFILE_SCOPE("read_mnist_labels");
+    LU_NET_ALLOC_TAG(dataset);
     ifstream file(filename, ios::binary);
     if (file.is_open()) {
         int magic_number = 0;
@@ -39,6 +43,8 @@ void read_Mnist_Label(string filename, vector<label_t> &labels) {
 }
 
 void read_Mnist_Images(string filename, vector<vec_t> &images) {
+    LU_NET_PROFILE_SCOPE("read_mnist_images");
+    LU_NET_ALLOC_TAG(dataset);
     ifstream file(filename, ios::binary);
     if (file.is_open()) {
         int magic_number = 0;
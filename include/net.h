@@ -9,6 +9,7 @@
 #include <string.h>
 #include <eigen3/Eigen/Dense>
 #include <map>
+#include <memory>
 
 namespace lu_net {
     typedef std::uint32_t label_t;
@@ -32,6 +33,24 @@ namespace lu_net {
         test
     };
 
+    namespace lr_scheduler {
+        class lr_scheduler;
+    }
+
+    namespace pruning {
+        class pruning_schedule;
+    }
+
+    namespace metrics {
+        class training_metrics;
+    }
+
+    namespace weight_init {
+        enum class scheme;
+    }
+
+    class dropout_layer;
+
     struct result {
         result() : num_success(0), num_total(0) {}
 
@@ -44,12 +63,34 @@ namespace lu_net {
         }
     };
 
+    // add the argmax predictions of the columns of out, for samples with labels class_labels[0, out.cols())
+    inline void count_predictions(const Eigen::MatrixXf &out, const label_t *class_labels, result &test_result) {
+        for (long j = 0; j < out.cols(); j++) {
+            int max_index = 0;
+            out.col(j).maxCoeff(&max_index);
+
+            label_t predicted = label_t(max_index);
+            label_t actual = class_labels[j];
+
+            if (predicted == actual) {
+                test_result.num_success += 1;
+            }
+
+            test_result.num_total += 1;
+            test_result.confusion_matrix[predicted][actual]++;
+        }
+    }
+
     class Net {
     public:
         Net() {};
 
         virtual ~Net() {};
 
+        // weights and bias are views into one flat buffer, copying would alias it.
+        Net(const Net &) = delete;
+        Net &operator=(const Net &) = delete;
+
         std::vector<int> layers_neuron_num;
         int num_layers = 0;
         float learning_rate = 0.0;
@@ -57,14 +98,24 @@ namespace lu_net {
         float batch_loss = 0.0;         // Loss of a batch of data.
         int output_interval = 0;        // Interval of loss print out, measured in epoch
         float fine_tune_factor = 0.0;   // finetune factor of learning rate.
+        int validation_interval = 1;    // Interval of validation, measured in epoch
+        int patience = 0;               // Stop after patience validations without improvement, 0 never stops early.
+        bool restore_best = true;       // Restore the weights of the best validation when training ends.
+        bool mixed_precision = false;   // Train minibatches at once with activations stored in bf16, weights and gradients stay fp32.
 
         // initialize net:generate weights matrices、layer matrices and bias matrices
         // bias default all zero
         void initNet(const std::vector<int> layers_neuron_num, float learning_rate, float lmbda);
 
-        // initialize the weights matrices
+        // initialize the weights matrices, N(0, 1 / fan_in) as weight_init::scheme::lecun
         void initWeights(const double w = 0);
 
+        // initialize the weights of every layer with scheme
+        void initWeights(weight_init::scheme scheme);
+
+        // initialize the weights of layer i with schemes[i - 1], one scheme for each of the layers 1 ~ num_layers - 1
+        void initWeights(const std::vector<weight_init::scheme> &schemes);
+
         //Initial the bias matrices
         void initBias(const double w = 0);
 
@@ -88,28 +139,124 @@ namespace lu_net {
 
         result test(const std::vector<vec_t> &inputs, const std::vector<label_t> &class_labels);
 
+        /**
+         * test on n samples stored one after the other, i.e. a row-major n x input size array.
+         * The samples are read in place, nothing is copied.
+         **/
+        result test(const float_t *inputs, const label_t *class_labels, long n);
+
+        /**
+         * Activations of the last layer for n samples stored as in test(), written to outputs as a
+         * row-major n x output size array.
+         **/
+        void predict(const float_t *inputs, long n, float_t *outputs);
+
+        /**
+         * set the validation set evaluated by train() every validation_interval epochs.
+         * The data is not copied and must stay alive during train(), pass empty vectors to disable validation.
+         **/
+        void set_validation_data(const std::vector<vec_t> &inputs, const std::vector<label_t> &class_labels);
+
         bool save(const std::string &filename,
                   content_type what = content_type::weights_and_model,
                   file_format format = file_format::binary);
 
+        /**
+         * Load a file written by save() with the same what and format.
+         * model and weights_and_model rebuild the net from the saved architecture, a model alone leaves
+         * zero weights and bias. weights needs a net of the same architecture.
+         * @return false if the file can not be read or does not fit the net
+         **/
+        bool load(const std::string &filename,
+                  content_type what = content_type::weights_and_model,
+                  file_format format = file_format::binary);
+
+        // All weights and bias of the net, in one flat buffer (weights of every layer first, then bias).
+        const Eigen::VectorXf &get_params() const { return params_; }
+
+        // Restore a buffer returned by get_params(), the net architecture must be the same.
+        void set_params(const Eigen::VectorXf &params);
+
+        // Weights and bias of layer i (1 ~ num_layers - 1), views into get_params().
+        const Eigen::Map<Eigen::MatrixXf> &get_weights(int i) const { return weights[i]; }
+
+        const Eigen::Map<Eigen::VectorXf> &get_bias(int i) const { return bias[i]; }
+
+        /**
+         * Set the learning rate scheduler evaluated before every minibatch by train(). Every train() starts
+         * it from learning_rate, which it leaves unchanged. Without a scheduler learning_rate is multiplied by fine_tune_factor every output_interval epochs.
+         **/
+        void set_lr_scheduler(std::shared_ptr<lr_scheduler::lr_scheduler> scheduler) { lr_scheduler_ = scheduler; }
+
+        /**
+         * Set the pruning schedule applied by train(). Pruning is permanent, pruned weights are kept at zero
+         * by every later train() until clear_pruning() or initNet().
+         **/
+        void set_pruning(std::shared_ptr<pruning::pruning_schedule> schedule) { pruning_ = schedule; }
+
+        /**
+         * Set the metrics reported by train(): throughput, time per phase, GFLOP/s per layer and peak RSS.
+         * Without metrics train() does not time anything.
+         **/
+        void set_metrics(std::shared_ptr<metrics::training_metrics> metrics) { metrics_ = metrics; }
+
+        /**
+         * Dropout of the activations of hidden layer i (1 ~ num_layers - 2) in train(), every unit is kept with
+         * probability keep_prob and scaled by 1 / keep_prob, keep_prob 1 removes it. Call it after initNet().
+         * test, predict and the validation of train() never drop.
+         **/
+        void set_dropout(int layer, float keep_prob);
+
+        /**
+         * Magnitude pruning, zero the smallest weights of every layer until sparsity of them are zero.
+         * The pruned weights stay zero in later training.
+         **/
+        void prune(float sparsity);
+
+        // let the pruned weights train again, they stay zero until then
+        void clear_pruning();
+
     private:
         std::vector<Eigen::VectorXf> as;    // Store all the a vectors (activation of the neuron), layer by layer.
-        std::vector<Eigen::MatrixXf> weights;
-        std::vector<Eigen::VectorXf> bias;
-        std::vector<Eigen::VectorXf> gradient;
+        std::vector<Eigen::Map<Eigen::MatrixXf> > weights;  // Views into params_.
+        std::vector<Eigen::Map<Eigen::VectorXf> > bias;     // Views into params_.
+        std::vector<Eigen::Map<Eigen::MatrixXf> > nabla_w;  // Views into grads_.
+        std::vector<Eigen::Map<Eigen::VectorXf> > nabla_b;  // Views into grads_.
         std::vector<Eigen::VectorXf> zs;    // Store all the z vectors(weighted input), layer by layer.
+        std::vector<Eigen::Matrix<Eigen::bfloat16, Eigen::Dynamic, Eigen::Dynamic> > as_bf16;  // Activations of a minibatch in mixed precision, one column per sample.
+
+        Eigen::VectorXf params_;            // Every parameter of the net, each layer block padded to kParamAlign floats.
+        Eigen::VectorXf grads_;             // Gradient of every parameter, same layout as params_.
+        long weights_size_ = 0;             // Length of the weights part of params_, bias start after it.
+
+        std::shared_ptr<lr_scheduler::lr_scheduler> lr_scheduler_;
+        std::shared_ptr<pruning::pruning_schedule> pruning_;
+        Eigen::VectorXf prune_mask_;        // 1 for kept weights, 0 for pruned, same layout as the weights part of params_.
+        std::shared_ptr<metrics::training_metrics> metrics_;
+        std::vector<std::shared_ptr<dropout_layer> > dropouts_;    // Dropout of the activations of each layer, null for none.
+
+        const std::vector<vec_t> *val_inputs_ = nullptr;
+        const std::vector<label_t> *val_labels_ = nullptr;
+
+        // Allocate params_ and grads_ and bind the weights/bias views, all parameters are zero.
+        void alloc_params();
+
+        // Phase of the dropout layers, train() switches them to train and back to test.
+        void set_phase(net_phase phase);
 
         /**
         * train on one minibatch.
          *
         * @param size is the number of data points to use in this batch
+        * @param lr learning rate of this minibatch
         */
         template <typename E, typename Optimizer>
         void train_once(Optimizer &optimizer,
                         const tensor_t *in,
                         const tensor_t *t,
                         int size,
-                        int n);
+                        int n,
+                        float lr);
 
         /**
         * trains on one minibatch, i.e. runs forward and backward propagation to calculate
@@ -123,23 +270,49 @@ namespace lu_net {
                             const tensor_t *in,
                             const tensor_t *t,
                             int batch_size,
-                            int n);
+                            int n,
+                            float lr);
 
         template <typename E, typename Optimizer>
         void update_batch(Optimizer &optimizer,
                           const std::vector<tensor_t> &in,
                           const std::vector<tensor_t> &t,
                           int batch_size,
-                          int n);
+                          int n,
+                          float lr);
+
+        /**
+         * farward and backward a whole minibatch in mixed precision, accumulate into nabla_w and nabla_b.
+         * @return sum of the loss of the samples
+         */
+        template <typename E>
+        float farward_backward_mixed(const std::vector<tensor_t> &in, const std::vector<tensor_t> &t, int batch_size);
 
         //Backward
         void farward(Eigen::VectorXf x);
 
         //Forward
+        //accumulate the gradient of one sample into nabla_w and nabla_b
         template <typename E>
-        void backward(const Eigen::VectorXf &y, std::vector<Eigen::MatrixXf> &nabla_w, std::vector<Eigen::VectorXf> &nabla_b);
+        void backward(const Eigen::VectorXf &y);
 
         label_t fprop_max_index(const Eigen::VectorXf &in);
+
+        /**
+         * farward a batch of samples inputs[begin, begin + size) at once, one GEMM per layer.
+         * @param out  activations of the last layer, one column per sample
+         */
+        void farward_batch(const std::vector<vec_t> &inputs, size_t begin, size_t size, Eigen::MatrixXf &out);
+
+        // farward the samples of the columns of x
+        void farward_batch(const Eigen::Ref<const Eigen::MatrixXf> &x, Eigen::MatrixXf &out);
+
+        /**
+         * evaluate loss and accuracy on the validation set with farward_batch.
+         * @return mean loss per sample
+         */
+        template <typename E>
+        float validate(result &val_result);
     };
 }
 #endif //LU_NET_NET_H
@@ -6,6 +6,9 @@
 
 #include <eigen3/Eigen/Dense>
 #include <unordered_map>
+#include <cmath>
+#include "cpu_dispatch.h"
+#include "alloc_tracker.h"
 
 using namespace std;
 using namespace Eigen;
@@ -23,9 +26,53 @@ namespace lu_net {
             optimizer() = default;
             virtual ~optimizer() = default;
 
-            // pure virtual function, must be defined in children class
-            virtual void update_w(MatrixXf &W, const MatrixXf &dW, const float alpha) = 0;
-            virtual void update_b(VectorXf &W, const VectorXf &dW, const float alpha) = 0;
+            /**
+             * update size parameters in place, one pass over W and dW (and the optimizer state).
+             * W is also the key of the optimizer state, so it must stay at the same address between calls.
+             * The passes run the kernels of the cpu_level in use, see cpu_dispatch.h.
+             **/
+            virtual void update(float *W, const float *dW, long size, const float alpha) = 0;
+
+            // clear the optimizer state (moments, step counts).
+            virtual void reset() {}
+
+            void update_w(MatrixXf &W, const MatrixXf &dW, const float alpha) {
+                assert(W.size() == dW.size());
+                update(W.data(), dW.data(), W.size(), alpha);
+            }
+
+            void update_b(VectorXf &W, const VectorXf &dW, const float alpha) {
+                assert(W.size() == dW.size());
+                update(W.data(), dW.data(), W.size(), alpha);
+            }
+        };
+
+
+        /**
+         * base class of optimizer which keeps N state buffers per parameter block,
+         * e.g. velocity of momentum, or the first and second moment of adam.
+         * Each buffer is one contiguous vector of the same length as the parameter block.
+         **/
+        template <int N>
+        class stateful_optimizer : public optimizer {
+        public:
+            void reset() override {
+                for (auto &e : E_) e.clear();
+            }
+
+        protected:
+            template <int Index>
+            float *get(const float *key, long size) {
+                static_assert(Index < N, "index out of range");
+                LU_NET_ALLOC_TAG(optimizer_state);
+                VectorXf &buf = E_[Index][key];
+                if (buf.size() != size) {
+                    buf = VectorXf::Zero(size);
+                }
+                return buf.data();
+            }
+
+            std::unordered_map<const float *, VectorXf> E_[N];
         };
 
 
@@ -39,14 +86,10 @@ namespace lu_net {
             float alpha; // learning rate
             float lambda; // weight decay
 
-            gradient_descent() {}
-
-            void update_w(MatrixXf &W, const MatrixXf &dW, const float alpha) override {
-                W = W - alpha * dW;
-            }
+            gradient_descent() : lambda(0) {}
 
-            void update_b(VectorXf &W, const VectorXf &dW, const float alpha) override {
-                W = W - alpha * dW;
+            void update(float *W, const float *dW, long size, const float alpha) override {
+                kernels().gradient_descent(W, dW, size, alpha, lambda);
             }
         };
 
@@ -57,31 +100,117 @@ namespace lu_net {
          * Some methods of speeding up the convergence of iteration methods
          * USSR Computational Mathematics and Mathematical Physics, 4(5):1-17, 1964.
          **/
-        class momentum : public optimizer {
+        class momentum : public stateful_optimizer<1> {
         public:
             float alpha; // learning rate
             float lambda; // weight decay
             float mu; // momentum
 
-            momentum() : mu(0.9) {}
+            momentum() : lambda(0), mu(0.9) {}
 
-            void update_w(MatrixXf &W, const MatrixXf &dW, const float alpha) override {
-                MatrixXf V = - alpha * dW + mu * dWprev_w[0];
-                W = W + V;
-                dWprev_w[0] = V;
+            void update(float *W, const float *dW, long size, const float alpha) override {
+                float *V = get<0>(W, size);
+                kernels().momentum(W, V, dW, size, alpha, lambda, mu);
             }
+        };
+
+        /**
+         * adaptive gradient method
+         *
+         * J Duchi, E Hazan and Y Singer,
+         * Adaptive subgradient methods for online learning and stochastic optimization
+         * The Journal of Machine Learning Research, pages 2121-2159, 2011.
+         **/
+        class adagrad : public stateful_optimizer<1> {
+        public:
+            float eps; // constant value to avoid zero-division
 
-            void update_b(VectorXf &W, const VectorXf &dW, const float alpha) override {
-                MatrixXf V = - alpha * dW + mu * dWprev_b[0];
-                W = W + V;
-                dWprev_b[0] = V;
+            adagrad() : eps(1e-8) {}
+
+            void update(float *W, const float *dW, long size, const float alpha) override {
+                float *g = get<0>(W, size);
+                kernels().adagrad(W, g, dW, size, alpha, eps);
+            }
+        };
+
+        /**
+         * RMSprop
+         *
+         * T Tieleman, and G E Hinton,
+         * Lecture 6.5 - rmsprop, COURSERA: Neural Networks for Machine Learning (2012)
+         **/
+        class RMSprop : public stateful_optimizer<1> {
+        public:
+            float mu; // decay term
+            float eps; // constant value to avoid zero-division
+
+            RMSprop() : mu(0.99), eps(1e-8) {}
+
+            void update(float *W, const float *dW, long size, const float alpha) override {
+                float *g = get<0>(W, size);
+                kernels().rmsprop(W, g, dW, size, alpha, mu, eps);
+            }
+        };
+
+        /**
+         * @brief [a new optimizer (2015)]
+         * @details [see Adam: A Method for Stochastic Optimization (Algorithm 1)
+         *               http://arxiv.org/abs/1412.6980]
+         *
+         * The bias correction of both moments is folded into the step size, so one update is
+         * a single pass over W, dW, mt and vt.
+         **/
+        class adam : public stateful_optimizer<2> {
+        public:
+            float b1; // decay term
+            float b2; // decay term
+            float eps; // constant value to avoid zero-division
+
+            adam() : b1(0.9), b2(0.999), eps(1e-8) {}
+
+            void update(float *W, const float *dW, long size, const float alpha) override {
+                adam_update(W, dW, size, alpha, 0);
+            }
+
+            void reset() override {
+                stateful_optimizer<2>::reset();
+                steps_.clear();
+            }
+
+        protected:
+            // decay is the decoupled weight decay factor, zero for plain adam.
+            void adam_update(float *W, const float *dW, long size, const float alpha, const float decay) {
+                float *mt = get<0>(W, size);
+                float *vt = get<1>(W, size);
+
+                // each parameter block counts its own steps, the blocks are updated once per batch.
+                LU_NET_ALLOC_TAG(optimizer_state);
+                long t = ++steps_[W];
+                const float step = alpha * std::sqrt(1 - std::pow(b2, float(t))) / (1 - std::pow(b1, float(t)));
+                const float eps_hat = eps * std::sqrt(1 - std::pow(b2, float(t)));
+                kernels().adam(W, mt, vt, dW, size, b1, b2, step, eps_hat, alpha * decay);
             }
 
         private:
-            vector<MatrixXf> dWprev_w;
-            vector<VectorXf> dWprev_b;
+            std::unordered_map<const float *, long> steps_;
         };
 
+        /**
+         * adam with decoupled weight decay
+         *
+         * I Loshchilov and F Hutter,
+         * Decoupled Weight Decay Regularization, ICLR 2019.
+         **/
+        class adamw : public adam {
+        public:
+            float lambda; // weight decay
+
+            adamw() : lambda(0.01) {}
+
+            void update(float *W, const float *dW, long size, const float alpha) override {
+                adam_update(W, dW, size, alpha, lambda);
+            }
+        };
     }
 }
 
@@ -0,0 +1,121 @@
+//
+// Created by 芦yafei  on 17/9/2.
+//
+#ifndef LU_NET_PROFILER_H
+#define LU_NET_PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace lu_net {
+    namespace profiler {
+
+        // Events kept per thread for the trace, older events are overwritten. Statistics count every event.
+        const size_t kTraceEvents = 1 << 16;
+
+        // Hardware counters of enable_counters(), in user space only
+        enum class counter {
+            cycles,
+            instructions,
+            llc_misses,         // last level cache read misses
+            branch_misses,
+            fp_ops,             // single precision FP arithmetic instructions of any width, Intel only
+            page_faults
+        };
+
+        const int kCounters = 6;
+
+        const char *counter_name(counter c);
+
+        /**
+         * Statistics of one scope, scopes are told apart by their path from the outermost scope,
+         * e.g. "train/update_batch/farward".
+         **/
+        struct scope_stats {
+            std::string path;
+            int depth = 0;          // number of enclosing scopes
+            long count = 0;
+            double total_ms = 0;
+            double mean_us = 0;
+            double p50_us = 0;      // percentiles within about 10%
+            double p90_us = 0;
+            double p99_us = 0;
+            double max_us = 0;
+
+            // totals of the counters by counter index over the scopes that were counted,
+            // -1 where the counter is not available, empty if enable_counters() did not cover the scope
+            std::vector<double> counters;
+        };
+
+        // Statistics of every scope of all threads, parents before their children.
+        std::vector<scope_stats> summary();
+
+        // Table of summary(), nothing if no scope was recorded.
+        void print_summary(std::ostream &out);
+
+        /**
+         * Write the last kTraceEvents scopes of every thread in the Chrome trace event format,
+         * open it with chrome://tracing or https://ui.perfetto.dev.
+         * @return false if nothing was recorded or the file can not be written
+         **/
+        bool write_chrome_trace(const std::string &filename);
+
+        // Drop the statistics and events of all threads.
+        void clear();
+
+        /**
+         * Read Linux perf_event_open counters at the start and end of every scope from now on, each thread
+         * opens its counters at its first scope. This shows whether a scope is bound by memory (low IPC,
+         * many LLC misses) or by compute. A read is a system call, so expect about a microsecond per scope.
+         * Hardware counters need perf_event_paranoid <= 2 and a PMU, which many virtual machines lack.
+         * @return false if no counter can be opened by the calling thread, or not built with LU_NET_PROFILE
+         **/
+        bool enable_counters();
+
+        void disable_counters();
+
+        /**
+         * Times the enclosing block, use it through LU_NET_PROFILE_SCOPE.
+         *
+         * Each thread records into its own buffers, so scopes do not synchronize. Timestamps are read
+         * from the TSC on x86 (invariant TSC assumed) and from steady_clock elsewhere.
+         * summary(), write_chrome_trace() and clear() read the buffers of all threads without locks,
+         * call them when no other thread is inside a scope.
+         **/
+        class scope {
+        public:
+            // name must outlive the profiler, string literals are expected
+            explicit scope(const char *name);
+
+            ~scope();
+
+            scope(const scope &) = delete;
+            scope &operator=(const scope &) = delete;
+
+        private:
+            void *buffer_;
+            int node_;
+            bool counting_;
+            uint64_t begin_;
+            uint64_t counters_[kCounters];
+        };
+    }
+}
+
+#define LU_NET_PROFILE_CONCAT_(a, b) a##b
+#define LU_NET_PROFILE_CONCAT(a, b) LU_NET_PROFILE_CONCAT_(a, b)
+
+/**
+ * Profile the rest of the enclosing block under name. Builds without LU_NET_PROFILE compile it to nothing,
+ * enable it with cmake -DLU_NET_PROFILE=ON.
+ **/
+#ifdef LU_NET_PROFILE
+#define LU_NET_PROFILE_SCOPE(name) \
+    ::lu_net::profiler::scope LU_NET_PROFILE_CONCAT(lu_net_profile_scope_, __LINE__)(name)
+#else
+#define LU_NET_PROFILE_SCOPE(name) do {} while (0)
+#endif
+
+#endif //LU_NET_PROFILER_H
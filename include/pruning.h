@@ -0,0 +1,90 @@
+//
+// Created by 芦yafei  on 17/8/24.
+//
+#ifndef LU_NET_PRUNING_H
+#define LU_NET_PRUNING_H
+
+#include <cmath>
+#include <algorithm>
+
+namespace lu_net {
+    namespace pruning {
+
+        /**
+         * base class of pruning schedule
+         *
+         * Net::train calls begin() once, then every frequency iterations prunes the weights of
+         * every layer with the smallest magnitude until sparsity(iter) of them are zero.
+         * Pruned weights stay zero for the rest of the training.
+         **/
+        class pruning_schedule {
+        public:
+            long frequency; // iterations between two pruning steps
+
+            pruning_schedule(long frequency = 100) : frequency(frequency) {}
+            virtual ~pruning_schedule() = default;
+
+            virtual void begin(long iters_per_epoch, int epochs) {
+                total_iters_ = iters_per_epoch * epochs;
+            }
+
+            // fraction of zero weights of every layer from iteration iter
+            virtual float sparsity(long iter) = 0;
+
+        protected:
+            long total_iters_ = 0;
+        };
+
+
+        /**
+         * prune to a fixed sparsity at the first pruning step
+         **/
+        class constant : public pruning_schedule {
+        public:
+            float target;
+
+            constant(float target, long frequency = 100) : pruning_schedule(frequency), target(target) {}
+
+            float sparsity(long iter) override {
+                return target;
+            }
+        };
+
+
+        /**
+         * gradual pruning, the sparsity grows from initial_sparsity to final_sparsity between
+         * begin_pct and end_pct of the run, fast at first and slowly at the end:
+         * s = s_f + (s_i - s_f) * (1 - progress)^3
+         *
+         * M Zhu and S Gupta,
+         * To prune, or not to prune: exploring the efficacy of pruning for model compression, 2017.
+         **/
+        class gradual : public pruning_schedule {
+        public:
+            float initial_sparsity;
+            float final_sparsity;
+            float begin_pct;
+            float end_pct;
+
+            gradual(float final_sparsity, float initial_sparsity = 0, float begin_pct = 0, float end_pct = 0.8,
+                    long frequency = 100)
+                    : pruning_schedule(frequency),
+                      initial_sparsity(initial_sparsity),
+                      final_sparsity(final_sparsity),
+                      begin_pct(begin_pct),
+                      end_pct(end_pct) {}
+
+            float sparsity(long iter) override {
+                const float begin_iter = begin_pct * total_iters_;
+                const float end_iter = std::max(begin_iter + 1, end_pct * total_iters_);
+                if (iter < begin_iter) {
+                    return 0;
+                }
+                float progress = std::min(1.0f, (iter - begin_iter) / (end_iter - begin_iter));
+                return final_sparsity + (initial_sparsity - final_sparsity) * std::pow(1 - progress, 3.0f);
+            }
+        };
+    }
+}
+
+#endif //LU_NET_PRUNING_H
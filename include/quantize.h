@@ -0,0 +1,65 @@
+//
+// Created by 芦yafei  on 17/8/21.
+//
+#ifndef LU_NET_QUANTIZE_H
+#define LU_NET_QUANTIZE_H
+
+#include <cstdint>
+#include <vector>
+#include <eigen3/Eigen/Dense>
+#include "net.h"
+
+namespace lu_net {
+    /**
+     * Int8 post-training quantization of a trained Net, for inference only.
+     *
+     * Weights are int8 with one scale per output neuron (row of the weights matrix). The input of every
+     * layer is uint8 with one scale and zero point per layer, calibrated on the min and max seen on a
+     * sample set. Inputs are kept to 7 bits, [0, 127], so the AVX2 u8 x s8 pair products cannot saturate
+     * 16 bits. Each layer is an int8 GEMM with int32 accumulation, dequantized into the bias and the
+     * sigmoid, then quantized again for the next layer.
+     *
+     * The kernel uses AVX-VNNI / AVX512-VNNI or AVX2 when the compiler targets them, portable code otherwise.
+     **/
+    class QuantizedNet {
+    public:
+        /**
+         * @param net                 trained net, it is not used after the constructor returns
+         * @param calibration_inputs  samples whose activation ranges give the scales, e.g. part of the training set
+         **/
+        QuantizedNet(const Net &net, const std::vector<vec_t> &calibration_inputs);
+
+        result test(const std::vector<vec_t> &inputs, const std::vector<label_t> &class_labels);
+
+        /**
+         * farward samples inputs[begin, begin + size) at once.
+         * @param out  activations of the last layer, one column per sample
+         */
+        void farward_batch(const std::vector<vec_t> &inputs, size_t begin, size_t size, Eigen::MatrixXf &out);
+
+        // Bytes of the int8 weights, scales and bias of all layers
+        size_t weights_bytes() const;
+
+    private:
+        struct Layer {
+            int rows = 0;
+            int cols = 0;
+            int stride = 0;                 // cols padded to kQuantAlign
+            std::vector<int8_t> w;          // row major, rows x stride
+            Eigen::VectorXf scale;          // weight scale of each row times in_scale
+            Eigen::VectorXf bias;           // bias with the input zero point folded in
+            float in_scale = 1;
+            int in_zero_point = 0;
+        };
+
+        // quantize a float column into a uint8 activation column of layer i
+        void quantize_input(int i, const float *x, uint8_t *q) const;
+
+        std::vector<Layer> layers_;
+        std::vector<uint8_t> a_;            // quantized inputs of the current layer, one stride wide column per sample
+        std::vector<uint8_t> a_next_;
+        Eigen::MatrixXf z_;
+    };
+}
+
+#endif //LU_NET_QUANTIZE_H
@@ -5,17 +5,26 @@
 #ifndef LU_NET_RANDOM_H
 #define LU_NET_RANDOM_H
 
+#include <atomic>
+#include <cstdint>
 #include <random>
 #include <type_traits>
 #include <limits>
 #include "net.h"
+#include "cpu_dispatch.h"
 
 namespace lu_net {
 
+    /**
+     * mt19937 of the calling thread, used by the scalar functions below.
+     * The first thread which draws (normally the main thread) starts from the seed of set_random_seed(),
+     * the next ones from seeds derived from it and their order, so threads never share a sequence.
+     * Which numbers a thread gets depends on that order, use random_stream when it must not.
+     **/
     class random_generator {
     public:
         static random_generator& get_instance() {
-            static random_generator instance;
+            static thread_local random_generator instance;
             return instance;
         }
 
@@ -26,10 +35,23 @@ namespace lu_net {
         void set_seed(unsigned int seed) {
             gen_.seed(seed);
         }
+
+        // seed of set_random_seed()
+        static std::atomic<unsigned int>& base_seed() {
+            // avoid gen_(0) for MSVC known issue
+            // https://connect.microsoft.com/VisualStudio/feedback/details/776456
+            static std::atomic<unsigned int> seed(1);
+            return seed;
+        }
+
     private:
-        // avoid gen_(0) for MSVC known issue
-        // https://connect.microsoft.com/VisualStudio/feedback/details/776456
-        random_generator() : gen_(1) {}
+        random_generator() : gen_(base_seed() + 0x9E3779B9u * next_thread()) {}
+
+        static unsigned int next_thread() {
+            static std::atomic<unsigned int> threads(0);
+            return threads++;
+        }
+
         std::mt19937 gen_;
     };
 
@@ -54,7 +76,9 @@ namespace lu_net {
         return dst(random_generator::get_instance()());
     }
 
+    // seed the generator of the calling thread and the ones of threads which have not drawn yet, and random_stream
     inline void set_random_seed(unsigned int seed) {
+        random_generator::base_seed() = seed;
         random_generator::get_instance().set_seed(seed);
     }
 
@@ -79,6 +103,125 @@ namespace lu_net {
             *it = gaussian_rand(mean, sigma);
     }
 
+
+    /**
+     * Philox4x32-10 of J K Salmon, M A Moraes, R O Dror and D E Shaw,
+     * Parallel random numbers: as easy as 1, 2, 3, SC 2011.
+     * Ten rounds over the 128 bit counter ctr with the 64 bit key, out may be ctr.
+     **/
+    inline void philox4x32_10(const uint32_t *ctr, const uint32_t *key, uint32_t *out) {
+        uint32_t x0 = ctr[0], x1 = ctr[1], x2 = ctr[2], x3 = ctr[3];
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int r = 0; r < 10; r++) {
+            uint64_t p0 = uint64_t(0xD2511F53u) * x0;
+            uint64_t p1 = uint64_t(0xCD9E8D57u) * x2;
+            x0 = uint32_t(p1 >> 32) ^ x1 ^ k0;
+            x1 = uint32_t(p1);
+            x2 = uint32_t(p0 >> 32) ^ x3 ^ k1;
+            x3 = uint32_t(p0);
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = x0;
+        out[1] = x1;
+        out[2] = x2;
+        out[3] = x3;
+    }
+
+    // stream id of e.g. (layer, sample) or (epoch, thread)
+    inline uint64_t stream_id(uint32_t a, uint32_t b) {
+        return uint64_t(a) << 32 | b;
+    }
+
+    /**
+     * Counter-based random numbers: value i of a stream is a function of the seed, the stream id and i only.
+     * Give each layer, sample or thread its own stream and the numbers do not depend on which thread
+     * draws them or when, so parallel work reproduces bit for bit for any number of threads.
+     *
+     * Block j of a stream is Philox4x32-10 of the counter (j, stream) with the seed as key, four 32 bit
+     * values per block. The bulk functions start at the next unused block and fill the buffer with the
+     * SIMD kernels of cpu_dispatch.h. A stream is not thread safe, copy it or make one per thread.
+     **/
+    class random_stream {
+    public:
+        // stream of the seed of set_random_seed()
+        explicit random_stream(uint64_t stream = 0) : random_stream(random_generator::base_seed(), stream) {}
+
+        random_stream(uint64_t seed, uint64_t stream) : stream_(stream) {
+            key_[0] = uint32_t(seed);
+            key_[1] = uint32_t(seed >> 32);
+        }
+
+        // next 32 bit value
+        uint32_t next() {
+            if (used_ == 4) {
+                uint32_t ctr[4] = {uint32_t(block_), uint32_t(block_ >> 32), uint32_t(stream_), uint32_t(stream_ >> 32)};
+                philox4x32_10(ctr, key_, words_);
+                block_++;
+                used_ = 0;
+            }
+            return words_[used_++];
+        }
+
+        // uniform in [min, max) from the high 24 bits of next()
+        float uniform(float min, float max) {
+            return min + (max - min) * (float(next() >> 8) * (1.0f / 16777216.0f));
+        }
+
+        float gaussian(float mean, float sigma) {
+            if (normals_used_ == 4) {
+                kernels().philox_gaussian(key_, stream_, block_, normals_, 4, 0, 1);
+                block_++;
+                normals_used_ = 0;
+            }
+            return mean + sigma * normals_[normals_used_++];
+        }
+
+        bool bernoulli(float p) {
+            return uniform(0, 1) < p;
+        }
+
+        // size uniforms in [min, max), from the next size / 4 blocks
+        void uniform(float *out, long size, float min, float max) {
+            kernels().philox_uniform(key_, stream_, block_, out, size, min, max);
+            block_ += uint64_t(size + 3) / 4;
+        }
+
+        // size normals by Box-Muller, from the next size / 4 blocks
+        void gaussian(float *out, long size, float mean, float sigma) {
+            kernels().philox_gaussian(key_, stream_, block_, out, size, mean, sigma);
+            block_ += uint64_t(size + 3) / 4;
+        }
+
+        /**
+         * size bits set with probability p, packed 32 per word into (size + 31) / 32 words of mask,
+         * bit j of mask[j / 32] from the same value as uniform(out, size, 0, 1)[j].
+         **/
+        void bernoulli(uint32_t *mask, long size, float p) {
+            const uint32_t threshold = p >= 1 ? 0xFFFFFFFFu : p <= 0 ? 0 : uint32_t(double(p) * 4294967296.0);
+            kernels().philox_mask(key_, stream_, block_, mask, size, threshold);
+            block_ += uint64_t(size + 3) / 4;
+        }
+
+        // continue from block, dropping the values left of the current block
+        void seek(uint64_t block) {
+            block_ = block;
+            used_ = 4;
+            normals_used_ = 4;
+        }
+
+        uint64_t block() const { return block_; }
+
+    private:
+        uint32_t key_[2];
+        uint64_t stream_;
+        uint64_t block_ = 0;
+        uint32_t words_[4];
+        int used_ = 4;              // values of words_ returned
+        float normals_[4];
+        int normals_used_ = 4;
+    };
+
 } // namespace lu_net
 
 
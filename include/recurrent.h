@@ -0,0 +1,104 @@
+//
+// Created by 芦yafei  on 17/8/14.
+//
+#ifndef LU_NET_RECURRENT_H
+#define LU_NET_RECURRENT_H
+
+#include <eigen3/Eigen/Dense>
+#include <vector>
+
+namespace lu_net{
+    /**
+     * States of a minibatch of sequences for all steps of a recurrent layer, one column per sample.
+     *
+     * The columns of one step are contiguous, column offset(t) + n belongs to sequence n at step t.
+     * Sequences of different lengths are packed: they are sorted longest first and step t only holds
+     * the batch_size(t) sequences still running, so finished sequences take no columns and no FLOPs.
+     * For sequences of the same length offset(t) is t * batch_size.
+     * The matrices grow geometrically and are kept between sequences, reset() only clears the step
+     * count, so the memory is H * columns and does not depend on the size of the weights.
+     * s0 and h0 are the states before the first stored step, zero for a new sequence.
+     *
+     * @gate_rows: rows per sample the layer keeps for its gates (weighted inputs, activations)
+     * @cell_rows: rows of the internal state s, 0 if the layer has none
+     **/
+    class SequenceState {
+    public:
+        SequenceState(int x_dim, int gate_rows, int hidden_dim, int cell_rows, int batch_size = 1);
+
+        virtual ~SequenceState();
+
+        // Drop all steps and start from zero states, the step memory is kept
+        void reset();
+
+        // Drop all steps and change the number of sequences of the minibatch
+        void reset(int batch_size);
+
+        // Drop the first n steps, the state of step n - 1 becomes the initial state
+        void drop_front(int n);
+
+        // Make room for steps, the stored steps are kept
+        void reserve(int steps);
+
+        // Append one step of all sequences and return its index
+        int push_step() { return push_step(batch_size_); }
+
+        // Append one step of the first active sequences, no more than in the step before
+        int push_step(int active);
+
+        int steps() const { return steps_; }
+
+        int batch_size() const { return batch_size_; }
+
+        // Sequences still running at step t
+        int batch_size(int t) const { return sizes_[t]; }
+
+        // First column of step t
+        int offset(int t) const { return offsets_[t]; }
+
+        // Columns of step t
+        Eigen::MatrixXf::ColsBlockXpr x(int t) { return x_.middleCols(offsets_[t], sizes_[t]); }
+        Eigen::MatrixXf::ColsBlockXpr gates(int t) { return gates_.middleCols(offsets_[t], sizes_[t]); }
+        Eigen::MatrixXf::ColsBlockXpr s(int t) { return s_.middleCols(offsets_[t], sizes_[t]); }
+        Eigen::MatrixXf::ColsBlockXpr h(int t) { return h_.middleCols(offsets_[t], sizes_[t]); }
+
+        // States before step t of the sequences running at step t, the initial states for t = 0
+        Eigen::MatrixXf::ColsBlockXpr s_prev(int t) {
+            return t > 0 ? s_.middleCols(offsets_[t - 1], sizes_[t]) : s0_.leftCols(sizes_[t]);
+        }
+        Eigen::MatrixXf::ColsBlockXpr h_prev(int t) {
+            return t > 0 ? h_.middleCols(offsets_[t - 1], sizes_[t]) : h0_.leftCols(sizes_[t]);
+        }
+
+        // Initial states, one column per sequence
+        Eigen::MatrixXf &s0() { return s0_; }
+        Eigen::MatrixXf &h0() { return h0_; }
+
+        // Columns of all stored steps
+        Eigen::MatrixXf::ColsBlockXpr x() { return x_.leftCols(cols_); }
+        Eigen::MatrixXf::ColsBlockXpr gates() { return gates_.leftCols(cols_); }
+        Eigen::MatrixXf::ConstColsBlockXpr x() const { return x_.leftCols(cols_); }
+        Eigen::MatrixXf::ConstColsBlockXpr s() const { return s_.leftCols(cols_); }
+        Eigen::MatrixXf::ConstColsBlockXpr h() const { return h_.leftCols(cols_); }
+
+    private:
+        int x_dim_ = 0;
+        int gate_rows_ = 0;
+        int hidden_dim_ = 0;
+        int cell_rows_ = 0;
+        int batch_size_ = 0;
+        int steps_ = 0;
+        int cols_ = 0;              // columns of the stored steps
+        int capacity_ = 0;          // columns the matrices can hold
+        std::vector<int> offsets_;
+        std::vector<int> sizes_;
+
+        Eigen::MatrixXf x_;
+        Eigen::MatrixXf gates_;
+        Eigen::MatrixXf s_;         // internal state
+        Eigen::MatrixXf h_;         // the values output by each memory cell in the hidden layer
+        Eigen::MatrixXf s0_;
+        Eigen::MatrixXf h0_;
+    };
+}
+#endif //LU_NET_RECURRENT_H
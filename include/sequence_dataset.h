@@ -0,0 +1,83 @@
+//
+// Created by 芦yafei  on 17/8/16.
+//
+#ifndef LU_NET_SEQUENCE_DATASET_H
+#define LU_NET_SEQUENCE_DATASET_H
+
+#include <eigen3/Eigen/Dense>
+#include <vector>
+
+namespace lu_net{
+    /**
+     * Sequences of inputs and per step targets for recurrent training, one column per step.
+     **/
+    class SequenceDataset {
+    public:
+        // x: x_dim x length inputs, y: y_dim x length targets
+        void add(const Eigen::MatrixXf &x, const Eigen::MatrixXf &y);
+
+        size_t size() const { return x_.size(); }
+
+        int length(size_t i) const { return int(x_[i].cols()); }
+
+        const Eigen::MatrixXf &x(size_t i) const { return x_[i]; }
+
+        const Eigen::MatrixXf &y(size_t i) const { return y_[i]; }
+
+    private:
+        std::vector<Eigen::MatrixXf> x_;
+        std::vector<Eigen::MatrixXf> y_;
+    };
+
+
+    /**
+     * A minibatch of packed sequences, the layout of SequenceState: sequences sorted longest first,
+     * step t holds the batch_sizes[t] sequences still running in contiguous columns.
+     **/
+    class SequenceBatch {
+    public:
+        Eigen::MatrixXf x;
+        Eigen::MatrixXf y;
+        std::vector<int> batch_sizes;   // sequences still running at each step
+        std::vector<size_t> index;      // dataset index of each sequence of the minibatch
+
+        int steps() const { return int(batch_sizes.size()); }
+
+        // Columns a padded minibatch of the same sequences would have
+        long padded_cols() const { return long(steps()) * (batch_sizes.empty() ? 0 : batch_sizes[0]); }
+    };
+
+
+    /**
+     * Length bucketed minibatches over a SequenceDataset.
+     *
+     * Sequences are sorted by length and cut into minibatches, so a minibatch holds sequences of
+     * about the same length and packing leaves few idle steps. With shuffle, sequences of the same
+     * length are drawn in random order and the minibatches come in random order every epoch.
+     **/
+    class SequenceBatcher {
+    public:
+        SequenceBatcher(const SequenceDataset &dataset, int batch_size, bool shuffle = true);
+
+        // Start an epoch, buckets the sequences again
+        void begin_epoch();
+
+        /**
+         * Pack the next minibatch of the epoch.
+         * @return false at the end of the epoch
+         * **/
+        bool next(SequenceBatch &batch);
+
+        // Minibatches per epoch
+        size_t batches() const { return (dataset_.size() + batch_size_ - 1) / batch_size_; }
+
+    private:
+        const SequenceDataset &dataset_;
+        int batch_size_;
+        bool shuffle_;
+        std::vector<size_t> order_;     // dataset indices, longest first within every minibatch
+        std::vector<size_t> batches_;   // first position in order_ of each minibatch, in epoch order
+        size_t cursor_ = 0;
+    };
+}
+#endif //LU_NET_SEQUENCE_DATASET_H
@@ -0,0 +1,128 @@
+//
+// Created by 芦yafei  on 17/9/14.
+//
+#ifndef LU_NET_SEQUENTIAL_H
+#define LU_NET_SEQUENTIAL_H
+
+#include <memory>
+#include <ostream>
+#include <vector>
+#include <eigen3/Eigen/Dense>
+#include "layer.h"
+#include "optimizer.h"
+
+namespace lu_net {
+    /**
+     * Net of layers applied one after the other, e.g.
+     *
+     *     sequential net(784);
+     *     net.add(std::make_shared<layers::fully_connected>(100)).add(std::make_shared<layers::sigmoid>())
+     *        .add(std::make_shared<layers::fully_connected>(10)).add(std::make_shared<layers::sigmoid>());
+     *     net.init_params(1);
+     *
+     * The parameters of all layers live in one flat buffer, and their gradients in another with the same layout.
+     *
+     * Activations are planned per phase before the first farward. An activation gets a buffer of its own only
+     * if back_prop reads it, e.g. the input of a fully_connected or the output of a sigmoid layer. The other
+     * ones only live until the next layer has read them, and they share buffers. At test time nothing is kept
+     * for backward, so two buffers are enough whatever the depth. The buffers grow with the minibatch and
+     * are never shrunk, so farward and backward do not allocate once the largest minibatch has been seen.
+     **/
+    class sequential {
+    public:
+        explicit sequential(long in_size) : in_size_(in_size) {}
+
+        sequential(const sequential &) = delete;
+        sequential &operator=(const sequential &) = delete;
+
+        // append l, its input is the output of the last layer
+        sequential &add(std::shared_ptr<layer> l);
+
+        long in_size() const { return in_size_; }
+
+        long out_size() const { return sizes_.empty() ? in_size_ : sizes_.back(); }
+
+        size_t layers() const { return layers_.size(); }
+
+        layer &operator[](size_t i) { return *layers_[i]; }
+
+        // initialize the parameters, layer i from Philox stream i of seed
+        void init_params(uint64_t seed);
+
+        /**
+         * farward a minibatch, one column per sample.
+         * In the train phase the activations back_prop needs are kept for backward(), x is copied if needed.
+         * @return activations of the last layer, valid until the next farward
+         **/
+        const_batch_t farward(const Eigen::Ref<const Eigen::MatrixXf> &x, net_phase phase = net_phase::test);
+
+        // add the gradients of the last train farward to grads(), out_grad is the gradient of the loss by its output
+        void backward(const Eigen::Ref<const Eigen::MatrixXf> &out_grad);
+
+        // every parameter, one block per layer padded to 16 floats
+        Eigen::VectorXf &params() { return params_; }
+
+        Eigen::VectorXf &grads() { return grads_; }
+
+        /**
+         * farward and backward a minibatch, then one optimizer step with the mean gradient.
+         * @return mean loss of the samples
+         **/
+        template <typename E>
+        float train_batch(optimizer::optimizer &optimizer, const Eigen::Ref<const Eigen::MatrixXf> &x,
+                          const Eigen::Ref<const Eigen::MatrixXf> &y, float learning_rate) {
+            const_batch_t out = farward(x, net_phase::train);
+            Eigen::MatrixXf out_grad(out.rows(), out.cols());
+            float sum_loss = 0.0;
+            for (long j = 0; j < out.cols(); j++) {
+                sum_loss += E::f(out.col(j), y.col(j));
+                out_grad.col(j) = E::df(out.col(j), y.col(j));
+            }
+            grads_.setZero();
+            backward(out_grad);
+            grads_ /= float(x.cols());
+            optimizer.update(params_.data(), grads_.data(), params_.size(), learning_rate);
+            return sum_loss / x.cols();
+        }
+
+        // activation buffers planned for phase
+        int buffers(net_phase phase);
+
+        // layers with their shapes, parameters and buffers
+        void print(std::ostream &out);
+
+    private:
+        // buffer of the output of every layer
+        struct plan {
+            bool done = false;
+            std::vector<int> buffer;
+            int buffers = 0;
+        };
+
+        long in_size_;
+        std::vector<std::shared_ptr<layer> > layers_;
+        std::vector<long> sizes_;           // rows of the output of every layer
+        std::vector<long> offsets_;         // first parameter of every layer in params_
+        Eigen::VectorXf params_;
+        Eigen::VectorXf grads_;
+        bool set_up_ = false;
+
+        plan plans_[2];                     // by net_phase
+        std::vector<Eigen::VectorXf> buffers_;
+        Eigen::VectorXf grad_buffers_[2];   // gradients by the outputs, back_prop alternates between them
+        Eigen::MatrixXf input_;             // copy of an input kept for backward or whose columns are not contiguous
+        const float *in_data_ = nullptr;    // input of the last farward
+        long cols_ = 0;                     // columns of the last farward
+        bool backward_ready_ = false;       // the last farward was in the train phase
+
+        // allocate the parameters and bind them to the layers
+        void setup();
+
+        plan &get_plan(net_phase phase);
+
+        // activations of layer i (0 is the input), of the last farward
+        const_batch_t activation(int i, const plan &p) const;
+    };
+}
+
+#endif //LU_NET_SEQUENTIAL_H
@@ -0,0 +1,47 @@
+//
+// Created by 芦yafei  on 17/8/24.
+//
+#ifndef LU_NET_SPARSE_NET_H
+#define LU_NET_SPARSE_NET_H
+
+#include <vector>
+#include <eigen3/Eigen/Dense>
+#include <eigen3/Eigen/Sparse>
+#include "net.h"
+
+namespace lu_net {
+    /**
+     * Inference of a pruned Net with the weights of every layer as CSR matrices.
+     * Only the non-zero weights are stored and multiplied, so a layer costs O(non-zeros) per sample.
+     * Activations of a batch are row major, each non-zero weight scales one contiguous row of samples.
+     **/
+    class SparseNet {
+    public:
+        // zero weights of net are dropped, net is not used after the constructor returns
+        explicit SparseNet(const Net &net);
+
+        result test(const std::vector<vec_t> &inputs, const std::vector<label_t> &class_labels);
+
+        /**
+         * farward samples inputs[begin, begin + size) at once.
+         * @param out  activations of the last layer, one column per sample
+         */
+        void farward_batch(const std::vector<vec_t> &inputs, size_t begin, size_t size, Eigen::MatrixXf &out);
+
+        // Non-zero weights of all layers
+        long non_zeros() const;
+
+        // Bytes of the CSR weights and bias of all layers
+        size_t weights_bytes() const;
+
+    private:
+        typedef Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMatrixXf;
+
+        std::vector<Eigen::SparseMatrix<float, Eigen::RowMajor> > weights_;
+        std::vector<Eigen::VectorXf> bias_;
+        RowMatrixXf a_;
+        RowMatrixXf z_;
+    };
+}
+
+#endif //LU_NET_SPARSE_NET_H
@@ -0,0 +1,30 @@
+//
+// Created by 芦yafei  on 17/9/13.
+//
+#ifndef LU_NET_WEIGHT_INIT_H
+#define LU_NET_WEIGHT_INIT_H
+
+#include "random.h"
+
+namespace lu_net {
+    namespace weight_init {
+
+        // Initialization of the weights of a layer, fan_in is the inputs of a neuron and fan_out the neurons
+        enum class scheme {
+            lecun,          // N(0, 1 / fan_in), the default of Net::initWeights
+            xavier,         // U(-a, a), a = sqrt(6 / (fan_in + fan_out)), Glorot and Bengio 2010
+            he,             // N(0, 2 / fan_in), He et al. 2015, for relu layers
+            orthogonal      // orthonormal rows or columns, Saxe et al. 2014
+        };
+
+        const char *scheme_name(scheme s);
+
+        /**
+         * Fill the fan_out x fan_in column-major matrix w. The normals and uniforms are drawn in bulk by the
+         * SIMD kernels of random_stream, straight into w, and depend only on the stream.
+         **/
+        void fill(scheme s, float *w, long fan_out, long fan_in, random_stream &rng);
+    }
+}
+
+#endif //LU_NET_WEIGHT_INIT_H
@@ -8,7 +8,9 @@
 #include <glog/logging.h>
 #include <vector>
 #include "optimizer.h"
-#include "display.h"
+#include "profiler.h"
+#include "metrics.h"
+#include "alloc_tracker.h"
 #include "dropout_layer.h"
 
 using namespace std;
@@ -16,6 +18,7 @@ using namespace cv;
 using namespace lu_net;
 
 DEFINE_string(data_dir, "/Users/luyafei/GitHub/lu_net/data/mnist", "Data directory");
+DEFINE_double(keep_prob, 1.0, "Keep probability of the hidden units in training, 1 disables dropout");
 
 int main(int argc, char** argv) {
     gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -31,6 +34,7 @@ int main(int argc, char** argv) {
     net.initNet(layers_neuron_num, 0.5, 5.0);
     net.initWeights(0);
     net.initBias(0);
+    net.set_dropout(1, FLAGS_keep_prob);
 
     // load MNIST dataset
     string data_dir = FLAGS_data_dir;
@@ -47,9 +51,6 @@ int main(int argc, char** argv) {
     read_Mnist_Label(test_labels_path, test_labels);
     read_Mnist_Images(test_images_path, test_images);
 
-    timer t;
-    cout << t.elapsed() << "s elapsed." << std::endl;
-
     LOG(INFO) << "Initial val.";
 
     result initial_test = net.test(test_images, test_labels);
@@ -60,6 +61,16 @@ int main(int argc, char** argv) {
     int num_epochs = 30;
     optimizer::gradient_descent op;
 
+    // throughput every 1000 minibatches, also as JSON lines
+    net.set_metrics(std::make_shared<metrics::training_metrics>(1000, "lu_net_metrics.jsonl"));
+
+#ifdef LU_NET_PROFILE
+    // hardware counters of the profiled scopes, if the machine has them
+    if (!profiler::enable_counters()) {
+        LOG(INFO) << "no performance counters, perf_event_open failed";
+    }
+#endif
+
     net.train<cross_entropy>(op, train_images, train_labels, minibatch_size, num_epochs);
     LOG(INFO) << "End training.";
 
@@ -69,6 +80,13 @@ int main(int argc, char** argv) {
 
     net.save("lu_net.model", content_type::weights_and_model, file_format::binary);
 
+    // only with -DLU_NET_PROFILE=ON
+    profiler::print_summary(cout);
+    profiler::write_chrome_trace("lu_net_trace.json");
+
+    // only with -DLU_NET_TRACK_ALLOC=ON
+    alloc_tracker::print(cout);
+
     gflags::ShutDownCommandLineFlags();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,2183 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: lu.proto
+
+#include "lu.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+
+PROTOBUF_PRAGMA_INIT_SEG
+
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
+
+namespace lu_net {
+PROTOBUF_CONSTEXPR Datum::Datum(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.float_data_)*/{}
+  , /*decltype(_impl_.data_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.channels_)*/0
+  , /*decltype(_impl_.height_)*/0
+  , /*decltype(_impl_.width_)*/0
+  , /*decltype(_impl_.label_)*/0
+  , /*decltype(_impl_.encoded_)*/false} {}
+struct DatumDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR DatumDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~DatumDefaultTypeInternal() {}
+  union {
+    Datum _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 DatumDefaultTypeInternal _Datum_default_instance_;
+PROTOBUF_CONSTEXPR NetParameterMsg::NetParameterMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.layers_neuron_num_)*/{}
+  , /*decltype(_impl_._layers_neuron_num_cached_byte_size_)*/{0}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct NetParameterMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR NetParameterMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~NetParameterMsgDefaultTypeInternal() {}
+  union {
+    NetParameterMsg _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 NetParameterMsgDefaultTypeInternal _NetParameterMsg_default_instance_;
+PROTOBUF_CONSTEXPR ModelMsg::ModelMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.net_param_)*/nullptr
+  , /*decltype(_impl_.learning_rate_)*/0} {}
+struct ModelMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR ModelMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~ModelMsgDefaultTypeInternal() {}
+  union {
+    ModelMsg _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ModelMsgDefaultTypeInternal _ModelMsg_default_instance_;
+PROTOBUF_CONSTEXPR MatrixMsg::MatrixMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.data_)*/{}
+  , /*decltype(_impl_.row_ptr_)*/{}
+  , /*decltype(_impl_._row_ptr_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.col_index_)*/{}
+  , /*decltype(_impl_._col_index_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.rows_)*/0u
+  , /*decltype(_impl_.cols_)*/0u} {}
+struct MatrixMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR MatrixMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~MatrixMsgDefaultTypeInternal() {}
+  union {
+    MatrixMsg _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 MatrixMsgDefaultTypeInternal _MatrixMsg_default_instance_;
+PROTOBUF_CONSTEXPR VectorMsg::VectorMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.data_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct VectorMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR VectorMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~VectorMsgDefaultTypeInternal() {}
+  union {
+    VectorMsg _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 VectorMsgDefaultTypeInternal _VectorMsg_default_instance_;
+PROTOBUF_CONSTEXPR WeightsMsg::WeightsMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.weights_)*/{}
+  , /*decltype(_impl_.bias_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct WeightsMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR WeightsMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~WeightsMsgDefaultTypeInternal() {}
+  union {
+    WeightsMsg _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 WeightsMsgDefaultTypeInternal _WeightsMsg_default_instance_;
+PROTOBUF_CONSTEXPR ModelWeightsMsg::ModelWeightsMsg(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.model_)*/nullptr
+  , /*decltype(_impl_.weights_)*/nullptr} {}
+struct ModelWeightsMsgDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR ModelWeightsMsgDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~ModelWeightsMsgDefaultTypeInternal() {}
+  union {
+    ModelWeightsMsg _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ModelWeightsMsgDefaultTypeInternal _ModelWeightsMsg_default_instance_;
+}  // namespace lu_net
+static ::_pb::Metadata file_level_metadata_lu_2eproto[7];
+static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_lu_2eproto = nullptr;
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_lu_2eproto = nullptr;
+
+const uint32_t TableStruct_lu_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  PROTOBUF_FIELD_OFFSET(::lu_net::Datum, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::Datum, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::lu_net::Datum, _impl_.channels_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::Datum, _impl_.height_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::Datum, _impl_.width_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::Datum, _impl_.data_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::Datum, _impl_.label_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::Datum, _impl_.float_data_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::Datum, _impl_.encoded_),
+  1,
+  2,
+  3,
+  0,
+  4,
+  ~0u,
+  5,
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::lu_net::NetParameterMsg, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::lu_net::NetParameterMsg, _impl_.layers_neuron_num_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::ModelMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::ModelMsg, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::lu_net::ModelMsg, _impl_.learning_rate_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::ModelMsg, _impl_.net_param_),
+  1,
+  0,
+  PROTOBUF_FIELD_OFFSET(::lu_net::MatrixMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::MatrixMsg, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::lu_net::MatrixMsg, _impl_.rows_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::MatrixMsg, _impl_.data_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::MatrixMsg, _impl_.cols_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::MatrixMsg, _impl_.row_ptr_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::MatrixMsg, _impl_.col_index_),
+  0,
+  ~0u,
+  1,
+  ~0u,
+  ~0u,
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::lu_net::VectorMsg, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::lu_net::VectorMsg, _impl_.data_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::lu_net::WeightsMsg, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::lu_net::WeightsMsg, _impl_.weights_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::WeightsMsg, _impl_.bias_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::ModelWeightsMsg, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::ModelWeightsMsg, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::lu_net::ModelWeightsMsg, _impl_.model_),
+  PROTOBUF_FIELD_OFFSET(::lu_net::ModelWeightsMsg, _impl_.weights_),
+  0,
+  1,
+};
+static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, 13, -1, sizeof(::lu_net::Datum)},
+  { 20, -1, -1, sizeof(::lu_net::NetParameterMsg)},
+  { 27, 35, -1, sizeof(::lu_net::ModelMsg)},
+  { 37, 48, -1, sizeof(::lu_net::MatrixMsg)},
+  { 53, -1, -1, sizeof(::lu_net::VectorMsg)},
+  { 60, -1, -1, sizeof(::lu_net::WeightsMsg)},
+  { 68, 76, -1, sizeof(::lu_net::ModelWeightsMsg)},
+};
+
+static const ::_pb::Message* const file_default_instances[] = {
+  &::lu_net::_Datum_default_instance_._instance,
+  &::lu_net::_NetParameterMsg_default_instance_._instance,
+  &::lu_net::_ModelMsg_default_instance_._instance,
+  &::lu_net::_MatrixMsg_default_instance_._instance,
+  &::lu_net::_VectorMsg_default_instance_._instance,
+  &::lu_net::_WeightsMsg_default_instance_._instance,
+  &::lu_net::_ModelWeightsMsg_default_instance_._instance,
+};
+
+const char descriptor_table_protodef_lu_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\010lu.proto\022\006lu_net\"\201\001\n\005Datum\022\020\n\010channels"
+  "\030\001 \001(\005\022\016\n\006height\030\002 \001(\005\022\r\n\005width\030\003 \001(\005\022\014\n"
+  "\004data\030\004 \001(\014\022\r\n\005label\030\005 \001(\005\022\022\n\nfloat_data"
+  "\030\006 \003(\002\022\026\n\007encoded\030\007 \001(\010:\005false\"0\n\017NetPar"
+  "ameterMsg\022\035\n\021layers_neuron_num\030\001 \003(\005B\002\020\001"
+  "\"M\n\010ModelMsg\022\025\n\rlearning_rate\030\001 \001(\002\022*\n\tn"
+  "et_param\030\002 \001(\0132\027.lu_net.NetParameterMsg\""
+  "e\n\tMatrixMsg\022\014\n\004rows\030\001 \002(\r\022\020\n\004data\030\002 \003(\002"
+  "B\002\020\001\022\014\n\004cols\030\003 \001(\r\022\023\n\007row_ptr\030\004 \003(\rB\002\020\001\022"
+  "\025\n\tcol_index\030\005 \003(\rB\002\020\001\"\035\n\tVectorMsg\022\020\n\004d"
+  "ata\030\001 \003(\002B\002\020\001\"Q\n\nWeightsMsg\022\"\n\007weights\030\002"
+  " \003(\0132\021.lu_net.MatrixMsg\022\037\n\004bias\030\003 \003(\0132\021."
+  "lu_net.VectorMsg\"W\n\017ModelWeightsMsg\022\037\n\005m"
+  "odel\030\001 \001(\0132\020.lu_net.ModelMsg\022#\n\007weights\030"
+  "\002 \001(\0132\022.lu_net.WeightsMsg"
+  ;
+static ::_pbi::once_flag descriptor_table_lu_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_lu_2eproto = {
+    false, false, 585, descriptor_table_protodef_lu_2eproto,
+    "lu.proto",
+    &descriptor_table_lu_2eproto_once, nullptr, 0, 7,
+    schemas, file_default_instances, TableStruct_lu_2eproto::offsets,
+    file_level_metadata_lu_2eproto, file_level_enum_descriptors_lu_2eproto,
+    file_level_service_descriptors_lu_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_lu_2eproto_getter() {
+  return &descriptor_table_lu_2eproto;
+}
+
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_lu_2eproto(&descriptor_table_lu_2eproto);
+namespace lu_net {
+
+// ===================================================================
+
+class Datum::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Datum>()._impl_._has_bits_);
+  static void set_has_channels(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_height(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_width(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_data(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_label(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_encoded(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+};
+
+Datum::Datum(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:lu_net.Datum)
+}
+Datum::Datum(const Datum& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Datum* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.float_data_){from._impl_.float_data_}
+    , decltype(_impl_.data_){}
+    , decltype(_impl_.channels_){}
+    , decltype(_impl_.height_){}
+    , decltype(_impl_.width_){}
+    , decltype(_impl_.label_){}
+    , decltype(_impl_.encoded_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.data_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.data_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_data()) {
+    _this->_impl_.data_.Set(from._internal_data(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.channels_, &from._impl_.channels_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.encoded_) -
+    reinterpret_cast<char*>(&_impl_.channels_)) + sizeof(_impl_.encoded_));
+  // @@protoc_insertion_point(copy_constructor:lu_net.Datum)
+}
+
+inline void Datum::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.float_data_){arena}
+    , decltype(_impl_.data_){}
+    , decltype(_impl_.channels_){0}
+    , decltype(_impl_.height_){0}
+    , decltype(_impl_.width_){0}
+    , decltype(_impl_.label_){0}
+    , decltype(_impl_.encoded_){false}
+  };
+  _impl_.data_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.data_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+Datum::~Datum() {
+  // @@protoc_insertion_point(destructor:lu_net.Datum)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Datum::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.float_data_.~RepeatedField();
+  _impl_.data_.Destroy();
+}
+
+void Datum::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Datum::Clear() {
+// @@protoc_insertion_point(message_clear_start:lu_net.Datum)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.float_data_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    _impl_.data_.ClearNonDefaultToEmpty();
+  }
+  if (cached_has_bits & 0x0000003eu) {
+    ::memset(&_impl_.channels_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.encoded_) -
+        reinterpret_cast<char*>(&_impl_.channels_)) + sizeof(_impl_.encoded_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Datum::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional int32 channels = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_channels(&has_bits);
+          _impl_.channels_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional int32 height = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_height(&has_bits);
+          _impl_.height_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional int32 width = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_width(&has_bits);
+          _impl_.width_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bytes data = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          auto str = _internal_mutable_data();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional int32 label = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _Internal::set_has_label(&has_bits);
+          _impl_.label_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated float float_data = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 53)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            _internal_add_float_data(::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr));
+            ptr += sizeof(float);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<53>(ptr));
+        } else if (static_cast<uint8_t>(tag) == 50) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedFloatParser(_internal_mutable_float_data(), ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bool encoded = 7 [default = false];
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _Internal::set_has_encoded(&has_bits);
+          _impl_.encoded_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Datum::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:lu_net.Datum)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional int32 channels = 1;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(1, this->_internal_channels(), target);
+  }
+
+  // optional int32 height = 2;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(2, this->_internal_height(), target);
+  }
+
+  // optional int32 width = 3;
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(3, this->_internal_width(), target);
+  }
+
+  // optional bytes data = 4;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->WriteBytesMaybeAliased(
+        4, this->_internal_data(), target);
+  }
+
+  // optional int32 label = 5;
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(5, this->_internal_label(), target);
+  }
+
+  // repeated float float_data = 6;
+  for (int i = 0, n = this->_internal_float_data_size(); i < n; i++) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(6, this->_internal_float_data(i), target);
+  }
+
+  // optional bool encoded = 7 [default = false];
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(7, this->_internal_encoded(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:lu_net.Datum)
+  return target;
+}
+
+size_t Datum::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:lu_net.Datum)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated float float_data = 6;
+  {
+    unsigned int count = static_cast<unsigned int>(this->_internal_float_data_size());
+    size_t data_size = 4UL * count;
+    total_size += 1 *
+                  ::_pbi::FromIntSize(this->_internal_float_data_size());
+    total_size += data_size;
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    // optional bytes data = 4;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+          this->_internal_data());
+    }
+
+    // optional int32 channels = 1;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_channels());
+    }
+
+    // optional int32 height = 2;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_height());
+    }
+
+    // optional int32 width = 3;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_width());
+    }
+
+    // optional int32 label = 5;
+    if (cached_has_bits & 0x00000010u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_label());
+    }
+
+    // optional bool encoded = 7 [default = false];
+    if (cached_has_bits & 0x00000020u) {
+      total_size += 1 + 1;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Datum::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Datum::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Datum::GetClassData() const { return &_class_data_; }
+
+
+void Datum::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Datum*>(&to_msg);
+  auto& from = static_cast<const Datum&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:lu_net.Datum)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.float_data_.MergeFrom(from._impl_.float_data_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_data(from._internal_data());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.channels_ = from._impl_.channels_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.height_ = from._impl_.height_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.width_ = from._impl_.width_;
+    }
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.label_ = from._impl_.label_;
+    }
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.encoded_ = from._impl_.encoded_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void Datum::CopyFrom(const Datum& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:lu_net.Datum)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool Datum::IsInitialized() const {
+  return true;
+}
+
+void Datum::InternalSwap(Datum* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.float_data_.InternalSwap(&other->_impl_.float_data_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.data_, lhs_arena,
+      &other->_impl_.data_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Datum, _impl_.encoded_)
+      + sizeof(Datum::_impl_.encoded_)
+      - PROTOBUF_FIELD_OFFSET(Datum, _impl_.channels_)>(
+          reinterpret_cast<char*>(&_impl_.channels_),
+          reinterpret_cast<char*>(&other->_impl_.channels_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Datum::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_lu_2eproto_getter, &descriptor_table_lu_2eproto_once,
+      file_level_metadata_lu_2eproto[0]);
+}
+
+// ===================================================================
+
+class NetParameterMsg::_Internal {
+ public:
+};
+
+NetParameterMsg::NetParameterMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:lu_net.NetParameterMsg)
+}
+NetParameterMsg::NetParameterMsg(const NetParameterMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  NetParameterMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.layers_neuron_num_){from._impl_.layers_neuron_num_}
+    , /*decltype(_impl_._layers_neuron_num_cached_byte_size_)*/{0}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:lu_net.NetParameterMsg)
+}
+
+inline void NetParameterMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.layers_neuron_num_){arena}
+    , /*decltype(_impl_._layers_neuron_num_cached_byte_size_)*/{0}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+NetParameterMsg::~NetParameterMsg() {
+  // @@protoc_insertion_point(destructor:lu_net.NetParameterMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void NetParameterMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.layers_neuron_num_.~RepeatedField();
+}
+
+void NetParameterMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void NetParameterMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:lu_net.NetParameterMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.layers_neuron_num_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* NetParameterMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated int32 layers_neuron_num = 1 [packed = true];
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedInt32Parser(_internal_mutable_layers_neuron_num(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 8) {
+          _internal_add_layers_neuron_num(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* NetParameterMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:lu_net.NetParameterMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated int32 layers_neuron_num = 1 [packed = true];
+  {
+    int byte_size = _impl_._layers_neuron_num_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteInt32Packed(
+          1, _internal_layers_neuron_num(), byte_size, target);
+    }
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:lu_net.NetParameterMsg)
+  return target;
+}
+
+size_t NetParameterMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:lu_net.NetParameterMsg)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated int32 layers_neuron_num = 1 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      Int32Size(this->_impl_.layers_neuron_num_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._layers_neuron_num_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData NetParameterMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    NetParameterMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*NetParameterMsg::GetClassData() const { return &_class_data_; }
+
+
+void NetParameterMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<NetParameterMsg*>(&to_msg);
+  auto& from = static_cast<const NetParameterMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:lu_net.NetParameterMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.layers_neuron_num_.MergeFrom(from._impl_.layers_neuron_num_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void NetParameterMsg::CopyFrom(const NetParameterMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:lu_net.NetParameterMsg)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool NetParameterMsg::IsInitialized() const {
+  return true;
+}
+
+void NetParameterMsg::InternalSwap(NetParameterMsg* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.layers_neuron_num_.InternalSwap(&other->_impl_.layers_neuron_num_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata NetParameterMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_lu_2eproto_getter, &descriptor_table_lu_2eproto_once,
+      file_level_metadata_lu_2eproto[1]);
+}
+
+// ===================================================================
+
+class ModelMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<ModelMsg>()._impl_._has_bits_);
+  static void set_has_learning_rate(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static const ::lu_net::NetParameterMsg& net_param(const ModelMsg* msg);
+  static void set_has_net_param(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+};
+
+const ::lu_net::NetParameterMsg&
+ModelMsg::_Internal::net_param(const ModelMsg* msg) {
+  return *msg->_impl_.net_param_;
+}
+ModelMsg::ModelMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:lu_net.ModelMsg)
+}
+ModelMsg::ModelMsg(const ModelMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  ModelMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.net_param_){nullptr}
+    , decltype(_impl_.learning_rate_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  if (from._internal_has_net_param()) {
+    _this->_impl_.net_param_ = new ::lu_net::NetParameterMsg(*from._impl_.net_param_);
+  }
+  _this->_impl_.learning_rate_ = from._impl_.learning_rate_;
+  // @@protoc_insertion_point(copy_constructor:lu_net.ModelMsg)
+}
+
+inline void ModelMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.net_param_){nullptr}
+    , decltype(_impl_.learning_rate_){0}
+  };
+}
+
+ModelMsg::~ModelMsg() {
+  // @@protoc_insertion_point(destructor:lu_net.ModelMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void ModelMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  if (this != internal_default_instance()) delete _impl_.net_param_;
+}
+
+void ModelMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void ModelMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:lu_net.ModelMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    GOOGLE_DCHECK(_impl_.net_param_ != nullptr);
+    _impl_.net_param_->Clear();
+  }
+  _impl_.learning_rate_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* ModelMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional float learning_rate = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 13)) {
+          _Internal::set_has_learning_rate(&has_bits);
+          _impl_.learning_rate_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .lu_net.NetParameterMsg net_param = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_net_param(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* ModelMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:lu_net.ModelMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional float learning_rate = 1;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(1, this->_internal_learning_rate(), target);
+  }
+
+  // optional .lu_net.NetParameterMsg net_param = 2;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::net_param(this),
+        _Internal::net_param(this).GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:lu_net.ModelMsg)
+  return target;
+}
+
+size_t ModelMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:lu_net.ModelMsg)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional .lu_net.NetParameterMsg net_param = 2;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.net_param_);
+    }
+
+    // optional float learning_rate = 1;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 4;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData ModelMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    ModelMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*ModelMsg::GetClassData() const { return &_class_data_; }
+
+
+void ModelMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<ModelMsg*>(&to_msg);
+  auto& from = static_cast<const ModelMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:lu_net.ModelMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_net_param()->::lu_net::NetParameterMsg::MergeFrom(
+          from._internal_net_param());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.learning_rate_ = from._impl_.learning_rate_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void ModelMsg::CopyFrom(const ModelMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:lu_net.ModelMsg)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool ModelMsg::IsInitialized() const {
+  return true;
+}
+
+void ModelMsg::InternalSwap(ModelMsg* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(ModelMsg, _impl_.learning_rate_)
+      + sizeof(ModelMsg::_impl_.learning_rate_)
+      - PROTOBUF_FIELD_OFFSET(ModelMsg, _impl_.net_param_)>(
+          reinterpret_cast<char*>(&_impl_.net_param_),
+          reinterpret_cast<char*>(&other->_impl_.net_param_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata ModelMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_lu_2eproto_getter, &descriptor_table_lu_2eproto_once,
+      file_level_metadata_lu_2eproto[2]);
+}
+
+// ===================================================================
+
+class MatrixMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<MatrixMsg>()._impl_._has_bits_);
+  static void set_has_rows(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_cols(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
+
+MatrixMsg::MatrixMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:lu_net.MatrixMsg)
+}
+MatrixMsg::MatrixMsg(const MatrixMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  MatrixMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.data_){from._impl_.data_}
+    , decltype(_impl_.row_ptr_){from._impl_.row_ptr_}
+    , /*decltype(_impl_._row_ptr_cached_byte_size_)*/{0}
+    , decltype(_impl_.col_index_){from._impl_.col_index_}
+    , /*decltype(_impl_._col_index_cached_byte_size_)*/{0}
+    , decltype(_impl_.rows_){}
+    , decltype(_impl_.cols_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.rows_, &from._impl_.rows_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.cols_) -
+    reinterpret_cast<char*>(&_impl_.rows_)) + sizeof(_impl_.cols_));
+  // @@protoc_insertion_point(copy_constructor:lu_net.MatrixMsg)
+}
+
+inline void MatrixMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.data_){arena}
+    , decltype(_impl_.row_ptr_){arena}
+    , /*decltype(_impl_._row_ptr_cached_byte_size_)*/{0}
+    , decltype(_impl_.col_index_){arena}
+    , /*decltype(_impl_._col_index_cached_byte_size_)*/{0}
+    , decltype(_impl_.rows_){0u}
+    , decltype(_impl_.cols_){0u}
+  };
+}
+
+MatrixMsg::~MatrixMsg() {
+  // @@protoc_insertion_point(destructor:lu_net.MatrixMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void MatrixMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.data_.~RepeatedField();
+  _impl_.row_ptr_.~RepeatedField();
+  _impl_.col_index_.~RepeatedField();
+}
+
+void MatrixMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void MatrixMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:lu_net.MatrixMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.data_.Clear();
+  _impl_.row_ptr_.Clear();
+  _impl_.col_index_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.rows_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.cols_) -
+        reinterpret_cast<char*>(&_impl_.rows_)) + sizeof(_impl_.cols_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* MatrixMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required uint32 rows = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_rows(&has_bits);
+          _impl_.rows_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated float data = 2 [packed = true];
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedFloatParser(_internal_mutable_data(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 21) {
+          _internal_add_data(::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr));
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint32 cols = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_cols(&has_bits);
+          _impl_.cols_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated uint32 row_ptr = 4 [packed = true];
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 34)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt32Parser(_internal_mutable_row_ptr(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 32) {
+          _internal_add_row_ptr(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated uint32 col_index = 5 [packed = true];
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt32Parser(_internal_mutable_col_index(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 40) {
+          _internal_add_col_index(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* MatrixMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:lu_net.MatrixMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // required uint32 rows = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(1, this->_internal_rows(), target);
+  }
+
+  // repeated float data = 2 [packed = true];
+  if (this->_internal_data_size() > 0) {
+    target = stream->WriteFixedPacked(2, _internal_data(), target);
+  }
+
+  // optional uint32 cols = 3;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(3, this->_internal_cols(), target);
+  }
+
+  // repeated uint32 row_ptr = 4 [packed = true];
+  {
+    int byte_size = _impl_._row_ptr_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt32Packed(
+          4, _internal_row_ptr(), byte_size, target);
+    }
+  }
+
+  // repeated uint32 col_index = 5 [packed = true];
+  {
+    int byte_size = _impl_._col_index_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt32Packed(
+          5, _internal_col_index(), byte_size, target);
+    }
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:lu_net.MatrixMsg)
+  return target;
+}
+
+size_t MatrixMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:lu_net.MatrixMsg)
+  size_t total_size = 0;
+
+  // required uint32 rows = 1;
+  if (_internal_has_rows()) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_rows());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated float data = 2 [packed = true];
+  {
+    unsigned int count = static_cast<unsigned int>(this->_internal_data_size());
+    size_t data_size = 4UL * count;
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    total_size += data_size;
+  }
+
+  // repeated uint32 row_ptr = 4 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt32Size(this->_impl_.row_ptr_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._row_ptr_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  // repeated uint32 col_index = 5 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt32Size(this->_impl_.col_index_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._col_index_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  // optional uint32 cols = 3;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000002u) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_cols());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData MatrixMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    MatrixMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*MatrixMsg::GetClassData() const { return &_class_data_; }
+
+
+void MatrixMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<MatrixMsg*>(&to_msg);
+  auto& from = static_cast<const MatrixMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:lu_net.MatrixMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.data_.MergeFrom(from._impl_.data_);
+  _this->_impl_.row_ptr_.MergeFrom(from._impl_.row_ptr_);
+  _this->_impl_.col_index_.MergeFrom(from._impl_.col_index_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.rows_ = from._impl_.rows_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.cols_ = from._impl_.cols_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void MatrixMsg::CopyFrom(const MatrixMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:lu_net.MatrixMsg)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool MatrixMsg::IsInitialized() const {
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  return true;
+}
+
+void MatrixMsg::InternalSwap(MatrixMsg* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.data_.InternalSwap(&other->_impl_.data_);
+  _impl_.row_ptr_.InternalSwap(&other->_impl_.row_ptr_);
+  _impl_.col_index_.InternalSwap(&other->_impl_.col_index_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(MatrixMsg, _impl_.cols_)
+      + sizeof(MatrixMsg::_impl_.cols_)
+      - PROTOBUF_FIELD_OFFSET(MatrixMsg, _impl_.rows_)>(
+          reinterpret_cast<char*>(&_impl_.rows_),
+          reinterpret_cast<char*>(&other->_impl_.rows_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata MatrixMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_lu_2eproto_getter, &descriptor_table_lu_2eproto_once,
+      file_level_metadata_lu_2eproto[3]);
+}
+
+// ===================================================================
+
+class VectorMsg::_Internal {
+ public:
+};
+
+VectorMsg::VectorMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:lu_net.VectorMsg)
+}
+VectorMsg::VectorMsg(const VectorMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  VectorMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.data_){from._impl_.data_}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:lu_net.VectorMsg)
+}
+
+inline void VectorMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.data_){arena}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+VectorMsg::~VectorMsg() {
+  // @@protoc_insertion_point(destructor:lu_net.VectorMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void VectorMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.data_.~RepeatedField();
+}
+
+void VectorMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void VectorMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:lu_net.VectorMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.data_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* VectorMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated float data = 1 [packed = true];
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedFloatParser(_internal_mutable_data(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 13) {
+          _internal_add_data(::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr));
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* VectorMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:lu_net.VectorMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated float data = 1 [packed = true];
+  if (this->_internal_data_size() > 0) {
+    target = stream->WriteFixedPacked(1, _internal_data(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:lu_net.VectorMsg)
+  return target;
+}
+
+size_t VectorMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:lu_net.VectorMsg)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated float data = 1 [packed = true];
+  {
+    unsigned int count = static_cast<unsigned int>(this->_internal_data_size());
+    size_t data_size = 4UL * count;
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    total_size += data_size;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData VectorMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    VectorMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*VectorMsg::GetClassData() const { return &_class_data_; }
+
+
+void VectorMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<VectorMsg*>(&to_msg);
+  auto& from = static_cast<const VectorMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:lu_net.VectorMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.data_.MergeFrom(from._impl_.data_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void VectorMsg::CopyFrom(const VectorMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:lu_net.VectorMsg)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool VectorMsg::IsInitialized() const {
+  return true;
+}
+
+void VectorMsg::InternalSwap(VectorMsg* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.data_.InternalSwap(&other->_impl_.data_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata VectorMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_lu_2eproto_getter, &descriptor_table_lu_2eproto_once,
+      file_level_metadata_lu_2eproto[4]);
+}
+
+// ===================================================================
+
+class WeightsMsg::_Internal {
+ public:
+};
+
+WeightsMsg::WeightsMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:lu_net.WeightsMsg)
+}
+WeightsMsg::WeightsMsg(const WeightsMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  WeightsMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.weights_){from._impl_.weights_}
+    , decltype(_impl_.bias_){from._impl_.bias_}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:lu_net.WeightsMsg)
+}
+
+inline void WeightsMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.weights_){arena}
+    , decltype(_impl_.bias_){arena}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+WeightsMsg::~WeightsMsg() {
+  // @@protoc_insertion_point(destructor:lu_net.WeightsMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void WeightsMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.weights_.~RepeatedPtrField();
+  _impl_.bias_.~RepeatedPtrField();
+}
+
+void WeightsMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void WeightsMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:lu_net.WeightsMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.weights_.Clear();
+  _impl_.bias_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* WeightsMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated .lu_net.MatrixMsg weights = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_weights(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<18>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .lu_net.VectorMsg bias = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_bias(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<26>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* WeightsMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:lu_net.WeightsMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .lu_net.MatrixMsg weights = 2;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_weights_size()); i < n; i++) {
+    const auto& repfield = this->_internal_weights(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(2, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // repeated .lu_net.VectorMsg bias = 3;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_bias_size()); i < n; i++) {
+    const auto& repfield = this->_internal_bias(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(3, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:lu_net.WeightsMsg)
+  return target;
+}
+
+size_t WeightsMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:lu_net.WeightsMsg)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .lu_net.MatrixMsg weights = 2;
+  total_size += 1UL * this->_internal_weights_size();
+  for (const auto& msg : this->_impl_.weights_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // repeated .lu_net.VectorMsg bias = 3;
+  total_size += 1UL * this->_internal_bias_size();
+  for (const auto& msg : this->_impl_.bias_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData WeightsMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    WeightsMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*WeightsMsg::GetClassData() const { return &_class_data_; }
+
+
+void WeightsMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<WeightsMsg*>(&to_msg);
+  auto& from = static_cast<const WeightsMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:lu_net.WeightsMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.weights_.MergeFrom(from._impl_.weights_);
+  _this->_impl_.bias_.MergeFrom(from._impl_.bias_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void WeightsMsg::CopyFrom(const WeightsMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:lu_net.WeightsMsg)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool WeightsMsg::IsInitialized() const {
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.weights_))
+    return false;
+  return true;
+}
+
+void WeightsMsg::InternalSwap(WeightsMsg* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.weights_.InternalSwap(&other->_impl_.weights_);
+  _impl_.bias_.InternalSwap(&other->_impl_.bias_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata WeightsMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_lu_2eproto_getter, &descriptor_table_lu_2eproto_once,
+      file_level_metadata_lu_2eproto[5]);
+}
+
+// ===================================================================
+
+class ModelWeightsMsg::_Internal {
+ public:
+  using HasBits = decltype(std::declval<ModelWeightsMsg>()._impl_._has_bits_);
+  static const ::lu_net::ModelMsg& model(const ModelWeightsMsg* msg);
+  static void set_has_model(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static const ::lu_net::WeightsMsg& weights(const ModelWeightsMsg* msg);
+  static void set_has_weights(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+};
+
+const ::lu_net::ModelMsg&
+ModelWeightsMsg::_Internal::model(const ModelWeightsMsg* msg) {
+  return *msg->_impl_.model_;
+}
+const ::lu_net::WeightsMsg&
+ModelWeightsMsg::_Internal::weights(const ModelWeightsMsg* msg) {
+  return *msg->_impl_.weights_;
+}
+ModelWeightsMsg::ModelWeightsMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:lu_net.ModelWeightsMsg)
+}
+ModelWeightsMsg::ModelWeightsMsg(const ModelWeightsMsg& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  ModelWeightsMsg* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.model_){nullptr}
+    , decltype(_impl_.weights_){nullptr}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  if (from._internal_has_model()) {
+    _this->_impl_.model_ = new ::lu_net::ModelMsg(*from._impl_.model_);
+  }
+  if (from._internal_has_weights()) {
+    _this->_impl_.weights_ = new ::lu_net::WeightsMsg(*from._impl_.weights_);
+  }
+  // @@protoc_insertion_point(copy_constructor:lu_net.ModelWeightsMsg)
+}
+
+inline void ModelWeightsMsg::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.model_){nullptr}
+    , decltype(_impl_.weights_){nullptr}
+  };
+}
+
+ModelWeightsMsg::~ModelWeightsMsg() {
+  // @@protoc_insertion_point(destructor:lu_net.ModelWeightsMsg)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void ModelWeightsMsg::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  if (this != internal_default_instance()) delete _impl_.model_;
+  if (this != internal_default_instance()) delete _impl_.weights_;
+}
+
+void ModelWeightsMsg::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void ModelWeightsMsg::Clear() {
+// @@protoc_insertion_point(message_clear_start:lu_net.ModelWeightsMsg)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      GOOGLE_DCHECK(_impl_.model_ != nullptr);
+      _impl_.model_->Clear();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      GOOGLE_DCHECK(_impl_.weights_ != nullptr);
+      _impl_.weights_->Clear();
+    }
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* ModelWeightsMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional .lu_net.ModelMsg model = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ctx->ParseMessage(_internal_mutable_model(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional .lu_net.WeightsMsg weights = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ctx->ParseMessage(_internal_mutable_weights(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* ModelWeightsMsg::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:lu_net.ModelWeightsMsg)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional .lu_net.ModelMsg model = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, _Internal::model(this),
+        _Internal::model(this).GetCachedSize(), target, stream);
+  }
+
+  // optional .lu_net.WeightsMsg weights = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(2, _Internal::weights(this),
+        _Internal::weights(this).GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:lu_net.ModelWeightsMsg)
+  return target;
+}
+
+size_t ModelWeightsMsg::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:lu_net.ModelWeightsMsg)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional .lu_net.ModelMsg model = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.model_);
+    }
+
+    // optional .lu_net.WeightsMsg weights = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.weights_);
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData ModelWeightsMsg::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    ModelWeightsMsg::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*ModelWeightsMsg::GetClassData() const { return &_class_data_; }
+
+
+void ModelWeightsMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<ModelWeightsMsg*>(&to_msg);
+  auto& from = static_cast<const ModelWeightsMsg&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:lu_net.ModelWeightsMsg)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_mutable_model()->::lu_net::ModelMsg::MergeFrom(
+          from._internal_model());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_mutable_weights()->::lu_net::WeightsMsg::MergeFrom(
+          from._internal_weights());
+    }
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void ModelWeightsMsg::CopyFrom(const ModelWeightsMsg& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:lu_net.ModelWeightsMsg)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool ModelWeightsMsg::IsInitialized() const {
+  if (_internal_has_weights()) {
+    if (!_impl_.weights_->IsInitialized()) return false;
+  }
+  return true;
+}
+
+void ModelWeightsMsg::InternalSwap(ModelWeightsMsg* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(ModelWeightsMsg, _impl_.weights_)
+      + sizeof(ModelWeightsMsg::_impl_.weights_)
+      - PROTOBUF_FIELD_OFFSET(ModelWeightsMsg, _impl_.model_)>(
+          reinterpret_cast<char*>(&_impl_.model_),
+          reinterpret_cast<char*>(&other->_impl_.model_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata ModelWeightsMsg::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_lu_2eproto_getter, &descriptor_table_lu_2eproto_once,
+      file_level_metadata_lu_2eproto[6]);
+}
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace lu_net
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::lu_net::Datum*
+Arena::CreateMaybeMessage< ::lu_net::Datum >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::lu_net::Datum >(arena);
+}
+template<> PROTOBUF_NOINLINE ::lu_net::NetParameterMsg*
+Arena::CreateMaybeMessage< ::lu_net::NetParameterMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::lu_net::NetParameterMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::lu_net::ModelMsg*
+Arena::CreateMaybeMessage< ::lu_net::ModelMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::lu_net::ModelMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::lu_net::MatrixMsg*
+Arena::CreateMaybeMessage< ::lu_net::MatrixMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::lu_net::MatrixMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::lu_net::VectorMsg*
+Arena::CreateMaybeMessage< ::lu_net::VectorMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::lu_net::VectorMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::lu_net::WeightsMsg*
+Arena::CreateMaybeMessage< ::lu_net::WeightsMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::lu_net::WeightsMsg >(arena);
+}
+template<> PROTOBUF_NOINLINE ::lu_net::ModelWeightsMsg*
+Arena::CreateMaybeMessage< ::lu_net::ModelWeightsMsg >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::lu_net::ModelWeightsMsg >(arena);
+}
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
@@ -1,706 +1,1797 @@
 // Generated by the protocol buffer compiler.  DO NOT EDIT!
 // source: lu.proto
 
-#ifndef PROTOBUF_lu_2eproto__INCLUDED
-#define PROTOBUF_lu_2eproto__INCLUDED
+#ifndef GOOGLE_PROTOBUF_INCLUDED_lu_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_lu_2eproto
 
+#include <limits>
 #include <string>
 
-#include <google/protobuf/stubs/common.h>
-
-#if GOOGLE_PROTOBUF_VERSION < 3000000
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
 #error This file was generated by a newer version of protoc which is
-#error incompatible with your Protocol Buffer headers.  Please update
+#error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 3000000 < GOOGLE_PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
-#error incompatible with your Protocol Buffer headers.  Please
+#error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
 #endif
 
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/arena.h>
 #include <google/protobuf/arenastring.h>
 #include <google/protobuf/generated_message_util.h>
-#include <google/protobuf/metadata.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
 #include <google/protobuf/message.h>
-#include <google/protobuf/repeated_field.h>
-#include <google/protobuf/extension_set.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
 #include <google/protobuf/unknown_field_set.h>
 // @@protoc_insertion_point(includes)
-
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_lu_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct TableStruct_lu_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_lu_2eproto;
 namespace lu_net {
-
-// Internal implementation detail -- do not call these.
-void protobuf_AddDesc_lu_2eproto();
-void protobuf_AssignDesc_lu_2eproto();
-void protobuf_ShutdownFile_lu_2eproto();
-
+class Datum;
+struct DatumDefaultTypeInternal;
+extern DatumDefaultTypeInternal _Datum_default_instance_;
 class MatrixMsg;
+struct MatrixMsgDefaultTypeInternal;
+extern MatrixMsgDefaultTypeInternal _MatrixMsg_default_instance_;
 class ModelMsg;
+struct ModelMsgDefaultTypeInternal;
+extern ModelMsgDefaultTypeInternal _ModelMsg_default_instance_;
 class ModelWeightsMsg;
+struct ModelWeightsMsgDefaultTypeInternal;
+extern ModelWeightsMsgDefaultTypeInternal _ModelWeightsMsg_default_instance_;
 class NetParameterMsg;
+struct NetParameterMsgDefaultTypeInternal;
+extern NetParameterMsgDefaultTypeInternal _NetParameterMsg_default_instance_;
 class VectorMsg;
+struct VectorMsgDefaultTypeInternal;
+extern VectorMsgDefaultTypeInternal _VectorMsg_default_instance_;
 class WeightsMsg;
+struct WeightsMsgDefaultTypeInternal;
+extern WeightsMsgDefaultTypeInternal _WeightsMsg_default_instance_;
+}  // namespace lu_net
+PROTOBUF_NAMESPACE_OPEN
+template<> ::lu_net::Datum* Arena::CreateMaybeMessage<::lu_net::Datum>(Arena*);
+template<> ::lu_net::MatrixMsg* Arena::CreateMaybeMessage<::lu_net::MatrixMsg>(Arena*);
+template<> ::lu_net::ModelMsg* Arena::CreateMaybeMessage<::lu_net::ModelMsg>(Arena*);
+template<> ::lu_net::ModelWeightsMsg* Arena::CreateMaybeMessage<::lu_net::ModelWeightsMsg>(Arena*);
+template<> ::lu_net::NetParameterMsg* Arena::CreateMaybeMessage<::lu_net::NetParameterMsg>(Arena*);
+template<> ::lu_net::VectorMsg* Arena::CreateMaybeMessage<::lu_net::VectorMsg>(Arena*);
+template<> ::lu_net::WeightsMsg* Arena::CreateMaybeMessage<::lu_net::WeightsMsg>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+namespace lu_net {
 
 // ===================================================================
 
-class NetParameterMsg : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:lu_net.NetParameterMsg) */ {
+class Datum final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:lu_net.Datum) */ {
+ public:
+  inline Datum() : Datum(nullptr) {}
+  ~Datum() override;
+  explicit PROTOBUF_CONSTEXPR Datum(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Datum(const Datum& from);
+  Datum(Datum&& from) noexcept
+    : Datum() {
+    *this = ::std::move(from);
+  }
+
+  inline Datum& operator=(const Datum& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Datum& operator=(Datum&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Datum& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Datum* internal_default_instance() {
+    return reinterpret_cast<const Datum*>(
+               &_Datum_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(Datum& a, Datum& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Datum* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Datum* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Datum* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Datum>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Datum& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Datum& from) {
+    Datum::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Datum* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "lu_net.Datum";
+  }
+  protected:
+  explicit Datum(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kFloatDataFieldNumber = 6,
+    kDataFieldNumber = 4,
+    kChannelsFieldNumber = 1,
+    kHeightFieldNumber = 2,
+    kWidthFieldNumber = 3,
+    kLabelFieldNumber = 5,
+    kEncodedFieldNumber = 7,
+  };
+  // repeated float float_data = 6;
+  int float_data_size() const;
+  private:
+  int _internal_float_data_size() const;
+  public:
+  void clear_float_data();
+  private:
+  float _internal_float_data(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+      _internal_float_data() const;
+  void _internal_add_float_data(float value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+      _internal_mutable_float_data();
+  public:
+  float float_data(int index) const;
+  void set_float_data(int index, float value);
+  void add_float_data(float value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+      float_data() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+      mutable_float_data();
+
+  // optional bytes data = 4;
+  bool has_data() const;
+  private:
+  bool _internal_has_data() const;
+  public:
+  void clear_data();
+  const std::string& data() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_data(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_data();
+  PROTOBUF_NODISCARD std::string* release_data();
+  void set_allocated_data(std::string* data);
+  private:
+  const std::string& _internal_data() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_data(const std::string& value);
+  std::string* _internal_mutable_data();
+  public:
+
+  // optional int32 channels = 1;
+  bool has_channels() const;
+  private:
+  bool _internal_has_channels() const;
+  public:
+  void clear_channels();
+  int32_t channels() const;
+  void set_channels(int32_t value);
+  private:
+  int32_t _internal_channels() const;
+  void _internal_set_channels(int32_t value);
+  public:
+
+  // optional int32 height = 2;
+  bool has_height() const;
+  private:
+  bool _internal_has_height() const;
+  public:
+  void clear_height();
+  int32_t height() const;
+  void set_height(int32_t value);
+  private:
+  int32_t _internal_height() const;
+  void _internal_set_height(int32_t value);
+  public:
+
+  // optional int32 width = 3;
+  bool has_width() const;
+  private:
+  bool _internal_has_width() const;
+  public:
+  void clear_width();
+  int32_t width() const;
+  void set_width(int32_t value);
+  private:
+  int32_t _internal_width() const;
+  void _internal_set_width(int32_t value);
+  public:
+
+  // optional int32 label = 5;
+  bool has_label() const;
+  private:
+  bool _internal_has_label() const;
+  public:
+  void clear_label();
+  int32_t label() const;
+  void set_label(int32_t value);
+  private:
+  int32_t _internal_label() const;
+  void _internal_set_label(int32_t value);
+  public:
+
+  // optional bool encoded = 7 [default = false];
+  bool has_encoded() const;
+  private:
+  bool _internal_has_encoded() const;
+  public:
+  void clear_encoded();
+  bool encoded() const;
+  void set_encoded(bool value);
+  private:
+  bool _internal_encoded() const;
+  void _internal_set_encoded(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:lu_net.Datum)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< float > float_data_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr data_;
+    int32_t channels_;
+    int32_t height_;
+    int32_t width_;
+    int32_t label_;
+    bool encoded_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_lu_2eproto;
+};
+// -------------------------------------------------------------------
+
+class NetParameterMsg final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:lu_net.NetParameterMsg) */ {
  public:
-  NetParameterMsg();
-  virtual ~NetParameterMsg();
+  inline NetParameterMsg() : NetParameterMsg(nullptr) {}
+  ~NetParameterMsg() override;
+  explicit PROTOBUF_CONSTEXPR NetParameterMsg(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   NetParameterMsg(const NetParameterMsg& from);
+  NetParameterMsg(NetParameterMsg&& from) noexcept
+    : NetParameterMsg() {
+    *this = ::std::move(from);
+  }
 
   inline NetParameterMsg& operator=(const NetParameterMsg& from) {
     CopyFrom(from);
     return *this;
   }
-
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _internal_metadata_.unknown_fields();
+  inline NetParameterMsg& operator=(NetParameterMsg&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
   }
 
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return _internal_metadata_.mutable_unknown_fields();
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
   }
 
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const NetParameterMsg& default_instance();
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const NetParameterMsg& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const NetParameterMsg* internal_default_instance() {
+    return reinterpret_cast<const NetParameterMsg*>(
+               &_NetParameterMsg_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
 
-  void Swap(NetParameterMsg* other);
+  friend void swap(NetParameterMsg& a, NetParameterMsg& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(NetParameterMsg* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(NetParameterMsg* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
 
   // implements Message ----------------------------------------------
 
-  inline NetParameterMsg* New() const { return New(NULL); }
-
-  NetParameterMsg* New(::google::protobuf::Arena* arena) const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+  NetParameterMsg* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<NetParameterMsg>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const NetParameterMsg& from);
-  void MergeFrom(const NetParameterMsg& from);
-  void Clear();
-  bool IsInitialized() const;
-
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
-      bool deterministic, ::google::protobuf::uint8* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
-    return InternalSerializeWithCachedSizesToArray(false, output);
-  }
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const NetParameterMsg& from) {
+    NetParameterMsg::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
   void InternalSwap(NetParameterMsg* other);
+
   private:
-  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
-    return _internal_metadata_.arena();
-  }
-  inline void* MaybeArenaPtr() const {
-    return _internal_metadata_.raw_arena_ptr();
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "lu_net.NetParameterMsg";
   }
+  protected:
+  explicit NetParameterMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::google::protobuf::Metadata GetMetadata() const;
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
   // accessors -------------------------------------------------------
 
+  enum : int {
+    kLayersNeuronNumFieldNumber = 1,
+  };
   // repeated int32 layers_neuron_num = 1 [packed = true];
   int layers_neuron_num_size() const;
+  private:
+  int _internal_layers_neuron_num_size() const;
+  public:
   void clear_layers_neuron_num();
-  static const int kLayersNeuronNumFieldNumber = 1;
-  ::google::protobuf::int32 layers_neuron_num(int index) const;
-  void set_layers_neuron_num(int index, ::google::protobuf::int32 value);
-  void add_layers_neuron_num(::google::protobuf::int32 value);
-  const ::google::protobuf::RepeatedField< ::google::protobuf::int32 >&
+  private:
+  int32_t _internal_layers_neuron_num(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+      _internal_layers_neuron_num() const;
+  void _internal_add_layers_neuron_num(int32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+      _internal_mutable_layers_neuron_num();
+  public:
+  int32_t layers_neuron_num(int index) const;
+  void set_layers_neuron_num(int index, int32_t value);
+  void add_layers_neuron_num(int32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
       layers_neuron_num() const;
-  ::google::protobuf::RepeatedField< ::google::protobuf::int32 >*
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
       mutable_layers_neuron_num();
 
   // @@protoc_insertion_point(class_scope:lu_net.NetParameterMsg)
  private:
-
-  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
-  ::google::protobuf::uint32 _has_bits_[1];
-  mutable int _cached_size_;
-  ::google::protobuf::RepeatedField< ::google::protobuf::int32 > layers_neuron_num_;
-  mutable int _layers_neuron_num_cached_byte_size_;
-  friend void  protobuf_AddDesc_lu_2eproto();
-  friend void protobuf_AssignDesc_lu_2eproto();
-  friend void protobuf_ShutdownFile_lu_2eproto();
-
-  void InitAsDefaultInstance();
-  static NetParameterMsg* default_instance_;
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t > layers_neuron_num_;
+    mutable std::atomic<int> _layers_neuron_num_cached_byte_size_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_lu_2eproto;
 };
 // -------------------------------------------------------------------
 
-class ModelMsg : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:lu_net.ModelMsg) */ {
+class ModelMsg final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:lu_net.ModelMsg) */ {
  public:
-  ModelMsg();
-  virtual ~ModelMsg();
+  inline ModelMsg() : ModelMsg(nullptr) {}
+  ~ModelMsg() override;
+  explicit PROTOBUF_CONSTEXPR ModelMsg(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   ModelMsg(const ModelMsg& from);
+  ModelMsg(ModelMsg&& from) noexcept
+    : ModelMsg() {
+    *this = ::std::move(from);
+  }
 
   inline ModelMsg& operator=(const ModelMsg& from) {
     CopyFrom(from);
     return *this;
   }
-
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _internal_metadata_.unknown_fields();
+  inline ModelMsg& operator=(ModelMsg&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
   }
 
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return _internal_metadata_.mutable_unknown_fields();
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
   }
 
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const ModelMsg& default_instance();
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ModelMsg& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ModelMsg* internal_default_instance() {
+    return reinterpret_cast<const ModelMsg*>(
+               &_ModelMsg_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
 
-  void Swap(ModelMsg* other);
+  friend void swap(ModelMsg& a, ModelMsg& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ModelMsg* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ModelMsg* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
 
   // implements Message ----------------------------------------------
 
-  inline ModelMsg* New() const { return New(NULL); }
-
-  ModelMsg* New(::google::protobuf::Arena* arena) const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+  ModelMsg* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ModelMsg>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const ModelMsg& from);
-  void MergeFrom(const ModelMsg& from);
-  void Clear();
-  bool IsInitialized() const;
-
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
-      bool deterministic, ::google::protobuf::uint8* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
-    return InternalSerializeWithCachedSizesToArray(false, output);
-  }
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ModelMsg& from) {
+    ModelMsg::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
   void InternalSwap(ModelMsg* other);
+
   private:
-  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
-    return _internal_metadata_.arena();
-  }
-  inline void* MaybeArenaPtr() const {
-    return _internal_metadata_.raw_arena_ptr();
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "lu_net.ModelMsg";
   }
+  protected:
+  explicit ModelMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::google::protobuf::Metadata GetMetadata() const;
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
   // accessors -------------------------------------------------------
 
-  // optional float learning_rate = 1;
-  bool has_learning_rate() const;
-  void clear_learning_rate();
-  static const int kLearningRateFieldNumber = 1;
-  float learning_rate() const;
-  void set_learning_rate(float value);
-
+  enum : int {
+    kNetParamFieldNumber = 2,
+    kLearningRateFieldNumber = 1,
+  };
   // optional .lu_net.NetParameterMsg net_param = 2;
   bool has_net_param() const;
+  private:
+  bool _internal_has_net_param() const;
+  public:
   void clear_net_param();
-  static const int kNetParamFieldNumber = 2;
   const ::lu_net::NetParameterMsg& net_param() const;
+  PROTOBUF_NODISCARD ::lu_net::NetParameterMsg* release_net_param();
   ::lu_net::NetParameterMsg* mutable_net_param();
-  ::lu_net::NetParameterMsg* release_net_param();
   void set_allocated_net_param(::lu_net::NetParameterMsg* net_param);
+  private:
+  const ::lu_net::NetParameterMsg& _internal_net_param() const;
+  ::lu_net::NetParameterMsg* _internal_mutable_net_param();
+  public:
+  void unsafe_arena_set_allocated_net_param(
+      ::lu_net::NetParameterMsg* net_param);
+  ::lu_net::NetParameterMsg* unsafe_arena_release_net_param();
+
+  // optional float learning_rate = 1;
+  bool has_learning_rate() const;
+  private:
+  bool _internal_has_learning_rate() const;
+  public:
+  void clear_learning_rate();
+  float learning_rate() const;
+  void set_learning_rate(float value);
+  private:
+  float _internal_learning_rate() const;
+  void _internal_set_learning_rate(float value);
+  public:
 
   // @@protoc_insertion_point(class_scope:lu_net.ModelMsg)
  private:
-  inline void set_has_learning_rate();
-  inline void clear_has_learning_rate();
-  inline void set_has_net_param();
-  inline void clear_has_net_param();
-
-  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
-  ::google::protobuf::uint32 _has_bits_[1];
-  mutable int _cached_size_;
-  ::lu_net::NetParameterMsg* net_param_;
-  float learning_rate_;
-  friend void  protobuf_AddDesc_lu_2eproto();
-  friend void protobuf_AssignDesc_lu_2eproto();
-  friend void protobuf_ShutdownFile_lu_2eproto();
-
-  void InitAsDefaultInstance();
-  static ModelMsg* default_instance_;
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::lu_net::NetParameterMsg* net_param_;
+    float learning_rate_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_lu_2eproto;
 };
 // -------------------------------------------------------------------
 
-class MatrixMsg : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:lu_net.MatrixMsg) */ {
+class MatrixMsg final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:lu_net.MatrixMsg) */ {
  public:
-  MatrixMsg();
-  virtual ~MatrixMsg();
+  inline MatrixMsg() : MatrixMsg(nullptr) {}
+  ~MatrixMsg() override;
+  explicit PROTOBUF_CONSTEXPR MatrixMsg(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   MatrixMsg(const MatrixMsg& from);
+  MatrixMsg(MatrixMsg&& from) noexcept
+    : MatrixMsg() {
+    *this = ::std::move(from);
+  }
 
   inline MatrixMsg& operator=(const MatrixMsg& from) {
     CopyFrom(from);
     return *this;
   }
-
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _internal_metadata_.unknown_fields();
+  inline MatrixMsg& operator=(MatrixMsg&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
   }
 
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return _internal_metadata_.mutable_unknown_fields();
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
   }
 
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const MatrixMsg& default_instance();
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const MatrixMsg& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const MatrixMsg* internal_default_instance() {
+    return reinterpret_cast<const MatrixMsg*>(
+               &_MatrixMsg_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    3;
 
-  void Swap(MatrixMsg* other);
+  friend void swap(MatrixMsg& a, MatrixMsg& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(MatrixMsg* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(MatrixMsg* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
 
   // implements Message ----------------------------------------------
 
-  inline MatrixMsg* New() const { return New(NULL); }
-
-  MatrixMsg* New(::google::protobuf::Arena* arena) const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+  MatrixMsg* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<MatrixMsg>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const MatrixMsg& from);
-  void MergeFrom(const MatrixMsg& from);
-  void Clear();
-  bool IsInitialized() const;
-
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
-      bool deterministic, ::google::protobuf::uint8* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
-    return InternalSerializeWithCachedSizesToArray(false, output);
-  }
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const MatrixMsg& from) {
+    MatrixMsg::MergeImpl(*this, from);
+  }
   private:
-  void SharedCtor();
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
   void InternalSwap(MatrixMsg* other);
+
   private:
-  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
-    return _internal_metadata_.arena();
-  }
-  inline void* MaybeArenaPtr() const {
-    return _internal_metadata_.raw_arena_ptr();
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "lu_net.MatrixMsg";
   }
+  protected:
+  explicit MatrixMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::google::protobuf::Metadata GetMetadata() const;
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
   // accessors -------------------------------------------------------
 
-  // required uint32 rows = 1;
-  bool has_rows() const;
-  void clear_rows();
-  static const int kRowsFieldNumber = 1;
-  ::google::protobuf::uint32 rows() const;
-  void set_rows(::google::protobuf::uint32 value);
-
+  enum : int {
+    kDataFieldNumber = 2,
+    kRowPtrFieldNumber = 4,
+    kColIndexFieldNumber = 5,
+    kRowsFieldNumber = 1,
+    kColsFieldNumber = 3,
+  };
   // repeated float data = 2 [packed = true];
   int data_size() const;
+  private:
+  int _internal_data_size() const;
+  public:
   void clear_data();
-  static const int kDataFieldNumber = 2;
+  private:
+  float _internal_data(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+      _internal_data() const;
+  void _internal_add_data(float value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+      _internal_mutable_data();
+  public:
   float data(int index) const;
   void set_data(int index, float value);
   void add_data(float value);
-  const ::google::protobuf::RepeatedField< float >&
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
       data() const;
-  ::google::protobuf::RepeatedField< float >*
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
       mutable_data();
 
+  // repeated uint32 row_ptr = 4 [packed = true];
+  int row_ptr_size() const;
+  private:
+  int _internal_row_ptr_size() const;
+  public:
+  void clear_row_ptr();
+  private:
+  uint32_t _internal_row_ptr(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_row_ptr() const;
+  void _internal_add_row_ptr(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_row_ptr();
+  public:
+  uint32_t row_ptr(int index) const;
+  void set_row_ptr(int index, uint32_t value);
+  void add_row_ptr(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      row_ptr() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_row_ptr();
+
+  // repeated uint32 col_index = 5 [packed = true];
+  int col_index_size() const;
+  private:
+  int _internal_col_index_size() const;
+  public:
+  void clear_col_index();
+  private:
+  uint32_t _internal_col_index(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_col_index() const;
+  void _internal_add_col_index(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_col_index();
+  public:
+  uint32_t col_index(int index) const;
+  void set_col_index(int index, uint32_t value);
+  void add_col_index(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      col_index() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_col_index();
+
+  // required uint32 rows = 1;
+  bool has_rows() const;
+  private:
+  bool _internal_has_rows() const;
+  public:
+  void clear_rows();
+  uint32_t rows() const;
+  void set_rows(uint32_t value);
+  private:
+  uint32_t _internal_rows() const;
+  void _internal_set_rows(uint32_t value);
+  public:
+
+  // optional uint32 cols = 3;
+  bool has_cols() const;
+  private:
+  bool _internal_has_cols() const;
+  public:
+  void clear_cols();
+  uint32_t cols() const;
+  void set_cols(uint32_t value);
+  private:
+  uint32_t _internal_cols() const;
+  void _internal_set_cols(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:lu_net.MatrixMsg)
  private:
-  inline void set_has_rows();
-  inline void clear_has_rows();
-
-  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
-  ::google::protobuf::uint32 _has_bits_[1];
-  mutable int _cached_size_;
-  ::google::protobuf::RepeatedField< float > data_;
-  mutable int _data_cached_byte_size_;
-  ::google::protobuf::uint32 rows_;
-  friend void  protobuf_AddDesc_lu_2eproto();
-  friend void protobuf_AssignDesc_lu_2eproto();
-  friend void protobuf_ShutdownFile_lu_2eproto();
-
-  void InitAsDefaultInstance();
-  static MatrixMsg* default_instance_;
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< float > data_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > row_ptr_;
+    mutable std::atomic<int> _row_ptr_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > col_index_;
+    mutable std::atomic<int> _col_index_cached_byte_size_;
+    uint32_t rows_;
+    uint32_t cols_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_lu_2eproto;
 };
 // -------------------------------------------------------------------
 
-class VectorMsg : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:lu_net.VectorMsg) */ {
+class VectorMsg final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:lu_net.VectorMsg) */ {
  public:
-  VectorMsg();
-  virtual ~VectorMsg();
+  inline VectorMsg() : VectorMsg(nullptr) {}
+  ~VectorMsg() override;
+  explicit PROTOBUF_CONSTEXPR VectorMsg(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   VectorMsg(const VectorMsg& from);
+  VectorMsg(VectorMsg&& from) noexcept
+    : VectorMsg() {
+    *this = ::std::move(from);
+  }
 
   inline VectorMsg& operator=(const VectorMsg& from) {
     CopyFrom(from);
     return *this;
   }
-
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _internal_metadata_.unknown_fields();
+  inline VectorMsg& operator=(VectorMsg&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
   }
 
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return _internal_metadata_.mutable_unknown_fields();
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
   }
 
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const VectorMsg& default_instance();
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const VectorMsg& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const VectorMsg* internal_default_instance() {
+    return reinterpret_cast<const VectorMsg*>(
+               &_VectorMsg_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    4;
 
-  void Swap(VectorMsg* other);
+  friend void swap(VectorMsg& a, VectorMsg& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(VectorMsg* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(VectorMsg* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
 
   // implements Message ----------------------------------------------
 
-  inline VectorMsg* New() const { return New(NULL); }
-
-  VectorMsg* New(::google::protobuf::Arena* arena) const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+  VectorMsg* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<VectorMsg>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const VectorMsg& from);
-  void MergeFrom(const VectorMsg& from);
-  void Clear();
-  bool IsInitialized() const;
-
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
-      bool deterministic, ::google::protobuf::uint8* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
-    return InternalSerializeWithCachedSizesToArray(false, output);
-  }
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const VectorMsg& from) {
+    VectorMsg::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
   void InternalSwap(VectorMsg* other);
+
   private:
-  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
-    return _internal_metadata_.arena();
-  }
-  inline void* MaybeArenaPtr() const {
-    return _internal_metadata_.raw_arena_ptr();
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "lu_net.VectorMsg";
   }
+  protected:
+  explicit VectorMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::google::protobuf::Metadata GetMetadata() const;
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
   // accessors -------------------------------------------------------
 
+  enum : int {
+    kDataFieldNumber = 1,
+  };
   // repeated float data = 1 [packed = true];
   int data_size() const;
+  private:
+  int _internal_data_size() const;
+  public:
   void clear_data();
-  static const int kDataFieldNumber = 1;
+  private:
+  float _internal_data(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+      _internal_data() const;
+  void _internal_add_data(float value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+      _internal_mutable_data();
+  public:
   float data(int index) const;
   void set_data(int index, float value);
   void add_data(float value);
-  const ::google::protobuf::RepeatedField< float >&
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
       data() const;
-  ::google::protobuf::RepeatedField< float >*
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
       mutable_data();
 
   // @@protoc_insertion_point(class_scope:lu_net.VectorMsg)
  private:
-
-  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
-  ::google::protobuf::uint32 _has_bits_[1];
-  mutable int _cached_size_;
-  ::google::protobuf::RepeatedField< float > data_;
-  mutable int _data_cached_byte_size_;
-  friend void  protobuf_AddDesc_lu_2eproto();
-  friend void protobuf_AssignDesc_lu_2eproto();
-  friend void protobuf_ShutdownFile_lu_2eproto();
-
-  void InitAsDefaultInstance();
-  static VectorMsg* default_instance_;
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< float > data_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_lu_2eproto;
 };
 // -------------------------------------------------------------------
 
-class WeightsMsg : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:lu_net.WeightsMsg) */ {
+class WeightsMsg final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:lu_net.WeightsMsg) */ {
  public:
-  WeightsMsg();
-  virtual ~WeightsMsg();
+  inline WeightsMsg() : WeightsMsg(nullptr) {}
+  ~WeightsMsg() override;
+  explicit PROTOBUF_CONSTEXPR WeightsMsg(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   WeightsMsg(const WeightsMsg& from);
+  WeightsMsg(WeightsMsg&& from) noexcept
+    : WeightsMsg() {
+    *this = ::std::move(from);
+  }
 
   inline WeightsMsg& operator=(const WeightsMsg& from) {
     CopyFrom(from);
     return *this;
   }
-
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _internal_metadata_.unknown_fields();
+  inline WeightsMsg& operator=(WeightsMsg&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
   }
 
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return _internal_metadata_.mutable_unknown_fields();
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
   }
 
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const WeightsMsg& default_instance();
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const WeightsMsg& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const WeightsMsg* internal_default_instance() {
+    return reinterpret_cast<const WeightsMsg*>(
+               &_WeightsMsg_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    5;
 
-  void Swap(WeightsMsg* other);
+  friend void swap(WeightsMsg& a, WeightsMsg& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(WeightsMsg* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(WeightsMsg* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
 
   // implements Message ----------------------------------------------
 
-  inline WeightsMsg* New() const { return New(NULL); }
-
-  WeightsMsg* New(::google::protobuf::Arena* arena) const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+  WeightsMsg* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<WeightsMsg>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const WeightsMsg& from);
-  void MergeFrom(const WeightsMsg& from);
-  void Clear();
-  bool IsInitialized() const;
-
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
-      bool deterministic, ::google::protobuf::uint8* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
-    return InternalSerializeWithCachedSizesToArray(false, output);
-  }
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const WeightsMsg& from) {
+    WeightsMsg::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
   void InternalSwap(WeightsMsg* other);
+
   private:
-  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
-    return _internal_metadata_.arena();
-  }
-  inline void* MaybeArenaPtr() const {
-    return _internal_metadata_.raw_arena_ptr();
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "lu_net.WeightsMsg";
   }
+  protected:
+  explicit WeightsMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::google::protobuf::Metadata GetMetadata() const;
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
   // accessors -------------------------------------------------------
 
+  enum : int {
+    kWeightsFieldNumber = 2,
+    kBiasFieldNumber = 3,
+  };
   // repeated .lu_net.MatrixMsg weights = 2;
   int weights_size() const;
+  private:
+  int _internal_weights_size() const;
+  public:
   void clear_weights();
-  static const int kWeightsFieldNumber = 2;
+  ::lu_net::MatrixMsg* mutable_weights(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::MatrixMsg >*
+      mutable_weights();
+  private:
+  const ::lu_net::MatrixMsg& _internal_weights(int index) const;
+  ::lu_net::MatrixMsg* _internal_add_weights();
+  public:
   const ::lu_net::MatrixMsg& weights(int index) const;
-  ::lu_net::MatrixMsg* mutable_weights(int index);
   ::lu_net::MatrixMsg* add_weights();
-  ::google::protobuf::RepeatedPtrField< ::lu_net::MatrixMsg >*
-      mutable_weights();
-  const ::google::protobuf::RepeatedPtrField< ::lu_net::MatrixMsg >&
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::MatrixMsg >&
       weights() const;
 
   // repeated .lu_net.VectorMsg bias = 3;
   int bias_size() const;
+  private:
+  int _internal_bias_size() const;
+  public:
   void clear_bias();
-  static const int kBiasFieldNumber = 3;
-  const ::lu_net::VectorMsg& bias(int index) const;
   ::lu_net::VectorMsg* mutable_bias(int index);
-  ::lu_net::VectorMsg* add_bias();
-  ::google::protobuf::RepeatedPtrField< ::lu_net::VectorMsg >*
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::VectorMsg >*
       mutable_bias();
-  const ::google::protobuf::RepeatedPtrField< ::lu_net::VectorMsg >&
+  private:
+  const ::lu_net::VectorMsg& _internal_bias(int index) const;
+  ::lu_net::VectorMsg* _internal_add_bias();
+  public:
+  const ::lu_net::VectorMsg& bias(int index) const;
+  ::lu_net::VectorMsg* add_bias();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::VectorMsg >&
       bias() const;
 
   // @@protoc_insertion_point(class_scope:lu_net.WeightsMsg)
  private:
-
-  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
-  ::google::protobuf::uint32 _has_bits_[1];
-  mutable int _cached_size_;
-  ::google::protobuf::RepeatedPtrField< ::lu_net::MatrixMsg > weights_;
-  ::google::protobuf::RepeatedPtrField< ::lu_net::VectorMsg > bias_;
-  friend void  protobuf_AddDesc_lu_2eproto();
-  friend void protobuf_AssignDesc_lu_2eproto();
-  friend void protobuf_ShutdownFile_lu_2eproto();
-
-  void InitAsDefaultInstance();
-  static WeightsMsg* default_instance_;
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::MatrixMsg > weights_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::VectorMsg > bias_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_lu_2eproto;
 };
 // -------------------------------------------------------------------
 
-class ModelWeightsMsg : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:lu_net.ModelWeightsMsg) */ {
+class ModelWeightsMsg final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:lu_net.ModelWeightsMsg) */ {
  public:
-  ModelWeightsMsg();
-  virtual ~ModelWeightsMsg();
+  inline ModelWeightsMsg() : ModelWeightsMsg(nullptr) {}
+  ~ModelWeightsMsg() override;
+  explicit PROTOBUF_CONSTEXPR ModelWeightsMsg(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   ModelWeightsMsg(const ModelWeightsMsg& from);
+  ModelWeightsMsg(ModelWeightsMsg&& from) noexcept
+    : ModelWeightsMsg() {
+    *this = ::std::move(from);
+  }
 
   inline ModelWeightsMsg& operator=(const ModelWeightsMsg& from) {
     CopyFrom(from);
     return *this;
   }
-
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _internal_metadata_.unknown_fields();
+  inline ModelWeightsMsg& operator=(ModelWeightsMsg&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
   }
 
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return _internal_metadata_.mutable_unknown_fields();
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
   }
 
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const ModelWeightsMsg& default_instance();
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ModelWeightsMsg& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ModelWeightsMsg* internal_default_instance() {
+    return reinterpret_cast<const ModelWeightsMsg*>(
+               &_ModelWeightsMsg_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    6;
 
-  void Swap(ModelWeightsMsg* other);
+  friend void swap(ModelWeightsMsg& a, ModelWeightsMsg& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ModelWeightsMsg* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ModelWeightsMsg* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
 
   // implements Message ----------------------------------------------
 
-  inline ModelWeightsMsg* New() const { return New(NULL); }
-
-  ModelWeightsMsg* New(::google::protobuf::Arena* arena) const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+  ModelWeightsMsg* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ModelWeightsMsg>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const ModelWeightsMsg& from);
-  void MergeFrom(const ModelWeightsMsg& from);
-  void Clear();
-  bool IsInitialized() const;
-
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
-      bool deterministic, ::google::protobuf::uint8* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
-    return InternalSerializeWithCachedSizesToArray(false, output);
-  }
-  int GetCachedSize() const { return _cached_size_; }
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ModelWeightsMsg& from) {
+    ModelWeightsMsg::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
   private:
-  void SharedCtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
   void InternalSwap(ModelWeightsMsg* other);
+
   private:
-  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
-    return _internal_metadata_.arena();
-  }
-  inline void* MaybeArenaPtr() const {
-    return _internal_metadata_.raw_arena_ptr();
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "lu_net.ModelWeightsMsg";
   }
+  protected:
+  explicit ModelWeightsMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::google::protobuf::Metadata GetMetadata() const;
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
   // accessors -------------------------------------------------------
 
+  enum : int {
+    kModelFieldNumber = 1,
+    kWeightsFieldNumber = 2,
+  };
   // optional .lu_net.ModelMsg model = 1;
   bool has_model() const;
+  private:
+  bool _internal_has_model() const;
+  public:
   void clear_model();
-  static const int kModelFieldNumber = 1;
   const ::lu_net::ModelMsg& model() const;
+  PROTOBUF_NODISCARD ::lu_net::ModelMsg* release_model();
   ::lu_net::ModelMsg* mutable_model();
-  ::lu_net::ModelMsg* release_model();
   void set_allocated_model(::lu_net::ModelMsg* model);
+  private:
+  const ::lu_net::ModelMsg& _internal_model() const;
+  ::lu_net::ModelMsg* _internal_mutable_model();
+  public:
+  void unsafe_arena_set_allocated_model(
+      ::lu_net::ModelMsg* model);
+  ::lu_net::ModelMsg* unsafe_arena_release_model();
 
   // optional .lu_net.WeightsMsg weights = 2;
   bool has_weights() const;
+  private:
+  bool _internal_has_weights() const;
+  public:
   void clear_weights();
-  static const int kWeightsFieldNumber = 2;
   const ::lu_net::WeightsMsg& weights() const;
+  PROTOBUF_NODISCARD ::lu_net::WeightsMsg* release_weights();
   ::lu_net::WeightsMsg* mutable_weights();
-  ::lu_net::WeightsMsg* release_weights();
   void set_allocated_weights(::lu_net::WeightsMsg* weights);
+  private:
+  const ::lu_net::WeightsMsg& _internal_weights() const;
+  ::lu_net::WeightsMsg* _internal_mutable_weights();
+  public:
+  void unsafe_arena_set_allocated_weights(
+      ::lu_net::WeightsMsg* weights);
+  ::lu_net::WeightsMsg* unsafe_arena_release_weights();
 
   // @@protoc_insertion_point(class_scope:lu_net.ModelWeightsMsg)
  private:
-  inline void set_has_model();
-  inline void clear_has_model();
-  inline void set_has_weights();
-  inline void clear_has_weights();
-
-  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
-  ::google::protobuf::uint32 _has_bits_[1];
-  mutable int _cached_size_;
-  ::lu_net::ModelMsg* model_;
-  ::lu_net::WeightsMsg* weights_;
-  friend void  protobuf_AddDesc_lu_2eproto();
-  friend void protobuf_AssignDesc_lu_2eproto();
-  friend void protobuf_ShutdownFile_lu_2eproto();
-
-  void InitAsDefaultInstance();
-  static ModelWeightsMsg* default_instance_;
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::lu_net::ModelMsg* model_;
+    ::lu_net::WeightsMsg* weights_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_lu_2eproto;
 };
 // ===================================================================
 
 
 // ===================================================================
 
-#if !PROTOBUF_INLINE_NOT_IN_HEADERS
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// Datum
+
+// optional int32 channels = 1;
+inline bool Datum::_internal_has_channels() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Datum::has_channels() const {
+  return _internal_has_channels();
+}
+inline void Datum::clear_channels() {
+  _impl_.channels_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline int32_t Datum::_internal_channels() const {
+  return _impl_.channels_;
+}
+inline int32_t Datum::channels() const {
+  // @@protoc_insertion_point(field_get:lu_net.Datum.channels)
+  return _internal_channels();
+}
+inline void Datum::_internal_set_channels(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.channels_ = value;
+}
+inline void Datum::set_channels(int32_t value) {
+  _internal_set_channels(value);
+  // @@protoc_insertion_point(field_set:lu_net.Datum.channels)
+}
+
+// optional int32 height = 2;
+inline bool Datum::_internal_has_height() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool Datum::has_height() const {
+  return _internal_has_height();
+}
+inline void Datum::clear_height() {
+  _impl_.height_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline int32_t Datum::_internal_height() const {
+  return _impl_.height_;
+}
+inline int32_t Datum::height() const {
+  // @@protoc_insertion_point(field_get:lu_net.Datum.height)
+  return _internal_height();
+}
+inline void Datum::_internal_set_height(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.height_ = value;
+}
+inline void Datum::set_height(int32_t value) {
+  _internal_set_height(value);
+  // @@protoc_insertion_point(field_set:lu_net.Datum.height)
+}
+
+// optional int32 width = 3;
+inline bool Datum::_internal_has_width() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool Datum::has_width() const {
+  return _internal_has_width();
+}
+inline void Datum::clear_width() {
+  _impl_.width_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline int32_t Datum::_internal_width() const {
+  return _impl_.width_;
+}
+inline int32_t Datum::width() const {
+  // @@protoc_insertion_point(field_get:lu_net.Datum.width)
+  return _internal_width();
+}
+inline void Datum::_internal_set_width(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.width_ = value;
+}
+inline void Datum::set_width(int32_t value) {
+  _internal_set_width(value);
+  // @@protoc_insertion_point(field_set:lu_net.Datum.width)
+}
+
+// optional bytes data = 4;
+inline bool Datum::_internal_has_data() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Datum::has_data() const {
+  return _internal_has_data();
+}
+inline void Datum::clear_data() {
+  _impl_.data_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& Datum::data() const {
+  // @@protoc_insertion_point(field_get:lu_net.Datum.data)
+  return _internal_data();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Datum::set_data(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.data_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:lu_net.Datum.data)
+}
+inline std::string* Datum::mutable_data() {
+  std::string* _s = _internal_mutable_data();
+  // @@protoc_insertion_point(field_mutable:lu_net.Datum.data)
+  return _s;
+}
+inline const std::string& Datum::_internal_data() const {
+  return _impl_.data_.Get();
+}
+inline void Datum::_internal_set_data(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.data_.Set(value, GetArenaForAllocation());
+}
+inline std::string* Datum::_internal_mutable_data() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.data_.Mutable(GetArenaForAllocation());
+}
+inline std::string* Datum::release_data() {
+  // @@protoc_insertion_point(field_release:lu_net.Datum.data)
+  if (!_internal_has_data()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.data_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.data_.IsDefault()) {
+    _impl_.data_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void Datum::set_allocated_data(std::string* data) {
+  if (data != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.data_.SetAllocated(data, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.data_.IsDefault()) {
+    _impl_.data_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:lu_net.Datum.data)
+}
+
+// optional int32 label = 5;
+inline bool Datum::_internal_has_label() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
+inline bool Datum::has_label() const {
+  return _internal_has_label();
+}
+inline void Datum::clear_label() {
+  _impl_.label_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline int32_t Datum::_internal_label() const {
+  return _impl_.label_;
+}
+inline int32_t Datum::label() const {
+  // @@protoc_insertion_point(field_get:lu_net.Datum.label)
+  return _internal_label();
+}
+inline void Datum::_internal_set_label(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.label_ = value;
+}
+inline void Datum::set_label(int32_t value) {
+  _internal_set_label(value);
+  // @@protoc_insertion_point(field_set:lu_net.Datum.label)
+}
+
+// repeated float float_data = 6;
+inline int Datum::_internal_float_data_size() const {
+  return _impl_.float_data_.size();
+}
+inline int Datum::float_data_size() const {
+  return _internal_float_data_size();
+}
+inline void Datum::clear_float_data() {
+  _impl_.float_data_.Clear();
+}
+inline float Datum::_internal_float_data(int index) const {
+  return _impl_.float_data_.Get(index);
+}
+inline float Datum::float_data(int index) const {
+  // @@protoc_insertion_point(field_get:lu_net.Datum.float_data)
+  return _internal_float_data(index);
+}
+inline void Datum::set_float_data(int index, float value) {
+  _impl_.float_data_.Set(index, value);
+  // @@protoc_insertion_point(field_set:lu_net.Datum.float_data)
+}
+inline void Datum::_internal_add_float_data(float value) {
+  _impl_.float_data_.Add(value);
+}
+inline void Datum::add_float_data(float value) {
+  _internal_add_float_data(value);
+  // @@protoc_insertion_point(field_add:lu_net.Datum.float_data)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+Datum::_internal_float_data() const {
+  return _impl_.float_data_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+Datum::float_data() const {
+  // @@protoc_insertion_point(field_list:lu_net.Datum.float_data)
+  return _internal_float_data();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+Datum::_internal_mutable_float_data() {
+  return &_impl_.float_data_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+Datum::mutable_float_data() {
+  // @@protoc_insertion_point(field_mutable_list:lu_net.Datum.float_data)
+  return _internal_mutable_float_data();
+}
+
+// optional bool encoded = 7 [default = false];
+inline bool Datum::_internal_has_encoded() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
+inline bool Datum::has_encoded() const {
+  return _internal_has_encoded();
+}
+inline void Datum::clear_encoded() {
+  _impl_.encoded_ = false;
+  _impl_._has_bits_[0] &= ~0x00000020u;
+}
+inline bool Datum::_internal_encoded() const {
+  return _impl_.encoded_;
+}
+inline bool Datum::encoded() const {
+  // @@protoc_insertion_point(field_get:lu_net.Datum.encoded)
+  return _internal_encoded();
+}
+inline void Datum::_internal_set_encoded(bool value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.encoded_ = value;
+}
+inline void Datum::set_encoded(bool value) {
+  _internal_set_encoded(value);
+  // @@protoc_insertion_point(field_set:lu_net.Datum.encoded)
+}
+
+// -------------------------------------------------------------------
+
 // NetParameterMsg
 
 // repeated int32 layers_neuron_num = 1 [packed = true];
+inline int NetParameterMsg::_internal_layers_neuron_num_size() const {
+  return _impl_.layers_neuron_num_.size();
+}
 inline int NetParameterMsg::layers_neuron_num_size() const {
-  return layers_neuron_num_.size();
+  return _internal_layers_neuron_num_size();
 }
 inline void NetParameterMsg::clear_layers_neuron_num() {
-  layers_neuron_num_.Clear();
+  _impl_.layers_neuron_num_.Clear();
 }
-inline ::google::protobuf::int32 NetParameterMsg::layers_neuron_num(int index) const {
+inline int32_t NetParameterMsg::_internal_layers_neuron_num(int index) const {
+  return _impl_.layers_neuron_num_.Get(index);
+}
+inline int32_t NetParameterMsg::layers_neuron_num(int index) const {
   // @@protoc_insertion_point(field_get:lu_net.NetParameterMsg.layers_neuron_num)
-  return layers_neuron_num_.Get(index);
+  return _internal_layers_neuron_num(index);
 }
-inline void NetParameterMsg::set_layers_neuron_num(int index, ::google::protobuf::int32 value) {
-  layers_neuron_num_.Set(index, value);
+inline void NetParameterMsg::set_layers_neuron_num(int index, int32_t value) {
+  _impl_.layers_neuron_num_.Set(index, value);
   // @@protoc_insertion_point(field_set:lu_net.NetParameterMsg.layers_neuron_num)
 }
-inline void NetParameterMsg::add_layers_neuron_num(::google::protobuf::int32 value) {
-  layers_neuron_num_.Add(value);
+inline void NetParameterMsg::_internal_add_layers_neuron_num(int32_t value) {
+  _impl_.layers_neuron_num_.Add(value);
+}
+inline void NetParameterMsg::add_layers_neuron_num(int32_t value) {
+  _internal_add_layers_neuron_num(value);
   // @@protoc_insertion_point(field_add:lu_net.NetParameterMsg.layers_neuron_num)
 }
-inline const ::google::protobuf::RepeatedField< ::google::protobuf::int32 >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+NetParameterMsg::_internal_layers_neuron_num() const {
+  return _impl_.layers_neuron_num_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
 NetParameterMsg::layers_neuron_num() const {
   // @@protoc_insertion_point(field_list:lu_net.NetParameterMsg.layers_neuron_num)
-  return layers_neuron_num_;
+  return _internal_layers_neuron_num();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+NetParameterMsg::_internal_mutable_layers_neuron_num() {
+  return &_impl_.layers_neuron_num_;
 }
-inline ::google::protobuf::RepeatedField< ::google::protobuf::int32 >*
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
 NetParameterMsg::mutable_layers_neuron_num() {
   // @@protoc_insertion_point(field_mutable_list:lu_net.NetParameterMsg.layers_neuron_num)
-  return &layers_neuron_num_;
+  return _internal_mutable_layers_neuron_num();
 }
 
 // -------------------------------------------------------------------
@@ -708,70 +1799,120 @@ NetParameterMsg::mutable_layers_neuron_num() {
 // ModelMsg
 
 // optional float learning_rate = 1;
-inline bool ModelMsg::has_learning_rate() const {
-  return (_has_bits_[0] & 0x00000001u) != 0;
-}
-inline void ModelMsg::set_has_learning_rate() {
-  _has_bits_[0] |= 0x00000001u;
+inline bool ModelMsg::_internal_has_learning_rate() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
 }
-inline void ModelMsg::clear_has_learning_rate() {
-  _has_bits_[0] &= ~0x00000001u;
+inline bool ModelMsg::has_learning_rate() const {
+  return _internal_has_learning_rate();
 }
 inline void ModelMsg::clear_learning_rate() {
-  learning_rate_ = 0;
-  clear_has_learning_rate();
+  _impl_.learning_rate_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline float ModelMsg::_internal_learning_rate() const {
+  return _impl_.learning_rate_;
 }
 inline float ModelMsg::learning_rate() const {
   // @@protoc_insertion_point(field_get:lu_net.ModelMsg.learning_rate)
-  return learning_rate_;
+  return _internal_learning_rate();
+}
+inline void ModelMsg::_internal_set_learning_rate(float value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.learning_rate_ = value;
 }
 inline void ModelMsg::set_learning_rate(float value) {
-  set_has_learning_rate();
-  learning_rate_ = value;
+  _internal_set_learning_rate(value);
   // @@protoc_insertion_point(field_set:lu_net.ModelMsg.learning_rate)
 }
 
 // optional .lu_net.NetParameterMsg net_param = 2;
-inline bool ModelMsg::has_net_param() const {
-  return (_has_bits_[0] & 0x00000002u) != 0;
+inline bool ModelMsg::_internal_has_net_param() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.net_param_ != nullptr);
+  return value;
 }
-inline void ModelMsg::set_has_net_param() {
-  _has_bits_[0] |= 0x00000002u;
-}
-inline void ModelMsg::clear_has_net_param() {
-  _has_bits_[0] &= ~0x00000002u;
+inline bool ModelMsg::has_net_param() const {
+  return _internal_has_net_param();
 }
 inline void ModelMsg::clear_net_param() {
-  if (net_param_ != NULL) net_param_->::lu_net::NetParameterMsg::Clear();
-  clear_has_net_param();
+  if (_impl_.net_param_ != nullptr) _impl_.net_param_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const ::lu_net::NetParameterMsg& ModelMsg::_internal_net_param() const {
+  const ::lu_net::NetParameterMsg* p = _impl_.net_param_;
+  return p != nullptr ? *p : reinterpret_cast<const ::lu_net::NetParameterMsg&>(
+      ::lu_net::_NetParameterMsg_default_instance_);
 }
 inline const ::lu_net::NetParameterMsg& ModelMsg::net_param() const {
   // @@protoc_insertion_point(field_get:lu_net.ModelMsg.net_param)
-  return net_param_ != NULL ? *net_param_ : *default_instance_->net_param_;
+  return _internal_net_param();
 }
-inline ::lu_net::NetParameterMsg* ModelMsg::mutable_net_param() {
-  set_has_net_param();
-  if (net_param_ == NULL) {
-    net_param_ = new ::lu_net::NetParameterMsg;
+inline void ModelMsg::unsafe_arena_set_allocated_net_param(
+    ::lu_net::NetParameterMsg* net_param) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.net_param_);
   }
-  // @@protoc_insertion_point(field_mutable:lu_net.ModelMsg.net_param)
-  return net_param_;
+  _impl_.net_param_ = net_param;
+  if (net_param) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:lu_net.ModelMsg.net_param)
 }
 inline ::lu_net::NetParameterMsg* ModelMsg::release_net_param() {
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::lu_net::NetParameterMsg* temp = _impl_.net_param_;
+  _impl_.net_param_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::lu_net::NetParameterMsg* ModelMsg::unsafe_arena_release_net_param() {
   // @@protoc_insertion_point(field_release:lu_net.ModelMsg.net_param)
-  clear_has_net_param();
-  ::lu_net::NetParameterMsg* temp = net_param_;
-  net_param_ = NULL;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::lu_net::NetParameterMsg* temp = _impl_.net_param_;
+  _impl_.net_param_ = nullptr;
   return temp;
 }
+inline ::lu_net::NetParameterMsg* ModelMsg::_internal_mutable_net_param() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  if (_impl_.net_param_ == nullptr) {
+    auto* p = CreateMaybeMessage<::lu_net::NetParameterMsg>(GetArenaForAllocation());
+    _impl_.net_param_ = p;
+  }
+  return _impl_.net_param_;
+}
+inline ::lu_net::NetParameterMsg* ModelMsg::mutable_net_param() {
+  ::lu_net::NetParameterMsg* _msg = _internal_mutable_net_param();
+  // @@protoc_insertion_point(field_mutable:lu_net.ModelMsg.net_param)
+  return _msg;
+}
 inline void ModelMsg::set_allocated_net_param(::lu_net::NetParameterMsg* net_param) {
-  delete net_param_;
-  net_param_ = net_param;
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.net_param_;
+  }
   if (net_param) {
-    set_has_net_param();
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(net_param);
+    if (message_arena != submessage_arena) {
+      net_param = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, net_param, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    clear_has_net_param();
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
+  _impl_.net_param_ = net_param;
   // @@protoc_insertion_point(field_set_allocated:lu_net.ModelMsg.net_param)
 }
 
@@ -780,57 +1921,200 @@ inline void ModelMsg::set_allocated_net_param(::lu_net::NetParameterMsg* net_par
 // MatrixMsg
 
 // required uint32 rows = 1;
-inline bool MatrixMsg::has_rows() const {
-  return (_has_bits_[0] & 0x00000001u) != 0;
+inline bool MatrixMsg::_internal_has_rows() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
 }
-inline void MatrixMsg::set_has_rows() {
-  _has_bits_[0] |= 0x00000001u;
-}
-inline void MatrixMsg::clear_has_rows() {
-  _has_bits_[0] &= ~0x00000001u;
+inline bool MatrixMsg::has_rows() const {
+  return _internal_has_rows();
 }
 inline void MatrixMsg::clear_rows() {
-  rows_ = 0u;
-  clear_has_rows();
+  _impl_.rows_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline ::google::protobuf::uint32 MatrixMsg::rows() const {
+inline uint32_t MatrixMsg::_internal_rows() const {
+  return _impl_.rows_;
+}
+inline uint32_t MatrixMsg::rows() const {
   // @@protoc_insertion_point(field_get:lu_net.MatrixMsg.rows)
-  return rows_;
+  return _internal_rows();
+}
+inline void MatrixMsg::_internal_set_rows(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.rows_ = value;
 }
-inline void MatrixMsg::set_rows(::google::protobuf::uint32 value) {
-  set_has_rows();
-  rows_ = value;
+inline void MatrixMsg::set_rows(uint32_t value) {
+  _internal_set_rows(value);
   // @@protoc_insertion_point(field_set:lu_net.MatrixMsg.rows)
 }
 
 // repeated float data = 2 [packed = true];
+inline int MatrixMsg::_internal_data_size() const {
+  return _impl_.data_.size();
+}
 inline int MatrixMsg::data_size() const {
-  return data_.size();
+  return _internal_data_size();
 }
 inline void MatrixMsg::clear_data() {
-  data_.Clear();
+  _impl_.data_.Clear();
+}
+inline float MatrixMsg::_internal_data(int index) const {
+  return _impl_.data_.Get(index);
 }
 inline float MatrixMsg::data(int index) const {
   // @@protoc_insertion_point(field_get:lu_net.MatrixMsg.data)
-  return data_.Get(index);
+  return _internal_data(index);
 }
 inline void MatrixMsg::set_data(int index, float value) {
-  data_.Set(index, value);
+  _impl_.data_.Set(index, value);
   // @@protoc_insertion_point(field_set:lu_net.MatrixMsg.data)
 }
+inline void MatrixMsg::_internal_add_data(float value) {
+  _impl_.data_.Add(value);
+}
 inline void MatrixMsg::add_data(float value) {
-  data_.Add(value);
+  _internal_add_data(value);
   // @@protoc_insertion_point(field_add:lu_net.MatrixMsg.data)
 }
-inline const ::google::protobuf::RepeatedField< float >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+MatrixMsg::_internal_data() const {
+  return _impl_.data_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
 MatrixMsg::data() const {
   // @@protoc_insertion_point(field_list:lu_net.MatrixMsg.data)
-  return data_;
+  return _internal_data();
 }
-inline ::google::protobuf::RepeatedField< float >*
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+MatrixMsg::_internal_mutable_data() {
+  return &_impl_.data_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
 MatrixMsg::mutable_data() {
   // @@protoc_insertion_point(field_mutable_list:lu_net.MatrixMsg.data)
-  return &data_;
+  return _internal_mutable_data();
+}
+
+// optional uint32 cols = 3;
+inline bool MatrixMsg::_internal_has_cols() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool MatrixMsg::has_cols() const {
+  return _internal_has_cols();
+}
+inline void MatrixMsg::clear_cols() {
+  _impl_.cols_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint32_t MatrixMsg::_internal_cols() const {
+  return _impl_.cols_;
+}
+inline uint32_t MatrixMsg::cols() const {
+  // @@protoc_insertion_point(field_get:lu_net.MatrixMsg.cols)
+  return _internal_cols();
+}
+inline void MatrixMsg::_internal_set_cols(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.cols_ = value;
+}
+inline void MatrixMsg::set_cols(uint32_t value) {
+  _internal_set_cols(value);
+  // @@protoc_insertion_point(field_set:lu_net.MatrixMsg.cols)
+}
+
+// repeated uint32 row_ptr = 4 [packed = true];
+inline int MatrixMsg::_internal_row_ptr_size() const {
+  return _impl_.row_ptr_.size();
+}
+inline int MatrixMsg::row_ptr_size() const {
+  return _internal_row_ptr_size();
+}
+inline void MatrixMsg::clear_row_ptr() {
+  _impl_.row_ptr_.Clear();
+}
+inline uint32_t MatrixMsg::_internal_row_ptr(int index) const {
+  return _impl_.row_ptr_.Get(index);
+}
+inline uint32_t MatrixMsg::row_ptr(int index) const {
+  // @@protoc_insertion_point(field_get:lu_net.MatrixMsg.row_ptr)
+  return _internal_row_ptr(index);
+}
+inline void MatrixMsg::set_row_ptr(int index, uint32_t value) {
+  _impl_.row_ptr_.Set(index, value);
+  // @@protoc_insertion_point(field_set:lu_net.MatrixMsg.row_ptr)
+}
+inline void MatrixMsg::_internal_add_row_ptr(uint32_t value) {
+  _impl_.row_ptr_.Add(value);
+}
+inline void MatrixMsg::add_row_ptr(uint32_t value) {
+  _internal_add_row_ptr(value);
+  // @@protoc_insertion_point(field_add:lu_net.MatrixMsg.row_ptr)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+MatrixMsg::_internal_row_ptr() const {
+  return _impl_.row_ptr_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+MatrixMsg::row_ptr() const {
+  // @@protoc_insertion_point(field_list:lu_net.MatrixMsg.row_ptr)
+  return _internal_row_ptr();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+MatrixMsg::_internal_mutable_row_ptr() {
+  return &_impl_.row_ptr_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+MatrixMsg::mutable_row_ptr() {
+  // @@protoc_insertion_point(field_mutable_list:lu_net.MatrixMsg.row_ptr)
+  return _internal_mutable_row_ptr();
+}
+
+// repeated uint32 col_index = 5 [packed = true];
+inline int MatrixMsg::_internal_col_index_size() const {
+  return _impl_.col_index_.size();
+}
+inline int MatrixMsg::col_index_size() const {
+  return _internal_col_index_size();
+}
+inline void MatrixMsg::clear_col_index() {
+  _impl_.col_index_.Clear();
+}
+inline uint32_t MatrixMsg::_internal_col_index(int index) const {
+  return _impl_.col_index_.Get(index);
+}
+inline uint32_t MatrixMsg::col_index(int index) const {
+  // @@protoc_insertion_point(field_get:lu_net.MatrixMsg.col_index)
+  return _internal_col_index(index);
+}
+inline void MatrixMsg::set_col_index(int index, uint32_t value) {
+  _impl_.col_index_.Set(index, value);
+  // @@protoc_insertion_point(field_set:lu_net.MatrixMsg.col_index)
+}
+inline void MatrixMsg::_internal_add_col_index(uint32_t value) {
+  _impl_.col_index_.Add(value);
+}
+inline void MatrixMsg::add_col_index(uint32_t value) {
+  _internal_add_col_index(value);
+  // @@protoc_insertion_point(field_add:lu_net.MatrixMsg.col_index)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+MatrixMsg::_internal_col_index() const {
+  return _impl_.col_index_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+MatrixMsg::col_index() const {
+  // @@protoc_insertion_point(field_list:lu_net.MatrixMsg.col_index)
+  return _internal_col_index();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+MatrixMsg::_internal_mutable_col_index() {
+  return &_impl_.col_index_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+MatrixMsg::mutable_col_index() {
+  // @@protoc_insertion_point(field_mutable_list:lu_net.MatrixMsg.col_index)
+  return _internal_mutable_col_index();
 }
 
 // -------------------------------------------------------------------
@@ -838,33 +2122,50 @@ MatrixMsg::mutable_data() {
 // VectorMsg
 
 // repeated float data = 1 [packed = true];
+inline int VectorMsg::_internal_data_size() const {
+  return _impl_.data_.size();
+}
 inline int VectorMsg::data_size() const {
-  return data_.size();
+  return _internal_data_size();
 }
 inline void VectorMsg::clear_data() {
-  data_.Clear();
+  _impl_.data_.Clear();
+}
+inline float VectorMsg::_internal_data(int index) const {
+  return _impl_.data_.Get(index);
 }
 inline float VectorMsg::data(int index) const {
   // @@protoc_insertion_point(field_get:lu_net.VectorMsg.data)
-  return data_.Get(index);
+  return _internal_data(index);
 }
 inline void VectorMsg::set_data(int index, float value) {
-  data_.Set(index, value);
+  _impl_.data_.Set(index, value);
   // @@protoc_insertion_point(field_set:lu_net.VectorMsg.data)
 }
+inline void VectorMsg::_internal_add_data(float value) {
+  _impl_.data_.Add(value);
+}
 inline void VectorMsg::add_data(float value) {
-  data_.Add(value);
+  _internal_add_data(value);
   // @@protoc_insertion_point(field_add:lu_net.VectorMsg.data)
 }
-inline const ::google::protobuf::RepeatedField< float >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
+VectorMsg::_internal_data() const {
+  return _impl_.data_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >&
 VectorMsg::data() const {
   // @@protoc_insertion_point(field_list:lu_net.VectorMsg.data)
-  return data_;
+  return _internal_data();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
+VectorMsg::_internal_mutable_data() {
+  return &_impl_.data_;
 }
-inline ::google::protobuf::RepeatedField< float >*
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
 VectorMsg::mutable_data() {
   // @@protoc_insertion_point(field_mutable_list:lu_net.VectorMsg.data)
-  return &data_;
+  return _internal_mutable_data();
 }
 
 // -------------------------------------------------------------------
@@ -872,63 +2173,83 @@ VectorMsg::mutable_data() {
 // WeightsMsg
 
 // repeated .lu_net.MatrixMsg weights = 2;
+inline int WeightsMsg::_internal_weights_size() const {
+  return _impl_.weights_.size();
+}
 inline int WeightsMsg::weights_size() const {
-  return weights_.size();
+  return _internal_weights_size();
 }
 inline void WeightsMsg::clear_weights() {
-  weights_.Clear();
+  _impl_.weights_.Clear();
+}
+inline ::lu_net::MatrixMsg* WeightsMsg::mutable_weights(int index) {
+  // @@protoc_insertion_point(field_mutable:lu_net.WeightsMsg.weights)
+  return _impl_.weights_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::MatrixMsg >*
+WeightsMsg::mutable_weights() {
+  // @@protoc_insertion_point(field_mutable_list:lu_net.WeightsMsg.weights)
+  return &_impl_.weights_;
+}
+inline const ::lu_net::MatrixMsg& WeightsMsg::_internal_weights(int index) const {
+  return _impl_.weights_.Get(index);
 }
 inline const ::lu_net::MatrixMsg& WeightsMsg::weights(int index) const {
   // @@protoc_insertion_point(field_get:lu_net.WeightsMsg.weights)
-  return weights_.Get(index);
+  return _internal_weights(index);
 }
-inline ::lu_net::MatrixMsg* WeightsMsg::mutable_weights(int index) {
-  // @@protoc_insertion_point(field_mutable:lu_net.WeightsMsg.weights)
-  return weights_.Mutable(index);
+inline ::lu_net::MatrixMsg* WeightsMsg::_internal_add_weights() {
+  return _impl_.weights_.Add();
 }
 inline ::lu_net::MatrixMsg* WeightsMsg::add_weights() {
+  ::lu_net::MatrixMsg* _add = _internal_add_weights();
   // @@protoc_insertion_point(field_add:lu_net.WeightsMsg.weights)
-  return weights_.Add();
-}
-inline ::google::protobuf::RepeatedPtrField< ::lu_net::MatrixMsg >*
-WeightsMsg::mutable_weights() {
-  // @@protoc_insertion_point(field_mutable_list:lu_net.WeightsMsg.weights)
-  return &weights_;
+  return _add;
 }
-inline const ::google::protobuf::RepeatedPtrField< ::lu_net::MatrixMsg >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::MatrixMsg >&
 WeightsMsg::weights() const {
   // @@protoc_insertion_point(field_list:lu_net.WeightsMsg.weights)
-  return weights_;
+  return _impl_.weights_;
 }
 
 // repeated .lu_net.VectorMsg bias = 3;
+inline int WeightsMsg::_internal_bias_size() const {
+  return _impl_.bias_.size();
+}
 inline int WeightsMsg::bias_size() const {
-  return bias_.size();
+  return _internal_bias_size();
 }
 inline void WeightsMsg::clear_bias() {
-  bias_.Clear();
+  _impl_.bias_.Clear();
+}
+inline ::lu_net::VectorMsg* WeightsMsg::mutable_bias(int index) {
+  // @@protoc_insertion_point(field_mutable:lu_net.WeightsMsg.bias)
+  return _impl_.bias_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::VectorMsg >*
+WeightsMsg::mutable_bias() {
+  // @@protoc_insertion_point(field_mutable_list:lu_net.WeightsMsg.bias)
+  return &_impl_.bias_;
+}
+inline const ::lu_net::VectorMsg& WeightsMsg::_internal_bias(int index) const {
+  return _impl_.bias_.Get(index);
 }
 inline const ::lu_net::VectorMsg& WeightsMsg::bias(int index) const {
   // @@protoc_insertion_point(field_get:lu_net.WeightsMsg.bias)
-  return bias_.Get(index);
+  return _internal_bias(index);
 }
-inline ::lu_net::VectorMsg* WeightsMsg::mutable_bias(int index) {
-  // @@protoc_insertion_point(field_mutable:lu_net.WeightsMsg.bias)
-  return bias_.Mutable(index);
+inline ::lu_net::VectorMsg* WeightsMsg::_internal_add_bias() {
+  return _impl_.bias_.Add();
 }
 inline ::lu_net::VectorMsg* WeightsMsg::add_bias() {
+  ::lu_net::VectorMsg* _add = _internal_add_bias();
   // @@protoc_insertion_point(field_add:lu_net.WeightsMsg.bias)
-  return bias_.Add();
-}
-inline ::google::protobuf::RepeatedPtrField< ::lu_net::VectorMsg >*
-WeightsMsg::mutable_bias() {
-  // @@protoc_insertion_point(field_mutable_list:lu_net.WeightsMsg.bias)
-  return &bias_;
+  return _add;
 }
-inline const ::google::protobuf::RepeatedPtrField< ::lu_net::VectorMsg >&
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::lu_net::VectorMsg >&
 WeightsMsg::bias() const {
   // @@protoc_insertion_point(field_list:lu_net.WeightsMsg.bias)
-  return bias_;
+  return _impl_.bias_;
 }
 
 // -------------------------------------------------------------------
@@ -936,94 +2257,190 @@ WeightsMsg::bias() const {
 // ModelWeightsMsg
 
 // optional .lu_net.ModelMsg model = 1;
-inline bool ModelWeightsMsg::has_model() const {
-  return (_has_bits_[0] & 0x00000001u) != 0;
-}
-inline void ModelWeightsMsg::set_has_model() {
-  _has_bits_[0] |= 0x00000001u;
+inline bool ModelWeightsMsg::_internal_has_model() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.model_ != nullptr);
+  return value;
 }
-inline void ModelWeightsMsg::clear_has_model() {
-  _has_bits_[0] &= ~0x00000001u;
+inline bool ModelWeightsMsg::has_model() const {
+  return _internal_has_model();
 }
 inline void ModelWeightsMsg::clear_model() {
-  if (model_ != NULL) model_->::lu_net::ModelMsg::Clear();
-  clear_has_model();
+  if (_impl_.model_ != nullptr) _impl_.model_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const ::lu_net::ModelMsg& ModelWeightsMsg::_internal_model() const {
+  const ::lu_net::ModelMsg* p = _impl_.model_;
+  return p != nullptr ? *p : reinterpret_cast<const ::lu_net::ModelMsg&>(
+      ::lu_net::_ModelMsg_default_instance_);
 }
 inline const ::lu_net::ModelMsg& ModelWeightsMsg::model() const {
   // @@protoc_insertion_point(field_get:lu_net.ModelWeightsMsg.model)
-  return model_ != NULL ? *model_ : *default_instance_->model_;
+  return _internal_model();
 }
-inline ::lu_net::ModelMsg* ModelWeightsMsg::mutable_model() {
-  set_has_model();
-  if (model_ == NULL) {
-    model_ = new ::lu_net::ModelMsg;
+inline void ModelWeightsMsg::unsafe_arena_set_allocated_model(
+    ::lu_net::ModelMsg* model) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.model_);
   }
-  // @@protoc_insertion_point(field_mutable:lu_net.ModelWeightsMsg.model)
-  return model_;
+  _impl_.model_ = model;
+  if (model) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:lu_net.ModelWeightsMsg.model)
 }
 inline ::lu_net::ModelMsg* ModelWeightsMsg::release_model() {
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::lu_net::ModelMsg* temp = _impl_.model_;
+  _impl_.model_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::lu_net::ModelMsg* ModelWeightsMsg::unsafe_arena_release_model() {
   // @@protoc_insertion_point(field_release:lu_net.ModelWeightsMsg.model)
-  clear_has_model();
-  ::lu_net::ModelMsg* temp = model_;
-  model_ = NULL;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::lu_net::ModelMsg* temp = _impl_.model_;
+  _impl_.model_ = nullptr;
   return temp;
 }
+inline ::lu_net::ModelMsg* ModelWeightsMsg::_internal_mutable_model() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  if (_impl_.model_ == nullptr) {
+    auto* p = CreateMaybeMessage<::lu_net::ModelMsg>(GetArenaForAllocation());
+    _impl_.model_ = p;
+  }
+  return _impl_.model_;
+}
+inline ::lu_net::ModelMsg* ModelWeightsMsg::mutable_model() {
+  ::lu_net::ModelMsg* _msg = _internal_mutable_model();
+  // @@protoc_insertion_point(field_mutable:lu_net.ModelWeightsMsg.model)
+  return _msg;
+}
 inline void ModelWeightsMsg::set_allocated_model(::lu_net::ModelMsg* model) {
-  delete model_;
-  model_ = model;
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.model_;
+  }
   if (model) {
-    set_has_model();
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(model);
+    if (message_arena != submessage_arena) {
+      model = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, model, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    clear_has_model();
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
+  _impl_.model_ = model;
   // @@protoc_insertion_point(field_set_allocated:lu_net.ModelWeightsMsg.model)
 }
 
 // optional .lu_net.WeightsMsg weights = 2;
-inline bool ModelWeightsMsg::has_weights() const {
-  return (_has_bits_[0] & 0x00000002u) != 0;
-}
-inline void ModelWeightsMsg::set_has_weights() {
-  _has_bits_[0] |= 0x00000002u;
+inline bool ModelWeightsMsg::_internal_has_weights() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.weights_ != nullptr);
+  return value;
 }
-inline void ModelWeightsMsg::clear_has_weights() {
-  _has_bits_[0] &= ~0x00000002u;
+inline bool ModelWeightsMsg::has_weights() const {
+  return _internal_has_weights();
 }
 inline void ModelWeightsMsg::clear_weights() {
-  if (weights_ != NULL) weights_->::lu_net::WeightsMsg::Clear();
-  clear_has_weights();
+  if (_impl_.weights_ != nullptr) _impl_.weights_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const ::lu_net::WeightsMsg& ModelWeightsMsg::_internal_weights() const {
+  const ::lu_net::WeightsMsg* p = _impl_.weights_;
+  return p != nullptr ? *p : reinterpret_cast<const ::lu_net::WeightsMsg&>(
+      ::lu_net::_WeightsMsg_default_instance_);
 }
 inline const ::lu_net::WeightsMsg& ModelWeightsMsg::weights() const {
   // @@protoc_insertion_point(field_get:lu_net.ModelWeightsMsg.weights)
-  return weights_ != NULL ? *weights_ : *default_instance_->weights_;
+  return _internal_weights();
 }
-inline ::lu_net::WeightsMsg* ModelWeightsMsg::mutable_weights() {
-  set_has_weights();
-  if (weights_ == NULL) {
-    weights_ = new ::lu_net::WeightsMsg;
+inline void ModelWeightsMsg::unsafe_arena_set_allocated_weights(
+    ::lu_net::WeightsMsg* weights) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.weights_);
   }
-  // @@protoc_insertion_point(field_mutable:lu_net.ModelWeightsMsg.weights)
-  return weights_;
+  _impl_.weights_ = weights;
+  if (weights) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:lu_net.ModelWeightsMsg.weights)
 }
 inline ::lu_net::WeightsMsg* ModelWeightsMsg::release_weights() {
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::lu_net::WeightsMsg* temp = _impl_.weights_;
+  _impl_.weights_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::lu_net::WeightsMsg* ModelWeightsMsg::unsafe_arena_release_weights() {
   // @@protoc_insertion_point(field_release:lu_net.ModelWeightsMsg.weights)
-  clear_has_weights();
-  ::lu_net::WeightsMsg* temp = weights_;
-  weights_ = NULL;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::lu_net::WeightsMsg* temp = _impl_.weights_;
+  _impl_.weights_ = nullptr;
   return temp;
 }
+inline ::lu_net::WeightsMsg* ModelWeightsMsg::_internal_mutable_weights() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  if (_impl_.weights_ == nullptr) {
+    auto* p = CreateMaybeMessage<::lu_net::WeightsMsg>(GetArenaForAllocation());
+    _impl_.weights_ = p;
+  }
+  return _impl_.weights_;
+}
+inline ::lu_net::WeightsMsg* ModelWeightsMsg::mutable_weights() {
+  ::lu_net::WeightsMsg* _msg = _internal_mutable_weights();
+  // @@protoc_insertion_point(field_mutable:lu_net.ModelWeightsMsg.weights)
+  return _msg;
+}
 inline void ModelWeightsMsg::set_allocated_weights(::lu_net::WeightsMsg* weights) {
-  delete weights_;
-  weights_ = weights;
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.weights_;
+  }
   if (weights) {
-    set_has_weights();
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(weights);
+    if (message_arena != submessage_arena) {
+      weights = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, weights, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    clear_has_weights();
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
+  _impl_.weights_ = weights;
   // @@protoc_insertion_point(field_set_allocated:lu_net.ModelWeightsMsg.weights)
 }
 
-#endif  // !PROTOBUF_INLINE_NOT_IN_HEADERS
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
 // -------------------------------------------------------------------
 
 // -------------------------------------------------------------------
@@ -1041,4 +2458,5 @@ inline void ModelWeightsMsg::set_allocated_weights(::lu_net::WeightsMsg* weights
 
 // @@protoc_insertion_point(global_scope)
 
-#endif  // PROTOBUF_lu_2eproto__INCLUDED
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_lu_2eproto
@@ -1 +1,24 @@
+# Train and test a small net from NumPy arrays, build the module first (see swig/README.txt).
+import sys
+import numpy
 
+sys.path.insert(0, 'swig')
+import net
+
+rng = numpy.random.RandomState(0)
+inputs = rng.rand(1000, 784).astype(numpy.float32)
+labels = rng.randint(0, 10, size=1000).astype(numpy.uint8)
+
+n = net.Net()
+n.initNet(net.IntVector([784, 30, 10]), 0.1, 0)
+n.initWeights()
+n.initBias()
+
+n.train(net.gradient_descent(), inputs, labels, 10, 2)
+print('accuracy', n.test(inputs, labels).accuracy())
+print('outputs', n.predict(inputs[:2]))
+
+# the views share the storage of the net
+w = n.get_weights(1)
+w *= 0.5
+print('weights', w.shape, n.get_weights(1)[0, :4])
@@ -2,8 +2,221 @@
 
 %{
 /* Includes the header in the wrapper code */
-#include "../../include/net.h"
+#include "net_python.h"
 %}
 
-/* Parse the header file to generate wrappers */
-%include "../../include/net.h"
\ No newline at end of file
+%include "std_string.i"
+%include "std_vector.i"
+%include "exception.i"
+
+%template(IntVector) std::vector<int>;
+
+/* Errors of the helpers in net_python.h become Python exceptions */
+%exception {
+    try {
+        $action
+    } catch (const lu_net::python::python_error &) {
+        SWIG_fail;
+    } catch (const std::invalid_argument &e) {
+        SWIG_exception(SWIG_ValueError, e.what());
+    }
+}
+
+%init %{
+    if (PyType_Ready(&lu_net::python::param_view_type()) < 0) {
+        return NULL;
+    }
+%}
+
+%pythoncode %{
+import numpy
+
+
+def _inputs(x):
+    """float32 C-contiguous samples, one per row. float32 arrays are passed without a copy,
+    uint8 arrays are scaled to [0, 1] as the MNIST reader does."""
+    x = numpy.asarray(x)
+    if x.dtype == numpy.uint8:
+        x = x.astype(numpy.float32) / numpy.float32(255)
+    return numpy.ascontiguousarray(numpy.atleast_2d(x), dtype=numpy.float32)
+
+
+def _labels(y):
+    """uint32 or uint8 C-contiguous labels are passed without a copy, other types are converted to uint32."""
+    y = numpy.asarray(y)
+    if y.dtype == numpy.uint8:
+        return numpy.ascontiguousarray(y)
+    return numpy.ascontiguousarray(y, dtype=numpy.uint32)
+%}
+
+/* Only the parts of the headers usable from Python, the classes are declared here rather than parsed */
+namespace lu_net {
+    enum class content_type {
+        weights,
+        model,
+        weights_and_model
+    };
+
+    enum class file_format {
+        binary,
+        json
+    };
+
+    namespace weight_init {
+        enum class scheme {
+            lecun,
+            xavier,
+            he,
+            orthogonal
+        };
+    }
+
+    struct result {
+        int num_success;
+        int num_total;
+
+        float accuracy() const;
+    };
+
+    namespace optimizer {
+        %nodefaultctor optimizer;
+
+        class optimizer {
+        public:
+            virtual ~optimizer();
+
+            // clear the optimizer state (moments, step counts).
+            virtual void reset();
+        };
+
+        class gradient_descent : public optimizer {
+        public:
+            float lambda;
+
+            gradient_descent();
+        };
+
+        class momentum : public optimizer {
+        public:
+            float lambda;
+            float mu;
+
+            momentum();
+        };
+
+        class adagrad : public optimizer {
+        public:
+            float eps;
+
+            adagrad();
+        };
+
+        class RMSprop : public optimizer {
+        public:
+            float mu;
+            float eps;
+
+            RMSprop();
+        };
+
+        class adam : public optimizer {
+        public:
+            float b1;
+            float b2;
+            float eps;
+
+            adam();
+        };
+
+        class adamw : public adam {
+        public:
+            float lambda;
+
+            adamw();
+        };
+    }
+
+    class Net {
+    public:
+        Net();
+
+        std::vector<int> layers_neuron_num;
+        int num_layers;
+        float learning_rate;
+        float lmbda;
+        float batch_loss;
+        int output_interval;
+        float fine_tune_factor;
+        int validation_interval;
+        int patience;
+        bool restore_best;
+        bool mixed_precision;
+
+        void initNet(const std::vector<int> layers_neuron_num, float learning_rate, float lmbda);
+
+        void initWeights(const double w = 0);
+
+        void initWeights(weight_init::scheme scheme);
+
+        void initBias(const double w = 0);
+
+        bool save(const std::string &filename,
+                  content_type what = content_type::weights_and_model,
+                  file_format format = file_format::binary);
+
+        bool load(const std::string &filename,
+                  content_type what = content_type::weights_and_model,
+                  file_format format = file_format::binary);
+
+        void prune(float sparsity);
+        void clear_pruning();
+
+        void set_dropout(int layer, float keep_prob);
+    };
+}
+
+%extend lu_net::Net {
+    bool train_buffer(lu_net::optimizer::optimizer &optimizer, PyObject *inputs, PyObject *labels,
+                      int batch_size, int epoch) {
+        return lu_net::python::train(*$self, optimizer, inputs, labels, batch_size, epoch);
+    }
+
+    lu_net::result test_buffer(PyObject *inputs, PyObject *labels) {
+        return lu_net::python::test(*$self, inputs, labels);
+    }
+
+    void predict_buffer(PyObject *inputs, PyObject *outputs) {
+        lu_net::python::predict(*$self, inputs, outputs);
+    }
+
+    PyObject *param_buffer(int i, bool bias, PyObject *owner) {
+        return lu_net::python::param_buffer(*$self, i, bias, owner);
+    }
+
+%pythoncode %{
+    def train(self, optimizer, inputs, labels, batch_size, epoch):
+        """Train on inputs (n x input size) and labels (n) with the cross entropy loss,
+        the GIL is released while training."""
+        return self.train_buffer(optimizer, _inputs(inputs), _labels(labels), batch_size, epoch)
+
+    def test(self, inputs, labels):
+        """Test on inputs (n x input size) and labels (n), float32 inputs are read in place."""
+        return self.test_buffer(_inputs(inputs), _labels(labels))
+
+    def predict(self, inputs):
+        """Activations of the last layer, n x output size, float32 inputs are read in place."""
+        inputs = _inputs(inputs)
+        outputs = numpy.empty((inputs.shape[0], self.layers_neuron_num[-1]), dtype=numpy.float32)
+        self.predict_buffer(inputs, outputs)
+        return outputs
+
+    def get_weights(self, i):
+        """Writable view of the weights of layer i (1 ~ num_layers - 1), output size x input size.
+        Valid until initNet() or load()."""
+        return numpy.asarray(self.param_buffer(i, False, self))
+
+    def get_bias(self, i):
+        """Writable view of the bias of layer i, valid until initNet() or load()."""
+        return numpy.asarray(self.param_buffer(i, True, self))
+%}
+}
@@ -0,0 +1,267 @@
+//
+// Created by 芦yafei  on 17/9/12.
+//
+// Helpers of net.i: NumPy (or any buffer protocol) arrays in and out of Net without copying them
+// element by element, and with the GIL released while the net computes.
+//
+#ifndef LU_NET_NET_PYTHON_H
+#define LU_NET_NET_PYTHON_H
+
+#include <Python.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "net.h"
+#include "optimizer.h"
+#include "loss_function.h"
+#include "weight_init.h"
+
+namespace lu_net {
+    namespace python {
+
+        // a Python exception is already set, the wrapper only has to return NULL
+        struct python_error : std::exception {};
+
+        // release the GIL for the lifetime of the object
+        class gil_release {
+        public:
+            gil_release() : state_(PyEval_SaveThread()) {}
+
+            ~gil_release() { PyEval_RestoreThread(state_); }
+
+            gil_release(const gil_release &) = delete;
+            gil_release &operator=(const gil_release &) = delete;
+
+        private:
+            PyThreadState *state_;
+        };
+
+        /**
+         * C-contiguous view of a buffer protocol object, checked for the item format and the number of dimensions.
+         * formats lists the accepted item formats, e.g. "f" or "IB", type_name names them in the error message.
+         * Must be destroyed with the GIL held.
+         **/
+        class buffer {
+        public:
+            buffer(PyObject *obj, const char *name, const char *formats, const char *type_name, int ndim,
+                   bool writable = false) {
+                int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+                if (PyObject_GetBuffer(obj, &view_, flags) != 0) {
+                    throw python_error();
+                }
+                // native or little endian standard size, e.g. "f", "=f" or "<f"
+                const char *f = view_.format;
+                if (f[0] == '@' || f[0] == '=' || f[0] == '<') f++;
+                format_ = f[0];
+                if (format_ == '\0' || f[1] != '\0' || std::strchr(formats, format_) == nullptr || view_.ndim != ndim) {
+                    std::string message = std::string(name) + " must be a " + std::to_string(ndim) + "-d array of " +
+                                          type_name;
+                    PyBuffer_Release(&view_);
+                    throw std::invalid_argument(message);
+                }
+            }
+
+            ~buffer() { PyBuffer_Release(&view_); }
+
+            buffer(const buffer &) = delete;
+            buffer &operator=(const buffer &) = delete;
+
+            long shape(int i) const { return long(view_.shape[i]); }
+
+            char format() const { return format_; }
+
+            template <typename T>
+            T *data() const { return static_cast<T *>(view_.buf); }
+
+        private:
+            Py_buffer view_;
+            char format_;
+        };
+
+        // uint32 labels are read in place, uint8 ones (as MNIST ships them) are widened into copy
+        inline const label_t *read_labels(const buffer &y, std::vector<label_t> &copy) {
+            if (y.format() == 'I') {
+                return y.data<label_t>();
+            }
+            copy.assign(y.data<uint8_t>(), y.data<uint8_t>() + y.shape(0));
+            return copy.data();
+        }
+
+        // n x input size samples and n labels
+        inline void check_samples(const Net &net, const buffer &inputs, const buffer *labels) {
+            if (net.num_layers < 2) {
+                throw std::invalid_argument("the net is not initialized");
+            }
+            if (inputs.shape(1) != net.layers_neuron_num[0]) {
+                throw std::invalid_argument("inputs must have " + std::to_string(net.layers_neuron_num[0]) + " columns");
+            }
+            if (labels != nullptr && labels->shape(0) != inputs.shape(0)) {
+                throw std::invalid_argument("inputs and labels must have the same number of rows");
+            }
+        }
+
+        // Net::train is instantiated for each optimizer class, try them from the most derived
+        template <typename O>
+        bool train_with(Net &net, optimizer::optimizer &opt, const std::vector<vec_t> &inputs,
+                        const std::vector<label_t> &labels, int batch_size, int epoch, bool &trained) {
+            O *o = dynamic_cast<O *>(&opt);
+            if (o == nullptr) {
+                return false;
+            }
+            trained = net.train<cross_entropy>(*o, inputs, labels, batch_size, epoch);
+            return true;
+        }
+
+        /**
+         * Net::train with the cross_entropy loss over NumPy arrays. train keeps its own copy of the samples,
+         * so the rows are copied into vec_t with the GIL released instead of converting every element through Python.
+         **/
+        inline bool train(Net &net, optimizer::optimizer &opt, PyObject *inputs, PyObject *labels,
+                          int batch_size, int epoch) {
+            buffer x(inputs, "inputs", "f", "float32", 2);
+            buffer y(labels, "labels", "IB", "uint32 or uint8", 1);
+            check_samples(net, x, &y);
+
+            bool trained = false;
+            gil_release nogil;
+            const long n = x.shape(0);
+            const long input_size = x.shape(1);
+            std::vector<vec_t> samples(n);
+            for (long i = 0; i < n; i++) {
+                const float *row = x.data<float>() + i * input_size;
+                samples[i].assign(row, row + input_size);
+            }
+            std::vector<label_t> class_labels;
+            if (y.format() == 'I') {
+                class_labels.assign(y.data<label_t>(), y.data<label_t>() + n);
+            } else {
+                class_labels.assign(y.data<uint8_t>(), y.data<uint8_t>() + n);
+            }
+
+            if (!train_with<optimizer::adamw>(net, opt, samples, class_labels, batch_size, epoch, trained) &&
+                !train_with<optimizer::adam>(net, opt, samples, class_labels, batch_size, epoch, trained) &&
+                !train_with<optimizer::RMSprop>(net, opt, samples, class_labels, batch_size, epoch, trained) &&
+                !train_with<optimizer::adagrad>(net, opt, samples, class_labels, batch_size, epoch, trained) &&
+                !train_with<optimizer::momentum>(net, opt, samples, class_labels, batch_size, epoch, trained) &&
+                !train_with<optimizer::gradient_descent>(net, opt, samples, class_labels, batch_size, epoch, trained)) {
+                throw std::invalid_argument("unknown optimizer");
+            }
+            return trained;
+        }
+
+        // Net::test over NumPy arrays, read in place
+        inline result test(Net &net, PyObject *inputs, PyObject *labels) {
+            buffer x(inputs, "inputs", "f", "float32", 2);
+            buffer y(labels, "labels", "IB", "uint32 or uint8", 1);
+            check_samples(net, x, &y);
+
+            gil_release nogil;
+            std::vector<label_t> widened;
+            return net.test(x.data<float>(), read_labels(y, widened), x.shape(0));
+        }
+
+        // Net::predict from and into NumPy arrays, read and written in place
+        inline void predict(Net &net, PyObject *inputs, PyObject *outputs) {
+            buffer x(inputs, "inputs", "f", "float32", 2);
+            buffer out(outputs, "outputs", "f", "float32", 2, true);
+            check_samples(net, x, nullptr);
+            if (out.shape(0) != x.shape(0) || out.shape(1) != net.layers_neuron_num[net.num_layers - 1]) {
+                throw std::invalid_argument("outputs must be a inputs rows x output size array");
+            }
+
+            gil_release nogil;
+            net.predict(x.data<float>(), x.shape(0), out.data<float>());
+        }
+
+
+        /**
+         * Writable buffer over the storage of a weight matrix or bias vector, column-major as Eigen.
+         * It keeps the Python Net object alive, the memory stays valid until initNet() or load() of the net.
+         **/
+        struct param_view {
+            PyObject_HEAD
+            PyObject *owner;
+            float *data;
+            int ndim;
+            Py_ssize_t shape[2];
+            Py_ssize_t strides[2];
+        };
+
+        inline int param_view_getbuffer(PyObject *self, Py_buffer *view, int flags) {
+            param_view *p = reinterpret_cast<param_view *>(self);
+            bool column_major = p->ndim == 2 && p->shape[0] > 1 && p->shape[1] > 1;
+            if (column_major && ((flags & PyBUF_STRIDES) != PyBUF_STRIDES ||
+                                 (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS)) {
+                PyErr_SetString(PyExc_BufferError, "weights are column-major, strides are needed");
+                view->obj = NULL;
+                return -1;
+            }
+            view->buf = p->data;
+            view->obj = self;
+            Py_INCREF(self);
+            view->len = Py_ssize_t(sizeof(float));
+            for (int i = 0; i < p->ndim; i++) view->len *= p->shape[i];
+            view->readonly = 0;
+            view->itemsize = sizeof(float);
+            view->format = (flags & PyBUF_FORMAT) ? const_cast<char *>("f") : NULL;
+            view->ndim = p->ndim;
+            view->shape = (flags & PyBUF_ND) == PyBUF_ND ? p->shape : NULL;
+            view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? p->strides : NULL;
+            view->suboffsets = NULL;
+            view->internal = NULL;
+            return 0;
+        }
+
+        inline void param_view_dealloc(PyObject *self) {
+            Py_XDECREF(reinterpret_cast<param_view *>(self)->owner);
+            Py_TYPE(self)->tp_free(self);
+        }
+
+        inline PyTypeObject &param_view_type() {
+            static PyBufferProcs buffer_procs = {param_view_getbuffer, NULL};
+            static PyTypeObject type = {PyVarObject_HEAD_INIT(NULL, 0)};
+            if (type.tp_name == NULL) {
+                type.tp_name = "net.ParamView";
+                type.tp_basicsize = sizeof(param_view);
+                type.tp_dealloc = param_view_dealloc;
+                type.tp_as_buffer = &buffer_procs;
+                type.tp_flags = Py_TPFLAGS_DEFAULT;
+                type.tp_doc = "writable buffer over the weights or bias of a layer";
+            }
+            return type;
+        }
+
+        /**
+         * Buffer over the weights (bias = false) or bias of layer i (1 ~ num_layers - 1).
+         * owner is the Python object of net.
+         **/
+        inline PyObject *param_buffer(Net &net, int i, bool bias, PyObject *owner) {
+            if (i < 1 || i >= net.num_layers) {
+                throw std::invalid_argument("layer must be in [1, num_layers)");
+            }
+            param_view *p = PyObject_New(param_view, &param_view_type());
+            if (p == NULL) {
+                throw python_error();
+            }
+            Py_INCREF(owner);
+            p->owner = owner;
+            if (bias) {
+                p->data = const_cast<float *>(net.get_bias(i).data());
+                p->ndim = 1;
+                p->shape[0] = net.get_bias(i).size();
+                p->strides[0] = sizeof(float);
+            } else {
+                p->data = const_cast<float *>(net.get_weights(i).data());
+                p->ndim = 2;
+                p->shape[0] = net.get_weights(i).rows();
+                p->shape[1] = net.get_weights(i).cols();
+                p->strides[0] = sizeof(float);
+                p->strides[1] = sizeof(float) * p->shape[0];
+            }
+            return reinterpret_cast<PyObject *>(p);
+        }
+    }
+}
+
+#endif //LU_NET_NET_PYTHON_H
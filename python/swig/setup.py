@@ -1,20 +1,49 @@
 #!/usr/bin/env python
 #-*- coding: utf-8 -*-
 
-# python自带一个distutils工具，可以用它来创建python的扩展模块。
-from distutils.core import setup, Extension
+# setuptools生成扩展模块，net.i由swig自动生成包装代码。
+# The kernels of cpu_dispatch.h are built as static libraries, each with the flags of its instruction set.
+import os
+import platform
+from setuptools import setup, Extension
+
+# absolute, so that the objects of the repository sources stay inside the build directory
+root = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..')) + '/'
+
+kernel_flags = {'generic': ['-O3', '-fno-math-errno', '-fno-trapping-math']}
+if platform.machine() in ('x86_64', 'AMD64', 'amd64'):
+    kernel_flags['sse42'] = ['-O3', '-fno-math-errno', '-fno-trapping-math', '-msse4.2']
+    kernel_flags['avx2'] = ['-O3', '-fno-math-errno', '-fno-trapping-math', '-mavx2', '-mfma']
+    kernel_flags['avx512'] = ['-O3', '-fno-math-errno', '-fno-trapping-math', '-mavx512f', '-mavx512bw', '-mavx512dq',
+                              '-mavx512vl', '-mavx512vnni', '-mprefer-vector-width=512']
+    dispatch_macros = [('LU_NET_X86_DISPATCH', None)]
+else:
+    dispatch_macros = []
+
+kernel_libraries = [('lu_net_kernels_' + level, {'sources': [root + 'src/kernels_' + level + '.cpp'],
+                                                  'include_dirs': [root + 'include'],
+                                                  'cflags': ['-std=c++11', '-fPIC'] + flags})
+                    for level, flags in kernel_flags.items()]
 
 # 生成一个扩展模块
 net_module = Extension('_net',  # 模块名称，必须要有下划线
-                       sources=['net_wrap.cxx',
-                                '../../src/net.cpp',
-                                ],
+                       sources=['net.i'] + [root + f for f in [
+                           'src/net.cpp', 'src/function.cpp', 'src/io.cpp', 'proto/lu.pb.cc', 'src/quantize.cpp',
+                           'src/sparse_net.cpp', 'src/profiler.cpp', 'src/metrics.cpp', 'src/alloc_tracker.cpp',
+                           'src/weight_init.cpp', 'src/loss_function.cpp', 'src/activation_function.cpp',
+                           'src/cpu_dispatch.cpp', 'src/dropout_layer.cpp']],
+                       swig_opts=['-c++', '-I' + root + 'include'],
+                       include_dirs=['.', root + 'include'],
+                       define_macros=dispatch_macros,
+                       extra_compile_args=['-std=c++11', '-O2'],
+                       libraries=['protobuf', 'glog', 'gflags', 'pthread'],
                        )
 
 setup(name='net',   # 打包后的名称
-      version='0.Black_Footed_Albatross',
-      author='SWIG Docs',
-      description='Simple swig example from docs',
+      version='0.2',
+      description='Python bindings of lu_net, NumPy arrays in and out through the buffer protocol',
+      libraries=kernel_libraries,
       ext_modules=[net_module],  # 与上面的扩展模块名称一致
       py_modules=['net'],   # 需要打包的模块列表
+      install_requires=['numpy'],
     )
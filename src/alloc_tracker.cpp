@@ -0,0 +1,348 @@
+//
+// Created by 芦yafei  on 17/9/9.
+//
+
+#include "alloc_tracker.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <unistd.h>
+
+using namespace std;
+
+namespace lu_net {
+    namespace alloc_tracker {
+
+        // tag of the allocations of this thread, plain int so reading it never allocates
+        static thread_local int current_tag = 0;
+
+        const char *subsystem_name(subsystem s) {
+            static const char *names[kSubsystems] = {"other", "dataset", "params", "grads",
+                                                     "optimizer_state", "activations"};
+            return names[int(s)];
+        }
+
+
+        tag::tag(subsystem s) : previous_(current_tag) {
+            current_tag = int(s);
+        }
+
+
+        tag::~tag() {
+            current_tag = previous_;
+        }
+
+#ifdef LU_NET_TRACK_ALLOC
+
+        static const uint64_t kMagic = 0x6c755f6e65745f61ULL;
+
+        // in front of every tracked block, base is what the system allocator returned
+        struct header {
+            uint64_t magic;
+            void *base;
+            uint64_t size;
+            uint32_t tag;
+            uint32_t unused;
+        };
+
+        static_assert(sizeof(header) == 32, "the header keeps the blocks 16 byte aligned");
+
+        // constant initialized, so they work in allocations made before main
+        static atomic<long> allocations(0);
+        static atomic<long> frees(0);
+        static atomic<uint64_t> allocated_bytes(0);
+        static atomic<int64_t> in_use_bytes(0);
+        static atomic<int64_t> peak_bytes(0);
+        static atomic<int64_t> subsystem_bytes[kSubsystems];
+
+        static void count_alloc(uint64_t size, int tag) {
+            allocations.fetch_add(1, memory_order_relaxed);
+            allocated_bytes.fetch_add(size, memory_order_relaxed);
+            subsystem_bytes[tag].fetch_add(int64_t(size), memory_order_relaxed);
+            int64_t now = in_use_bytes.fetch_add(int64_t(size), memory_order_relaxed) + int64_t(size);
+            int64_t peak = peak_bytes.load(memory_order_relaxed);
+            while (now > peak && !peak_bytes.compare_exchange_weak(peak, now, memory_order_relaxed)) {}
+        }
+
+        static void count_free(uint64_t size, int tag) {
+            frees.fetch_add(1, memory_order_relaxed);
+            subsystem_bytes[tag].fetch_sub(int64_t(size), memory_order_relaxed);
+            in_use_bytes.fetch_sub(int64_t(size), memory_order_relaxed);
+        }
+
+#ifdef __GLIBC__
+        extern "C" {
+            void *__libc_malloc(size_t size);
+            void *__libc_realloc(void *ptr, size_t size);
+            void __libc_free(void *ptr);
+        }
+
+        static void *system_malloc(size_t size) { return __libc_malloc(size); }
+        static void *system_realloc(void *ptr, size_t size) { return __libc_realloc(ptr, size); }
+        static void system_free(void *ptr) { __libc_free(ptr); }
+#else
+        static void *system_malloc(size_t size) { return std::malloc(size); }
+        static void *system_realloc(void *ptr, size_t size) { return std::realloc(ptr, size); }
+        static void system_free(void *ptr) { std::free(ptr); }
+#endif
+
+        // header of a block returned by tracked_alloc, nullptr for blocks of the system allocator
+        static header *header_of(void *ptr) {
+            header *h = static_cast<header *>(ptr) - 1;
+            return h->magic == kMagic ? h : nullptr;
+        }
+
+        // size bytes aligned to align (a power of two), nullptr if out of memory
+        static void *tracked_alloc(size_t size, size_t align, int tag) {
+            align = align < 16 ? 16 : align;
+            const size_t extra = sizeof(header) + align - 1;
+            if (size > SIZE_MAX - extra) {
+                return nullptr;
+            }
+            void *base = system_malloc(size + extra);
+            if (base == nullptr) {
+                return nullptr;
+            }
+            uintptr_t block = (uintptr_t(base) + sizeof(header) + align - 1) & ~uintptr_t(align - 1);
+            header *h = reinterpret_cast<header *>(block) - 1;
+            h->magic = kMagic;
+            h->base = base;
+            h->size = size;
+            h->tag = uint32_t(tag);
+            count_alloc(size, tag);
+            return reinterpret_cast<void *>(block);
+        }
+
+        static void tracked_free(void *ptr) {
+            if (ptr == nullptr) {
+                return;
+            }
+            header *h = header_of(ptr);
+            if (h == nullptr) {
+                system_free(ptr);
+                return;
+            }
+            count_free(h->size, int(h->tag));
+            h->magic = 0;
+            system_free(h->base);
+        }
+
+        // a realloc keeps the tag of the block
+        static void *tracked_realloc(void *ptr, size_t size) {
+            if (ptr == nullptr) {
+                return tracked_alloc(size, 16, current_tag);
+            }
+            if (size == 0) {
+                tracked_free(ptr);
+                return nullptr;
+            }
+            header *h = header_of(ptr);
+            if (h == nullptr) {
+                return system_realloc(ptr, size);
+            }
+            void *block = tracked_alloc(size, 16, int(h->tag));
+            if (block != nullptr) {
+                memcpy(block, ptr, size < h->size ? size : h->size);
+                tracked_free(ptr);
+            }
+            return block;
+        }
+
+        static void *tracked_new(size_t size) {
+            for (;;) {
+                void *block = tracked_alloc(size, 16, current_tag);
+                if (block != nullptr) {
+                    return block;
+                }
+                new_handler handler = get_new_handler();
+                if (handler == nullptr) {
+                    throw bad_alloc();
+                }
+                handler();
+            }
+        }
+
+
+        bool enabled() {
+            return true;
+        }
+
+
+        usage current() {
+            usage u;
+            u.allocations = allocations.load(memory_order_relaxed);
+            u.frees = frees.load(memory_order_relaxed);
+            u.allocated_bytes = allocated_bytes.load(memory_order_relaxed);
+            u.in_use_bytes = in_use_bytes.load(memory_order_relaxed);
+            u.peak_bytes = peak_bytes.load(memory_order_relaxed);
+            for (int s = 0; s < kSubsystems; s++) {
+                u.subsystem_bytes[s] = subsystem_bytes[s].load(memory_order_relaxed);
+            }
+            return u;
+        }
+
+
+        void reset_peak() {
+            peak_bytes.store(in_use_bytes.load(memory_order_relaxed), memory_order_relaxed);
+        }
+
+#else
+
+        bool enabled() {
+            return false;
+        }
+
+
+        usage current() {
+            return usage();
+        }
+
+
+        void reset_peak() {}
+
+#endif
+
+        void print(ostream &out) {
+            if (!enabled()) {
+                return;
+            }
+            usage u = current();
+            ios::fmtflags flags = out.flags();
+            out << fixed << setprecision(2);
+            out << left << setw(20) << "subsystem" << right << setw(14) << "in use MB" << "\n";
+            for (int s = 0; s < kSubsystems; s++) {
+                out << left << setw(20) << subsystem_name(subsystem(s)) << right << setw(14)
+                    << u.subsystem_bytes[s] / (1024.0 * 1024.0) << "\n";
+            }
+            out << left << setw(20) << "total" << right << setw(14) << u.in_use_bytes / (1024.0 * 1024.0) << "\n";
+            out << left << setw(20) << "peak" << right << setw(14) << u.peak_bytes / (1024.0 * 1024.0) << "\n";
+            out << "allocations:" << u.allocations << " frees:" << u.frees
+                << " allocated MB:" << u.allocated_bytes / (1024.0 * 1024.0) << "\n";
+            out.flags(flags);
+        }
+    }
+}
+
+#ifdef LU_NET_TRACK_ALLOC
+
+using namespace lu_net::alloc_tracker;
+
+void *operator new(size_t size) {
+    return tracked_new(size);
+}
+
+void *operator new[](size_t size) {
+    return tracked_new(size);
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept {
+    return tracked_alloc(size, 16, current_tag);
+}
+
+void *operator new[](size_t size, const nothrow_t &) noexcept {
+    return tracked_alloc(size, 16, current_tag);
+}
+
+void operator delete(void *ptr) noexcept {
+    tracked_free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    tracked_free(ptr);
+}
+
+void operator delete(void *ptr, const nothrow_t &) noexcept {
+    tracked_free(ptr);
+}
+
+void operator delete[](void *ptr, const nothrow_t &) noexcept {
+    tracked_free(ptr);
+}
+
+#ifdef __GLIBC__
+// Eigen allocates with malloc, glibc lets the program replace the whole malloc family.
+extern "C" {
+
+void *malloc(size_t size) noexcept {
+    void *block = tracked_alloc(size, 16, current_tag);
+    if (block == nullptr) errno = ENOMEM;
+    return block;
+}
+
+void free(void *ptr) noexcept {
+    tracked_free(ptr);
+}
+
+void *calloc(size_t n, size_t size) noexcept {
+    if (size != 0 && n > SIZE_MAX / size) {
+        errno = ENOMEM;
+        return nullptr;
+    }
+    void *block = tracked_alloc(n * size, 16, current_tag);
+    if (block == nullptr) {
+        errno = ENOMEM;
+        return nullptr;
+    }
+    return memset(block, 0, n * size);
+}
+
+void *realloc(void *ptr, size_t size) noexcept {
+    void *block = tracked_realloc(ptr, size);
+    if (block == nullptr && size != 0) errno = ENOMEM;
+    return block;
+}
+
+void *reallocarray(void *ptr, size_t n, size_t size) noexcept {
+    if (size != 0 && n > SIZE_MAX / size) {
+        errno = ENOMEM;
+        return nullptr;
+    }
+    return realloc(ptr, n * size);
+}
+
+void *memalign(size_t align, size_t size) noexcept {
+    if (align == 0 || (align & (align - 1)) != 0) {
+        errno = EINVAL;
+        return nullptr;
+    }
+    void *block = tracked_alloc(size, align, current_tag);
+    if (block == nullptr) errno = ENOMEM;
+    return block;
+}
+
+void *aligned_alloc(size_t align, size_t size) noexcept {
+    return memalign(align, size);
+}
+
+int posix_memalign(void **ptr, size_t align, size_t size) noexcept {
+    if (align < sizeof(void *) || (align & (align - 1)) != 0) {
+        return EINVAL;
+    }
+    void *block = tracked_alloc(size, align, current_tag);
+    if (block == nullptr) {
+        return ENOMEM;
+    }
+    *ptr = block;
+    return 0;
+}
+
+void *valloc(size_t size) noexcept {
+    return memalign(size_t(sysconf(_SC_PAGESIZE)), size);
+}
+
+void *pvalloc(size_t size) noexcept {
+    size_t page = size_t(sysconf(_SC_PAGESIZE));
+    return memalign(page, (size + page - 1) / page * page);
+}
+
+size_t malloc_usable_size(void *ptr) noexcept {
+    header *h = ptr != nullptr ? header_of(ptr) : nullptr;
+    return h != nullptr ? size_t(h->size) : 0;
+}
+}
+#endif
+#endif
@@ -0,0 +1,104 @@
+//
+// Created by 芦yafei  on 17/8/28.
+//
+#include "cpu_dispatch.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+namespace lu_net {
+    namespace cpu_kernels {
+        namespace generic { extern const kernel_table table; }
+#if defined(LU_NET_X86_DISPATCH)
+        namespace sse42 { extern const kernel_table table; }
+        namespace avx2 { extern const kernel_table table; }
+        namespace avx512 { extern const kernel_table table; }
+#endif
+    }
+
+    // nullptr until the first kernels() or set_cpu_level(), atomic as threads may make the first call together
+    static std::atomic<const kernel_table *> current_kernels(nullptr);
+
+    cpu_level detect_cpu_level() {
+#if defined(LU_NET_X86_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+        // __builtin_cpu_supports also checks that the OS saves the wide registers
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+            __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl") &&
+            __builtin_cpu_supports("avx512vnni")) {
+            return cpu_level::avx512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return cpu_level::avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return cpu_level::sse42;
+        }
+#endif
+        return cpu_level::generic;
+    }
+
+    static const kernel_table *kernels_of(cpu_level level) {
+        switch (level) {
+#if defined(LU_NET_X86_DISPATCH)
+            case cpu_level::avx512:
+                return &cpu_kernels::avx512::table;
+            case cpu_level::avx2:
+                return &cpu_kernels::avx2::table;
+            case cpu_level::sse42:
+                return &cpu_kernels::sse42::table;
+#endif
+            default:
+                return &cpu_kernels::generic::table;
+        }
+    }
+
+    // level named by LU_NET_CPU_LEVEL, or the detected one
+    static cpu_level initial_level() {
+        const char *name = std::getenv("LU_NET_CPU_LEVEL");
+        if (name) {
+            for (int i = int(cpu_level::generic); i <= int(cpu_level::avx512); i++) {
+                if (std::strcmp(name, cpu_level_name(cpu_level(i))) == 0) {
+                    cpu_level detected = detect_cpu_level();
+                    return cpu_level(i) < detected ? cpu_level(i) : detected;
+                }
+            }
+        }
+        return detect_cpu_level();
+    }
+
+    cpu_level get_cpu_level() {
+        return kernels().level;
+    }
+
+    void set_cpu_level(cpu_level level) {
+        cpu_level detected = detect_cpu_level();
+        current_kernels.store(kernels_of(level < detected ? level : detected), std::memory_order_release);
+    }
+
+    const char *cpu_level_name(cpu_level level) {
+        switch (level) {
+            case cpu_level::sse42:
+                return "sse42";
+            case cpu_level::avx2:
+                return "avx2";
+            case cpu_level::avx512:
+                return "avx512";
+            default:
+                return "generic";
+        }
+    }
+
+    const kernel_table &kernels() {
+        // the first call picks the level, later calls only read the pointer
+        const kernel_table *table = current_kernels.load(std::memory_order_acquire);
+        if (!table) {
+            static const kernel_table *initial = kernels_of(initial_level());
+            // a set_cpu_level() between the load and here wins
+            if (current_kernels.compare_exchange_strong(table, initial, std::memory_order_acq_rel)) {
+                table = initial;
+            }
+        }
+        return *table;
+    }
+}
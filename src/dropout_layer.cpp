@@ -2,22 +2,56 @@
 // Created by 芦yafei  on 14/2/19.
 //
 #include "dropout_layer.h"
-#include "random.h"
+#include "cpu_dispatch.h"
+#include <algorithm>
 #include <eigen3/Eigen/Dense>
 
 namespace lu_net{
-    void dropout_layer::forward_propagation(const  Eigen::VectorXf &in_data, Eigen::VectorXf &out_data) {
+    void dropout_layer::new_mask(long size) {
+        mask_.resize((size + 31) / 32);
+        mask_size_ = size;
+        rng_.bernoulli(mask_.data(), size, keep_prob_);
+    }
+
+    void dropout_layer::forward_sigmoid(const float *z, float *a, long size) {
         if (phase_ == net_phase::train) {
-            mask_ = mask_.unaryExpr(ptr_fun(bernoulli(dropout_rate_)));
-            out_data = mask_.array() * scale_ * in_data.array();
+            new_mask(size);
+            kernels().sigmoid_dropout(z, a, mask_.data(), scale_, size);
         }
         else {
-            out_data = in_data;
+            kernels().sigmoid(z, a, size);
         }
     }
 
-    void dropout_layer::back_propagation(Eigen::VectorXf &out_grad, Eigen::VectorXf &in_grad) {
-        out_grad = in_grad.array() * mask_; //????how to memory the mask used by forward_propagation
+    // x * mask * scale, branch free since the bits are random
+    static void apply_mask(const uint32_t *mask, float scale, const float *x, float *out, long size) {
+        for (long i = 0; i < size; i++) {
+            out[i] = x[i] * (scale * float((mask[i / 32] >> (i % 32)) & 1u));
+        }
     }
-}
 
+    void dropout_layer::forward(const float *in, float *out, long size) {
+        if (phase_ == net_phase::train) {
+            new_mask(size);
+            apply_mask(mask_.data(), scale_, in, out, size);
+        }
+        else if (out != in) {
+            std::copy(in, in + size, out);
+        }
+    }
+
+    void dropout_layer::backward(const float *out_grad, float *in_grad, long size) {
+        assert(size == mask_size_);
+        apply_mask(mask_.data(), scale_, out_grad, in_grad, size);
+    }
+
+    void dropout_layer::forward_propagation(const  Eigen::VectorXf &in_data, Eigen::VectorXf &out_data) {
+        out_data.resize(in_data.size());
+        forward(in_data.data(), out_data.data(), in_data.size());
+    }
+
+    void dropout_layer::back_propagation(const Eigen::VectorXf &out_grad, Eigen::VectorXf &in_grad) {
+        in_grad.resize(out_grad.size());
+        backward(out_grad.data(), in_grad.data(), out_grad.size());
+    }
+}
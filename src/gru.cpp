@@ -0,0 +1,245 @@
+//
+// Created by 芦yafei  on 17/8/14.
+//
+
+#include "gru.h"
+#include "random.h"
+#include "alloc_tracker.h"
+
+namespace lu_net{
+    /**
+     * Gate nonlinearities and state update of one step for a block of samples, one column per sample.
+     * @gates: input side of [r; z; n] on entry, their activations and U_n h(t - 1) + b_hn on exit
+     * @gh: U h(t - 1) of [r; z; n]
+     * **/
+    static void gru_cell(Eigen::Ref<Eigen::MatrixXf> gates,
+                         const Eigen::Ref<const Eigen::MatrixXf> &gh,
+                         const Eigen::VectorXf &b_hn,
+                         const Eigen::Ref<const Eigen::MatrixXf> &h_prev,
+                         Eigen::Ref<Eigen::MatrixXf> h) {
+        const long H = h.rows();
+
+        // r and z use sigmoid
+        gates.topRows(2 * H) = (1.0 + (-(gates.topRows(2 * H) + gh.topRows(2 * H))).array().exp()).inverse();
+
+        // n uses tanh, the reset gate scales the recurrent part
+        gates.bottomRows(H) = gh.bottomRows(H);
+        gates.bottomRows(H).colwise() += b_hn;
+        gates.middleRows(2 * H, H) = (gates.middleRows(2 * H, H).array()
+                                      + gates.topRows(H).array() * gates.bottomRows(H).array()).tanh();
+
+        auto z = gates.middleRows(H, H).array();
+        auto n = gates.middleRows(2 * H, H).array();
+        h = (1.0 - z) * n + z * h_prev.array();
+    }
+
+    GruParam::GruParam(int mem_cell_num, int x_dim)
+            : mem_cell_num_(mem_cell_num),
+              x_dim_(x_dim),
+              concat_len_(mem_cell_num + x_dim)
+    {
+        // uniform in [-0.1, 0.1), as LstmParam
+        {
+            LU_NET_ALLOC_TAG(params);
+            w.resize(3 * mem_cell_num_, concat_len_);
+            b.resize(3 * mem_cell_num_);
+            b_hn.resize(mem_cell_num_);
+        }
+        uniform_rand(w.data(), w.data() + w.size(), -0.1f, 0.1f);
+        uniform_rand(b.data(), b.data() + b.size(), -0.1f, 0.1f);
+        uniform_rand(b_hn.data(), b_hn.data() + b_hn.size(), -0.1f, 0.1f);
+
+        LU_NET_ALLOC_TAG(grads);
+        w_diff = Eigen::MatrixXf::Zero(3 * mem_cell_num_, concat_len_);
+        b_diff = Eigen::VectorXf::Zero(3 * mem_cell_num_);
+        b_hn_diff = Eigen::VectorXf::Zero(mem_cell_num_);
+    }
+
+    GruParam::~GruParam() {}
+
+    void GruParam::param_update(float lr) {
+        optimizer::gradient_descent optimizer;
+
+        optimizer.update_w(w, w_diff, lr);
+        optimizer.update_b(b, b_diff, lr);
+        optimizer.update_b(b_hn, b_hn_diff, lr);
+
+        // reset diffs to zero
+        w_diff.setZero();
+        b_diff.setZero();
+        b_hn_diff.setZero();
+    }
+
+    GruSequenceState::GruSequenceState(int mem_cell_num, int x_dim, int batch_size)
+            : SequenceState(x_dim, 4 * mem_cell_num, mem_cell_num, 0, batch_size)
+    {
+
+    }
+
+    GruLayer::GruLayer(GruParam &gruParam)
+            :param_(gruParam),
+             state_(gruParam.mem_cell_num_, gruParam.x_dim_)
+    {
+
+    }
+
+    GruLayer::~GruLayer() {}
+
+    void GruLayer::farward_prop(const Eigen::MatrixXf &x, int batch_size) {
+        assert(x.rows() == param_.x_dim_ && x.cols() % batch_size == 0);
+        int steps = int(x.cols() / batch_size);
+
+        state_.reset(batch_size);
+        state_.reserve(steps);
+        for (int t = 0; t < steps; t++) {
+            state_.push_step();
+        }
+
+        farward_from(0, x);
+    }
+
+    void GruLayer::farward_prop(const Eigen::MatrixXf &x, const std::vector<int> &batch_sizes) {
+        assert(x.rows() == param_.x_dim_ && !batch_sizes.empty());
+        int steps = int(batch_sizes.size());
+
+        state_.reset(batch_sizes[0]);
+        state_.reserve(steps);
+        for (int t = 0; t < steps; t++) {
+            state_.push_step(batch_sizes[t]);
+        }
+        assert(x.cols() == state_.x().cols());
+
+        farward_from(0, x);
+    }
+
+    void GruLayer::farward_append(const Eigen::MatrixXf &x) {
+        assert(x.rows() == param_.x_dim_ && x.cols() % state_.batch_size() == 0);
+        int first = state_.steps();
+        int steps = int(x.cols() / state_.batch_size());
+
+        state_.reserve(first + steps);
+        for (int t = 0; t < steps; t++) {
+            state_.push_step();
+        }
+
+        farward_from(first, x);
+    }
+
+    void GruLayer::farward_from(int first, const Eigen::MatrixXf &x) {
+        const int H = param_.mem_cell_num_;
+        auto x_new = state_.x().rightCols(x.cols());
+        auto gates_new = state_.gates().rightCols(x.cols()).topRows(3 * H);
+
+        // w_x * x(t) + b for all new steps
+        x_new = x;
+        gates_new.noalias() = param_.w_x() * x;
+        gates_new.colwise() += param_.b;
+
+        for (int t = first; t < state_.steps(); t++) {
+            gh_.noalias() = param_.w_h() * state_.h_prev(t);
+            gru_cell(state_.gates(t), gh_, param_.b_hn, state_.h_prev(t), state_.h(t));
+        }
+    }
+
+    /**
+     * Back propagation through time of a minibatch, from the last step to the first.
+     * As LstmLayer::back_prop, the weight diffs of all steps are GEMMs at the end.
+     * **/
+    void GruLayer::back_prop(const Eigen::MatrixXf &top_diff_h) {
+        assert(top_diff_h.rows() == param_.mem_cell_num_ && top_diff_h.cols() == state_.h().cols());
+        const int H = param_.mem_cell_num_;
+        const int B = state_.batch_size();
+        const long cols = state_.h().cols();
+        LU_NET_ALLOC_TAG(activations);
+
+        // diff of h carried from step t + 1, step t only uses the first batch_size(t) columns
+        Eigen::MatrixXf diff_h = Eigen::MatrixXf::Zero(H, B);
+        dgx_.resize(3 * H, cols);
+        dgh_.resize(3 * H, cols);
+
+        for (int t = state_.steps() - 1; t >= 0; t--) {
+            const int Bt = state_.batch_size(t);
+            auto gates = state_.gates(t);
+            auto r = gates.topRows(H).array();
+            auto z = gates.middleRows(H, H).array();
+            auto n = gates.middleRows(2 * H, H).array();
+            auto ghn = gates.bottomRows(H).array();
+            auto h_prev = state_.h_prev(t).array();
+            auto dh = diff_h.leftCols(Bt);
+            auto dgx = dgx_.middleCols(state_.offset(t), Bt);
+            auto dgh = dgh_.middleCols(state_.offset(t), Bt);
+
+            dh += top_diff_h.middleCols(state_.offset(t), Bt);
+
+            // diffs of weighted inputs result before sigma / tanh function
+            dgx.bottomRows(H) = dh.array() * (1.0 - z) * (1.0 - n.square());
+            dgx.middleRows(H, H) = dh.array() * (h_prev - n) * (1.0 - z) * z;
+            dgx.topRows(H) = dgx.bottomRows(H).array() * ghn * (1.0 - r) * r;
+            dgh.topRows(2 * H) = dgx.topRows(2 * H);
+            dgh.bottomRows(H) = dgx.bottomRows(H).array() * r;
+
+            // diff of h(t - 1), not propagated past the stored steps
+            if (t > 0) {
+                dh = dh.array() * z;
+                dh.noalias() += param_.w_h().transpose() * dgh;
+            }
+        }
+
+        // diffs of inputs weights(used for param update), all steps at once
+        h_prev_.resize(H, cols);
+        for (int t = 0; t < state_.steps(); t++) {
+            h_prev_.middleCols(state_.offset(t), state_.batch_size(t)) = state_.h_prev(t);
+        }
+        param_.w_diff.leftCols(param_.x_dim_).noalias() += dgx_ * state_.x().transpose();
+        param_.w_diff.rightCols(H).noalias() += dgh_ * h_prev_.transpose();
+        param_.b_diff += dgx_.rowwise().sum();
+        param_.b_hn_diff += dgh_.bottomRows(H).rowwise().sum();
+    }
+
+    GruSession::GruSession(int mem_cell_num)
+            :h(Eigen::VectorXf::Zero(mem_cell_num))
+    {
+
+    }
+
+    GruInference::GruInference(const GruParam &gruParam)
+            :param_(gruParam)
+    {
+
+    }
+
+    GruInference::~GruInference() {}
+
+    GruSession GruInference::new_session() const {
+        return GruSession(param_.mem_cell_num_);
+    }
+
+    void GruInference::step(GruSession &session, const Eigen::VectorXf &x) {
+        std::vector<GruSession*> sessions(1, &session);
+        step(sessions, x);
+    }
+
+    void GruInference::step(const std::vector<GruSession*> &sessions, const Eigen::MatrixXf &x) {
+        assert(x.rows() == param_.x_dim_ && x.cols() == Eigen::Index(sessions.size()));
+        const int H = param_.mem_cell_num_;
+        const int B = int(sessions.size());
+
+        // gather h(t - 1) of all sessions
+        h_prev_.resize(H, B);
+        for (int n = 0; n < B; n++) {
+            h_prev_.col(n) = sessions[n]->h;
+        }
+
+        // gates of all sessions, one input GEMM and one recurrent GEMM
+        gates_.resize(4 * H, B);
+        gates_.topRows(3 * H).noalias() = param_.w_x() * x;
+        gates_.topRows(3 * H).colwise() += param_.b;
+        gh_.noalias() = param_.w_h() * h_prev_;
+        h_.resize(H, B);
+        gru_cell(gates_, gh_, param_.b_hn, h_prev_, h_);
+
+        for (int n = 0; n < B; n++) {
+            sessions[n]->h = h_.col(n);
+        }
+    }
+}
@@ -69,8 +69,9 @@ namespace lu_net {
 
     bool ReadProtoFromTextFile(const char *filename, Message *proto) {
         int fd = open(filename, O_RDONLY);
-        if (-1 != fd) {
+        if (-1 == fd) {
             cout << "File not found: " << filename << endl;
+            return false;
         }
         FileInputStream *input = new FileInputStream(fd);
         bool success = google::protobuf::TextFormat::Parse(input, proto);
@@ -81,10 +82,6 @@ namespace lu_net {
 
 
     void WriteProtoToTextFile(const Message &proto, const char *filename) {
-        string str;
-        google::protobuf::TextFormat::PrintToString(proto, &str);
-        printf("%s", str.c_str());
-
         int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
         FileOutputStream *output = new FileOutputStream(fd);
         google::protobuf::TextFormat::Print(proto, output);
@@ -95,12 +92,13 @@ namespace lu_net {
 
     bool ReadProtoFromBinaryFile(const char *filename, Message *proto) {
         int fd = open(filename, O_RDONLY);
-        if (-1 != fd) {
+        if (-1 == fd) {
             cout << "File not found: " << filename << endl;
+            return false;
         }
         ZeroCopyInputStream *raw_input = new FileInputStream(fd);
         CodedInputStream *coded_input = new CodedInputStream(raw_input);
-        coded_input->SetTotalBytesLimit(kProtoReadBytesLimit, 536870912);
+        coded_input->SetTotalBytesLimit(kProtoReadBytesLimit);
 
         bool success = proto->ParseFromCodedStream(coded_input);
 
@@ -0,0 +1,7 @@
+//
+// Created by 芦yafei  on 17/8/28.
+//
+// Kernels of cpu_dispatch.h for the AVX2 and FMA, built with -mavx2 -mfma.
+//
+#define LU_NET_KERNEL_LEVEL avx2
+#include "kernels_impl.h"
@@ -0,0 +1,7 @@
+//
+// Created by 芦yafei  on 17/8/28.
+//
+// Kernels of cpu_dispatch.h for the AVX-512 F/BW/DQ/VL and VNNI, built with -mavx512f -mavx512bw -mavx512dq -mavx512vl -mavx512vnni.
+//
+#define LU_NET_KERNEL_LEVEL avx512
+#include "kernels_impl.h"
@@ -0,0 +1,7 @@
+//
+// Created by 芦yafei  on 17/8/28.
+//
+// Kernels of cpu_dispatch.h for the baseline instruction set of the target.
+//
+#define LU_NET_KERNEL_LEVEL generic
+#include "kernels_impl.h"
@@ -0,0 +1,7 @@
+//
+// Created by 芦yafei  on 17/8/28.
+//
+// Kernels of cpu_dispatch.h for the SSE4.2, built with -msse4.2.
+//
+#define LU_NET_KERNEL_LEVEL sse42
+#include "kernels_impl.h"
@@ -0,0 +1,96 @@
+//
+// Created by 芦yafei  on 17/9/14.
+//
+
+#include "layer.h"
+#include "cpu_dispatch.h"
+
+using namespace std;
+using namespace Eigen;
+
+namespace lu_net {
+    namespace layers {
+
+        void fully_connected::setup(long in_size, float *value, float *grad) {
+            in_size_ = in_size;
+            W_ = value;
+            b_ = value + out_size_ * in_size;
+            dW_ = grad;
+            db_ = grad + out_size_ * in_size;
+        }
+
+
+        void fully_connected::init_params(random_stream &rng) {
+            weight_init::fill(init_, W_, out_size_, in_size_, rng);
+            bias().setZero();
+        }
+
+
+        void fully_connected::farward_prop(const const_batch_t &in, batch_t &out, net_phase phase) {
+            out.noalias() = weights() * in;
+            out.colwise() += bias();
+        }
+
+
+        void fully_connected::back_prop(const const_batch_t &in, const const_batch_t &out,
+                                        const const_batch_t &out_grad, batch_t *in_grad) {
+            Map<MatrixXf> dW(dW_, out_size_, in_size_);
+            Map<VectorXf> db(db_, out_size_);
+            dW.noalias() += out_grad * in.transpose();
+            db += out_grad.rowwise().sum();
+            if (in_grad != nullptr) {
+                in_grad->noalias() = weights().transpose() * out_grad;
+            }
+        }
+
+
+        void sigmoid::farward_prop(const const_batch_t &in, batch_t &out, net_phase phase) {
+            kernels().sigmoid(in.data(), out.data(), in.size());
+        }
+
+
+        void sigmoid::back_prop(const const_batch_t &in, const const_batch_t &out, const const_batch_t &out_grad,
+                                batch_t *in_grad) {
+            if (in_grad != nullptr) {
+                in_grad->array() = out_grad.array() * out.array() * (1.0f - out.array());
+            }
+        }
+
+
+        void relu::farward_prop(const const_batch_t &in, batch_t &out, net_phase phase) {
+            out = in.cwiseMax(0.0f);
+        }
+
+
+        void relu::back_prop(const const_batch_t &in, const const_batch_t &out, const const_batch_t &out_grad,
+                             batch_t *in_grad) {
+            if (in_grad != nullptr) {
+                in_grad->array() = (out.array() > 0.0f).select(out_grad.array(), 0.0f);
+            }
+        }
+
+
+        void dropout::setup(long in_size, float *value, float *grad) {
+            dropout_.reset(new dropout_layer(int(in_size), keep_prob_, net_phase::test));
+        }
+
+
+        void dropout::init_params(random_stream &rng) {
+            dropout_.reset(new dropout_layer(dropout_->in_size(), keep_prob_, net_phase::test, rng));
+        }
+
+
+        void dropout::farward_prop(const const_batch_t &in, batch_t &out, net_phase phase) {
+            dropout_->set_phase(phase);
+            dropout_->forward(in.data(), out.data(), in.size());
+        }
+
+
+        void dropout::back_prop(const const_batch_t &in, const const_batch_t &out, const const_batch_t &out_grad,
+                                batch_t *in_grad) {
+            if (in_grad != nullptr) {
+                dropout_->backward(out_grad.data(), in_grad->data(), out_grad.size());
+            }
+        }
+    }
+}
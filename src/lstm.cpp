@@ -3,32 +3,49 @@
 //
 
 #include "lstm.h"
+#include "random.h"
+#include "alloc_tracker.h"
 
 namespace lu_net{
+    /**
+     * Gate nonlinearities and state update of one step for a block of samples, one column per sample.
+     * @gates: weighted inputs of [g; i; f; o] on entry, their activations on exit
+     * **/
+    static void lstm_cell(Eigen::Ref<Eigen::MatrixXf> gates,
+                          const Eigen::Ref<const Eigen::MatrixXf> &s_prev,
+                          Eigen::Ref<Eigen::MatrixXf> s,
+                          Eigen::Ref<Eigen::MatrixXf> h) {
+        const long H = s.rows();
+
+        // g uses tanh, i, f and o use sigmoid
+        gates.topRows(H) = gates.topRows(H).array().tanh();
+        gates.bottomRows(3 * H) = (1.0 + (-gates.bottomRows(3 * H)).array().exp()).inverse();
+
+        auto g = gates.topRows(H).array();
+        auto i = gates.middleRows(H, H).array();
+        auto f = gates.middleRows(2 * H, H).array();
+        auto o = gates.bottomRows(H).array();
+        s = g * i + s_prev.array() * f;
+        h = s.array() * o;
+    }
+
     LstmParam::LstmParam(int mem_cell_num, int x_dim)
             : mem_cell_num_(mem_cell_num),
               x_dim_(x_dim),
               concat_len_(mem_cell_num + x_dim)
     {
-        wg = Eigen::MatrixXf::Zero(mem_cell_num_, concat_len_);
-        wi = Eigen::MatrixXf::Zero(mem_cell_num_, concat_len_);
-        wf = Eigen::MatrixXf::Zero(mem_cell_num_, concat_len_);
-        wo = Eigen::MatrixXf::Zero(mem_cell_num_, concat_len_);
-
-        bg = Eigen::VectorXf::Zero(mem_cell_num_);
-        bi = Eigen::VectorXf::Zero(mem_cell_num_);
-        bf = Eigen::VectorXf::Zero(mem_cell_num_);
-        bo = Eigen::VectorXf::Zero(mem_cell_num_);
-
-        wg_diff = Eigen::MatrixXf::Zero(mem_cell_num_, concat_len_);
-        wi_diff = Eigen::MatrixXf::Zero(mem_cell_num_, concat_len_);
-        wf_diff = Eigen::MatrixXf::Zero(mem_cell_num_, concat_len_);
-        wo_diff = Eigen::MatrixXf::Zero(mem_cell_num_, concat_len_);
+        // uniform in [-0.1, 0.1), as the python reference
+        {
+            LU_NET_ALLOC_TAG(params);
+            w.resize(4 * mem_cell_num_, concat_len_);
+            b.resize(4 * mem_cell_num_);
+        }
+        uniform_rand(w.data(), w.data() + w.size(), -0.1f, 0.1f);
+        uniform_rand(b.data(), b.data() + b.size(), -0.1f, 0.1f);
 
-        bg_diff = Eigen::VectorXf::Zero(mem_cell_num_);
-        bi_diff = Eigen::VectorXf::Zero(mem_cell_num_);
-        bf_diff = Eigen::VectorXf::Zero(mem_cell_num_);
-        bo_diff = Eigen::VectorXf::Zero(mem_cell_num_);
+        LU_NET_ALLOC_TAG(grads);
+        w_diff = Eigen::MatrixXf::Zero(4 * mem_cell_num_, concat_len_);
+        b_diff = Eigen::VectorXf::Zero(4 * mem_cell_num_);
     }
 
     LstmParam::~LstmParam() {}
@@ -36,124 +53,290 @@ namespace lu_net{
     void LstmParam::param_update(float lr) {
         optimizer::gradient_descent optimizer;
 
-        optimizer.update_w(wg, wg_diff, lr);
-        optimizer.update_w(wi, wi_diff, lr);
-        optimizer.update_w(wf, wf_diff, lr);
-        optimizer.update_w(wo, wo_diff, lr);
-        optimizer.update_b(bg, bg_diff, lr);
-        optimizer.update_b(bi, bi_diff, lr);
-        optimizer.update_b(bf, bf_diff, lr);
-        optimizer.update_b(bo, bo_diff, lr);
+        optimizer.update_w(w, w_diff, lr);
+        optimizer.update_b(b, b_diff, lr);
 
         // reset diffs to zero
-        wg_diff.setZero();
-        wi_diff.setZero();
-        wf_diff.setZero();
-        wo_diff.setZero();
-        bg_diff.setZero();
-        bi_diff.setZero();
-        bf_diff.setZero();
-        bo_diff.setZero();
-    }
-
-    LstmState::LstmState(int mem_cell_num, int x_dim) {
-        g = Eigen::VectorXf::Zero(mem_cell_num);
-        i = Eigen::VectorXf::Zero(mem_cell_num);
-        f = Eigen::VectorXf::Zero(mem_cell_num);
-        o = Eigen::VectorXf::Zero(mem_cell_num);
-        s = Eigen::VectorXf::Zero(mem_cell_num);
-        h = Eigen::VectorXf::Zero(mem_cell_num);
-        bottom_diff_h = Eigen::VectorXf::Zero(mem_cell_num);
-        bottom_diff_s = Eigen::VectorXf::Zero(mem_cell_num);
-    }
-
-    LstmState::~LstmState() {}
-
-    LstmNode::LstmNode(LstmParam &lstmParam, LstmState &lstmState)
+        w_diff.setZero();
+        b_diff.setZero();
+    }
+
+    LstmSequenceState::LstmSequenceState(int mem_cell_num, int x_dim, int batch_size)
+            : SequenceState(x_dim, 4 * mem_cell_num, mem_cell_num, mem_cell_num, batch_size)
+    {
+
+    }
+
+    LstmLayer::LstmLayer(LstmParam &lstmParam)
             :param_(lstmParam),
-             state_(lstmState)
+             state_(lstmParam.mem_cell_num_, lstmParam.x_dim_)
     {
-        // non-recurrent input concatenated with recurrent input
-        //xc_ = ;
+
     }
 
+    LstmLayer::~LstmLayer() {}
+
     /**
-     * Forward propagation
+     * Forward propagation of a minibatch.
+     * Input projection of every step first, then one recurrent GEMM and the gate
+     * nonlinearities of the whole minibatch per step.
      * **/
-    void LstmNode::farward_prop(Eigen::VectorXf x) {
-        Eigen::VectorXf s_prev = Eigen::VectorXf::Zero(state_.s.size());
-        Eigen::VectorXf h_prev = Eigen::VectorXf::Zero(state_.h.size());
+    void LstmLayer::farward_prop(const Eigen::MatrixXf &x, int batch_size) {
+        assert(x.rows() == param_.x_dim_ && x.cols() % batch_size == 0);
+        int steps = int(x.cols() / batch_size);
+
+        state_.reset(batch_size);
+        state_.reserve(steps);
+        for (int t = 0; t < steps; t++) {
+            state_.push_step();
+        }
+
+        farward_from(0, x);
+    }
+
+    void LstmLayer::farward_prop(const Eigen::MatrixXf &x, const std::vector<int> &batch_sizes) {
+        assert(x.rows() == param_.x_dim_ && !batch_sizes.empty());
+        int steps = int(batch_sizes.size());
+
+        state_.reset(batch_sizes[0]);
+        state_.reserve(steps);
+        for (int t = 0; t < steps; t++) {
+            state_.push_step(batch_sizes[t]);
+        }
+        assert(x.cols() == state_.x().cols());
+
+        farward_from(0, x);
+    }
+
+    void LstmLayer::farward_append(const Eigen::MatrixXf &x) {
+        assert(x.rows() == param_.x_dim_ && x.cols() % state_.batch_size() == 0);
+        int first = state_.steps();
+        int steps = int(x.cols() / state_.batch_size());
+
+        state_.reserve(first + steps);
+        for (int t = 0; t < steps; t++) {
+            state_.push_step();
+        }
 
-        farward_prop(x, s_prev, h_prev);
+        farward_from(first, x);
+    }
+
+    void LstmLayer::farward_from(int first, const Eigen::MatrixXf &x) {
+        auto x_new = state_.x().rightCols(x.cols());
+        auto gates_new = state_.gates().rightCols(x.cols());
+
+        // w_x * x(t) + b for all new steps
+        x_new = x;
+        gates_new.noalias() = param_.w_x() * x;
+        gates_new.colwise() += param_.b;
+
+        for (int t = first; t < state_.steps(); t++) {
+            cell_farward(t);
+        }
+    }
+
+    void LstmLayer::farward_step(const Eigen::MatrixXf &x) {
+        assert(x.rows() == param_.x_dim_ && x.cols() == state_.batch_size());
+        int t = state_.push_step();
+
+        state_.x(t) = x;
+        state_.gates(t).noalias() = param_.w_x() * x;
+        state_.gates(t).colwise() += param_.b;
+        cell_farward(t);
+    }
+
+    void LstmLayer::cell_farward(int t) {
+        state_.gates(t).noalias() += param_.w_h() * state_.h_prev(t);
+        lstm_cell(state_.gates(t), state_.s_prev(t), state_.s(t), state_.h(t));
     }
 
     /**
-     * Forward propagation
-     * @s_prev: s in t - 1
-     * @h_prev: h in t - 1
+     * Back propagation through time of a minibatch, from the last step to the first.
+     *
+     * Only the diffs of h and s have to go step by step. The diffs of the weighted inputs of all
+     * steps are kept, and the weight diffs of the whole minibatch are one GEMM dgates * xc^T at the
+     * end, xc being the concatenated inputs [x(t), h(t - 1)] of all steps.
      * **/
-    void LstmNode::farward_prop(Eigen::VectorXf x,
-                                Eigen::VectorXf s_prev,
-                                Eigen::VectorXf h_prev) {
-        // Save data for use in backprop
-        s_prev_ = s_prev;
-        h_prev_ = h_prev;
-
-        // Concatenate x(t) and h(t - 1)
-        Eigen::VectorXf xc;
-        xc << x, h_prev;
-
-        state_.g = activation::tanh::f(param_.wg * xc + param_.bg); //tanh output can increase or decrease s
-        state_.i = activation::sigmoid::f(param_.wi * xc + param_.bi);
-        state_.f = activation::sigmoid::f(param_.wf * xc + param_.bf);
-        state_.o = activation::sigmoid::f(param_.wo * xc + param_.bo);
-        state_.s = state_.g.array() * state_.i.array() + s_prev.array() * state_.f.array();
-        state_.h = state_.s.array() * state_.o.array();
-
-        xc_ = xc;
-    }
-
-    void LstmNode::top_diff_is(Eigen::VectorXf top_diff_h, Eigen::VectorXf top_diff_s) {
-        // notice that top_diff_s is carried along the constant error carousel
-        Eigen::VectorXf ds = state_.o.array() * top_diff_h.array() + top_diff_s.array();
-
-        // 1.diffs of o i g f
-        Eigen::VectorXf dO = state_.s.array() * top_diff_h.array();
-        Eigen::VectorXf di = state_.g.array() * ds.array();
-        Eigen::VectorXf dg = state_.i.array() * ds.array();
-        Eigen::VectorXf df = s_prev_.array() * ds.array();
-
-        // 2.diffs of weighted inputs result before sigma / tanh function
-        Eigen::VectorXf di_input = (1.0 - state_.i.array()) * state_.i.array() * di.array();
-        Eigen::VectorXf df_input = (1.0 - state_.f.array()) * state_.f.array() * df.array();
-        Eigen::VectorXf do_input = (1.0 - state_.o.array()) * state_.o.array() * dO.array();
-        Eigen::VectorXf dg_input = (1.0 - state_.g.array().square()) * dg.array();
-
-        // 3.diffs of inputs weights(used for param update)
-        param_.wi_diff += di_input * xc_;
-        param_.wf_diff += df_input * xc_;
-        param_.wo_diff += do_input * xc_;
-        param_.wg_diff += dg_input * xc_;
-        param_.bi_diff += di_input;
-        param_.bf_diff += df_input;
-        param_.bo_diff += do_input;
-        param_.bg_diff += dg_input;
-
-        // 4.diffs of inputs
-        Eigen::VectorXf dxc = Eigen::VectorXf::Zero(xc_.size());
-        dxc += param_.wi.transpose() * di_input;
-        dxc += param_.wf.transpose() * df_input;
-        dxc += param_.wo.transpose() * do_input;
-        dxc += param_.wg.transpose() * dg_input;
-
-        // 5.save bottom diffs
-        state_.bottom_diff_s = ds * state_.f;
-        //state_.bottom_diff_x = dxc[0 : param_.x_dim_];
-        state_.bottom_diff_h = dxc.segment(param_.x_dim_, xc_.size() - 1);
-    }
-
-    LstmNetwork::LstmNetwork(LstmParam lstmParam)
-            :lstmParam_(lstmParam)
+    void LstmLayer::back_prop(const Eigen::MatrixXf &top_diff_h) {
+        assert(top_diff_h.rows() == param_.mem_cell_num_ && top_diff_h.cols() == state_.h().cols());
+        const int H = param_.mem_cell_num_;
+        const int B = state_.batch_size();
+        const long cols = state_.h().cols();
+        LU_NET_ALLOC_TAG(activations);
+
+        // diffs carried from step t + 1, s along the constant error carousel.
+        // Step t only uses the first batch_size(t) columns, the columns of sequences which end at
+        // step t are still zero when it is reached.
+        Eigen::MatrixXf diff_h = Eigen::MatrixXf::Zero(H, B);
+        Eigen::MatrixXf diff_s = Eigen::MatrixXf::Zero(H, B);
+        Eigen::MatrixXf ds(H, B);
+        dgates_.resize(4 * H, cols);
+
+        for (int t = state_.steps() - 1; t >= 0; t--) {
+            const int Bt = state_.batch_size(t);
+            auto gates = state_.gates(t);
+            auto g = gates.topRows(H).array();
+            auto i = gates.middleRows(H, H).array();
+            auto f = gates.middleRows(2 * H, H).array();
+            auto o = gates.bottomRows(H).array();
+            auto dh = diff_h.leftCols(Bt);
+            auto dst = ds.leftCols(Bt);
+            auto dg = dgates_.middleCols(state_.offset(t), Bt);
+
+            dh += top_diff_h.middleCols(state_.offset(t), Bt);
+            dst = o * dh.array() + diff_s.leftCols(Bt).array();
+
+            // diffs of weighted inputs result before sigma / tanh function
+            dg.topRows(H) = (1.0 - g.square()) * i * dst.array();
+            dg.middleRows(2 * H, H) = (1.0 - f) * f * state_.s_prev(t).array() * dst.array();
+            dg.middleRows(H, H) = (1.0 - i) * i * g * dst.array();
+            dg.bottomRows(H) = (1.0 - o) * o * state_.s(t).array() * dh.array();
+
+            // diffs of h(t - 1) and s(t - 1), not propagated past the stored steps
+            if (t > 0) {
+                dh.noalias() = param_.w_h().transpose() * dg;
+                diff_s.leftCols(Bt) = dst.array() * f;
+            }
+        }
+
+        // diffs of inputs weights(used for param update), all steps at once
+        xc_.resize(param_.concat_len_, cols);
+        xc_.topRows(param_.x_dim_) = state_.x();
+        for (int t = 0; t < state_.steps(); t++) {
+            xc_.bottomRows(H).middleCols(state_.offset(t), state_.batch_size(t)) = state_.h_prev(t);
+        }
+        param_.w_diff.noalias() += dgates_ * xc_.transpose();
+        param_.b_diff += dgates_.rowwise().sum();
+    }
+
+    LstmTbpttTrainer::LstmTbpttTrainer(LstmParam &lstmParam, int k1, int k2, float lr)
+            :lr_(lr),
+             param_(lstmParam),
+             lstm_layer_(lstmParam),
+             k1_(k1),
+             k2_(k2)
+    {
+        assert(0 < k1 && k1 <= k2);
+    }
+
+    LstmTbpttTrainer::~LstmTbpttTrainer() {}
+
+    void LstmTbpttTrainer::reset() {
+        lstm_layer_.reset();
+        pending_ = 0;
+        running_ = false;
+    }
+
+    float LstmTbpttTrainer::train(const Eigen::MatrixXf &x, const Eigen::MatrixXf &y, int batch_size) {
+        assert(x.cols() == y.cols() && y.rows() <= param_.mem_cell_num_);
+        const int B = batch_size;
+        const int H = param_.mem_cell_num_;
+        const int steps = int(x.cols() / B);
+
+        // with k1 == k2 no step is stored between windows, the carried states still are
+        if (!running_) {
+            lstm_layer_.reset(B);
+            running_ = true;
+        }
+        assert(lstm_layer_.batch_size() == B);
+        y_pending_.resize(y.rows(), k1_ * B);
+
+        MSE mse;
+        float sum_loss = 0.0;
+        int windows = 0;
+        int t = 0;
+        while (t < steps) {
+            // forward the rest of the window, at most k1 steps are pending
+            int n = std::min(k1_ - pending_, steps - t);
+            lstm_layer_.farward_append(x.middleCols(t * B, n * B));
+            y_pending_.middleCols(pending_ * B, n * B) = y.middleCols(t * B, n * B);
+            pending_ += n;
+            t += n;
+
+            if (pending_ < k1_) {
+                break;
+            }
+
+            // loss of the last k1 steps, back propagated through all stored steps
+            int stored = lstm_layer_.steps();
+            Eigen::MatrixXf top_diff_h = Eigen::MatrixXf::Zero(H, stored * B);
+            auto h = lstm_layer_.h().rightCols(k1_ * B);
+            auto top = top_diff_h.rightCols(k1_ * B);
+            float loss = 0.0;
+            for (int c = 0; c < k1_ * B; c++) {
+                for (int r = 0; r < y.rows(); r++) {
+                    loss += mse.f(h(r, c), y_pending_(r, c));
+                    top(r, c) = mse.df(h(r, c), y_pending_(r, c));
+                }
+            }
+            sum_loss += loss / (k1_ * B);
+            windows++;
+
+            lstm_layer_.back_prop(top_diff_h);
+            param_.param_update(lr_);
+
+            // keep the k2 - k1 newest steps for the next window
+            lstm_layer_.state().drop_front(std::max(0, stored - (k2_ - k1_)));
+            pending_ = 0;
+        }
+
+        return windows > 0 ? sum_loss / windows : 0;
+    }
+
+    LstmSession::LstmSession(int mem_cell_num)
+            :s(Eigen::VectorXf::Zero(mem_cell_num)),
+             h(Eigen::VectorXf::Zero(mem_cell_num))
+    {
+
+    }
+
+    LstmInference::LstmInference(const LstmParam &lstmParam)
+            :param_(lstmParam)
+    {
+
+    }
+
+    LstmInference::~LstmInference() {}
+
+    LstmSession LstmInference::new_session() const {
+        return LstmSession(param_.mem_cell_num_);
+    }
+
+    void LstmInference::step(LstmSession &session, const Eigen::VectorXf &x) {
+        std::vector<LstmSession*> sessions(1, &session);
+        step(sessions, x);
+    }
+
+    void LstmInference::step(const std::vector<LstmSession*> &sessions, const Eigen::MatrixXf &x) {
+        assert(x.rows() == param_.x_dim_ && x.cols() == Eigen::Index(sessions.size()));
+        const int H = param_.mem_cell_num_;
+        const int B = int(sessions.size());
+
+        // gather [x(t), h(t - 1)] and s(t - 1) of all sessions
+        xc_.resize(param_.concat_len_, B);
+        s_prev_.resize(H, B);
+        xc_.topRows(param_.x_dim_) = x;
+        for (int n = 0; n < B; n++) {
+            xc_.col(n).tail(H) = sessions[n]->h;
+            s_prev_.col(n) = sessions[n]->s;
+        }
+
+        // all gates of all sessions in one GEMM
+        gates_.noalias() = param_.w * xc_;
+        gates_.colwise() += param_.b;
+        s_.resize(H, B);
+        h_.resize(H, B);
+        lstm_cell(gates_, s_prev_, s_, h_);
+
+        for (int n = 0; n < B; n++) {
+            sessions[n]->s = s_.col(n);
+            sessions[n]->h = h_.col(n);
+        }
+    }
+
+    LstmNetwork::LstmNetwork(LstmParam &lstmParam)
+            :lstmParam_(lstmParam),
+             lstm_layer_(lstmParam)
     {
 
     }
@@ -166,59 +349,28 @@ namespace lu_net{
      * To update parameters,call self.lstm_param.apply_diff()
      * **/
     float LstmNetwork::compute_loss(const Eigen::VectorXf &y_list, MSE mse) {
-        assert(y_list.size() == x_list.size());
-        int idx = x_list.size() - 1;
-
-        // First node only gets diffs from label ...
-        float loss = mse.f(lstm_node_list[idx]->state_.h[0], y_list[idx]);
-        Eigen::VectorXf diff_h = Eigen::VectorXf::Zero(lstmParam_.mem_cell_num_);
-        diff_h[0] = mse.df(lstm_node_list[idx]->state_.h[0], y_list[idx]);
-        // Here s is not affecting loss due to h(t+Black_Footed_Albatross), hence we set equal to zero
-        Eigen::VectorXf diff_s = Eigen::VectorXf::Zero(lstmParam_.mem_cell_num_);
-        lstm_node_list[idx]->top_diff_is(diff_h, diff_s);
-        idx -= 1;
-
-        // following nodes also get diffs from next nodes, hence we add diffs to diff_h
-        // we also propagate error along constant error carousel using diff_s
-        while(idx >= 0)
-        {
-            loss += mse.f(lstm_node_list[idx]->state_.h[0], y_list[idx]);
-            diff_h[0] = mse.df(lstm_node_list[idx]->state_.h[0], y_list[idx]);
-            diff_h += lstm_node_list[idx + 1]->state_.bottom_diff_h;
-            diff_s = lstm_node_list[idx + 1]->state_.bottom_diff_s;
-            lstm_node_list[idx]->top_diff_is(diff_h, diff_s);
-            idx -= 1;
+        assert(y_list.size() == lstm_layer_.steps());
+        Eigen::MatrixXf::ConstColsBlockXpr h = lstm_layer_.h();
+
+        // only the first element of h gets diffs from label, the rest come from next nodes
+        float loss = 0.0;
+        Eigen::MatrixXf top_diff_h = Eigen::MatrixXf::Zero(lstmParam_.mem_cell_num_, y_list.size());
+        for (int idx = 0; idx < y_list.size(); idx++) {
+            loss += mse.f(h(0, idx), y_list[idx]);
+            top_diff_h(0, idx) = mse.df(h(0, idx), y_list[idx]);
         }
 
+        lstm_layer_.back_prop(top_diff_h);
+
         return loss;
     }
 
     void LstmNetwork::build_x_list(const Eigen::VectorXf& x) {
-        x_list.emplace_back(x);
-
-        // Add node with add x;
-        if (x_list.size() > lstm_node_list.size()) {
-            //need to add new lstm node, create new state mem
-            LstmState lstmState = LstmState(lstmParam_.mem_cell_num_, lstmParam_.x_dim_);
-
-            LstmNode* lstmNode = new LstmNode(lstmParam_, lstmState);
-            lstm_node_list.emplace_back(lstmNode);
-        }
-
-        // Get index of most recent x input
-        int idx = x_list.size() -1;
-
-        // Forward propagation
-        if (0 == idx) {
-            // no recurrent inputs yet
-            lstm_node_list[idx]->farward_prop(x);
-        } else {
-            Eigen::VectorXf s_prev = lstm_node_list[idx - 1]->state_.s;
-            Eigen::VectorXf h_prev = lstm_node_list[idx - 1]->state_.h;
-            lstm_node_list[idx]->farward_prop(x, s_prev, h_prev);
-        }
+        // Forward propagation of the new step, no recurrent inputs for the first one
+        lstm_layer_.farward_step(x);
     }
 
-
-
+    void LstmNetwork::x_list_clear() {
+        lstm_layer_.reset();
+    }
 }
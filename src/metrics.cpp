@@ -0,0 +1,197 @@
+//
+// Created by 芦yafei  on 17/9/4.
+//
+
+#include "metrics.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <sys/resource.h>
+
+using namespace std;
+
+namespace lu_net {
+    namespace metrics {
+
+        static const char *kPhaseNames[kPhases] = {"data", "farward", "backward", "update"};
+
+        training_metrics::training_metrics(long interval, const string &json_file)
+                : interval(interval), json_file(json_file) {}
+
+
+        void training_metrics::begin(const vector<int> &layers_neuron_num) {
+            const size_t num_layers = layers_neuron_num.size();
+            farward_flops_.assign(num_layers, 0);
+            backward_flops_.assign(num_layers, 0);
+            for (size_t i = 1; i < num_layers; i++) {
+                double w = double(layers_neuron_num[i - 1]) * layers_neuron_num[i];
+                farward_flops_[i] = 2 * w;
+                // gradient of the weights, then the error of the layer below except for the first layer
+                backward_flops_[i] = i > 1 ? 4 * w : 2 * w;
+            }
+            farward_seconds_.assign(num_layers, 0);
+            backward_seconds_.assign(num_layers, 0);
+            fill(phase_seconds_, phase_seconds_ + kPhases, 0.0);
+            batches_ = 0;
+            samples_ = 0;
+            sum_loss_ = 0;
+            last_ = report();
+            alloc_tracker::reset_peak();
+            allocations_ = alloc_tracker::current().allocations;
+            start_ = clock::now();
+
+            if (json_.is_open()) {
+                json_.close();
+            }
+            if (!json_file.empty()) {
+                json_.open(json_file, ios::app);
+            }
+        }
+
+
+        void training_metrics::batch_end(int epoch, long iteration, int samples, float loss) {
+            epoch_ = epoch;
+            iteration_ = iteration;
+            batches_++;
+            samples_ += samples;
+            sum_loss_ += loss;
+            if (interval > 0 && batches_ >= interval) {
+                make_report();
+            }
+        }
+
+
+        void training_metrics::end() {
+            if (batches_ > 0) {
+                make_report();
+            }
+            if (json_.is_open()) {
+                json_.close();
+            }
+        }
+
+
+        double training_metrics::peak_rss_mb() {
+            struct rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) != 0) {
+                return 0;
+            }
+#ifdef __APPLE__
+            return usage.ru_maxrss / (1024.0 * 1024.0);     // bytes
+#else
+            return usage.ru_maxrss / 1024.0;                // kilobytes
+#endif
+        }
+
+
+        void training_metrics::make_report() {
+            clock::time_point now = clock::now();
+            report r;
+            r.epoch = epoch_;
+            r.iteration = iteration_;
+            r.batches = batches_;
+            r.samples = samples_;
+            r.seconds = chrono::duration<double>(now - start_).count();
+            r.samples_per_sec = r.seconds > 0 ? samples_ / r.seconds : 0;
+            r.batches_per_sec = r.seconds > 0 ? batches_ / r.seconds : 0;
+            r.loss = float(sum_loss_ / batches_);
+            copy(phase_seconds_, phase_seconds_ + kPhases, r.phase_seconds);
+            r.farward_gflops.assign(farward_flops_.size(), 0);
+            r.backward_gflops.assign(backward_flops_.size(), 0);
+            for (size_t i = 1; i < farward_flops_.size(); i++) {
+                if (farward_seconds_[i] > 0) {
+                    r.farward_gflops[i] = farward_flops_[i] * samples_ / farward_seconds_[i] * 1e-9;
+                }
+                if (backward_seconds_[i] > 0) {
+                    r.backward_gflops[i] = backward_flops_[i] * samples_ / backward_seconds_[i] * 1e-9;
+                }
+            }
+            r.peak_rss_mb = peak_rss_mb();
+            if (alloc_tracker::enabled()) {
+                const double mb = 1.0 / (1024 * 1024);
+                alloc_tracker::usage u = alloc_tracker::current();
+                r.allocations_per_batch = double(u.allocations - allocations_) / batches_;
+                r.heap_mb = u.in_use_bytes * mb;
+                r.heap_peak_mb = u.peak_bytes * mb;
+                for (int s = 0; s < alloc_tracker::kSubsystems; s++) {
+                    r.subsystem_mb[s] = u.subsystem_bytes[s] * mb;
+                }
+            }
+
+            last_ = r;
+            emit(r);
+
+            // next interval
+            fill(farward_seconds_.begin(), farward_seconds_.end(), 0.0);
+            fill(backward_seconds_.begin(), backward_seconds_.end(), 0.0);
+            fill(phase_seconds_, phase_seconds_ + kPhases, 0.0);
+            batches_ = 0;
+            samples_ = 0;
+            sum_loss_ = 0;
+            allocations_ = alloc_tracker::current().allocations;
+            start_ = clock::now();
+        }
+
+
+        static string join(const vector<double> &values, const char *separator) {
+            ostringstream out;
+            for (size_t i = 1; i < values.size(); i++) {
+                out << (i > 1 ? separator : "") << values[i];
+            }
+            return out.str();
+        }
+
+
+        void training_metrics::emit(const report &r) {
+            double timed = 0;
+            ostringstream phases;
+            for (int p = 0; p < kPhases; p++) {
+                timed += r.phase_seconds[p];
+                phases << " " << kPhaseNames[p] << ":" << int(100 * r.phase_seconds[p] / r.seconds + 0.5) << "%";
+            }
+
+            LOG(INFO) << "iteration:" << r.iteration << " samples/s:" << r.samples_per_sec
+                      << " batches/s:" << r.batches_per_sec << " loss:" << r.loss
+                      << " time" << phases.str() << " other:" << int(100 * (r.seconds - timed) / r.seconds + 0.5) << "%"
+                      << " farward GFLOP/s:" << join(r.farward_gflops, ",")
+                      << " backward GFLOP/s:" << join(r.backward_gflops, ",")
+                      << " peak RSS MB:" << r.peak_rss_mb;
+            if (alloc_tracker::enabled()) {
+                ostringstream heap;
+                for (int s = 0; s < alloc_tracker::kSubsystems; s++) {
+                    heap << " " << alloc_tracker::subsystem_name(alloc_tracker::subsystem(s)) << ":" << r.subsystem_mb[s];
+                }
+                LOG(INFO) << "allocations/batch:" << r.allocations_per_batch << " heap MB:" << r.heap_mb
+                          << " heap peak MB:" << r.heap_peak_mb << " in use MB" << heap.str();
+            }
+
+            if (!json_.is_open()) {
+                return;
+            }
+            json_ << "{\"epoch\":" << r.epoch << ",\"iteration\":" << r.iteration
+                  << ",\"batches\":" << r.batches << ",\"samples\":" << r.samples
+                  << ",\"seconds\":" << r.seconds << ",\"samples_per_sec\":" << r.samples_per_sec
+                  << ",\"batches_per_sec\":" << r.batches_per_sec << ",\"loss\":" << r.loss
+                  << ",\"phase_seconds\":{";
+            for (int p = 0; p < kPhases; p++) {
+                json_ << "\"" << kPhaseNames[p] << "\":" << r.phase_seconds[p] << ",";
+            }
+            json_ << "\"other\":" << max(0.0, r.seconds - timed) << "}"
+                  << ",\"farward_gflops\":[" << join(r.farward_gflops, ",") << "]"
+                  << ",\"backward_gflops\":[" << join(r.backward_gflops, ",") << "]"
+                  << ",\"peak_rss_mb\":" << r.peak_rss_mb;
+            if (alloc_tracker::enabled()) {
+                json_ << ",\"allocations_per_batch\":" << r.allocations_per_batch << ",\"heap_mb\":" << r.heap_mb
+                      << ",\"heap_peak_mb\":" << r.heap_peak_mb << ",\"subsystem_mb\":{";
+                for (int s = 0; s < alloc_tracker::kSubsystems; s++) {
+                    json_ << (s > 0 ? "," : "") << "\"" << alloc_tracker::subsystem_name(alloc_tracker::subsystem(s))
+                          << "\":" << r.subsystem_mb[s];
+                }
+                json_ << "}";
+            }
+            json_ << "}\n";
+            json_.flush();
+        }
+    }
+}
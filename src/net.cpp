@@ -10,17 +10,37 @@
 #include "function.h"
 #include "io.h"
 #include "Matrix.h"
+#include "cpu_dispatch.h"
 #include "loss_function.h"
 #include "random.h"
 #include <glog/logging.h>
 #include "activation_function.h"
 #include "optimizer.h"
+#include "lr_scheduler.h"
+#include "pruning.h"
+#include "profiler.h"
+#include "metrics.h"
+#include "alloc_tracker.h"
+#include "weight_init.h"
+#include "dropout_layer.h"
+#include <algorithm>
 
 using namespace std;
 using namespace Eigen;
 
 namespace lu_net {
 
+    // Parameter blocks are padded to kParamAlign floats (64 bytes), so every block sits at the same offset
+    // modulo 64 bytes as the start of the flat buffer. The buffer itself is only as aligned as Eigen makes it.
+    static const long kParamAlign = 16;
+
+    static long align_size(long size) {
+        return (size + kParamAlign - 1) / kParamAlign * kParamAlign;
+    }
+
+    // Number of samples farward at once by test and validation.
+    static const size_t kTestBatchSize = 256;
+
     void Net::initNet(std::vector<int> layers_neuron_num, float learning_rate, float lmbda) {
         this->layers_neuron_num = layers_neuron_num;
         num_layers = layers_neuron_num.size();
@@ -31,34 +51,158 @@ namespace lu_net {
 
         // Resize(int n,element)表示调整容器v的大小为n，调整后的每个元素的值为element，默认为0，
         // Resizes the container so that it contains n elements.
-        as.resize(num_layers);
+        {
+            LU_NET_ALLOC_TAG(activations);
+            as.resize(num_layers);
 
-        //Generate every layer.
-        for (int i = 0; i < num_layers; i++) {
-            as[i] = VectorXf::Zero(layers_neuron_num[i]);
+            //Generate every layer.
+            for (int i = 0; i < num_layers; i++) {
+                as[i] = VectorXf::Zero(layers_neuron_num[i]);
+            }
         }
         LOG(INFO) << "Genarate layers, sucessfully!";
 
         //Generate every weights matrix and bias，index 0 is unused, use num_layers size for uniform index
-        weights.resize(num_layers);
-        bias.resize(num_layers);
-        gradient.resize(num_layers);
+        alloc_params();
         zs.resize(num_layers);
+        dropouts_.assign(num_layers, nullptr);
 
         LOG(INFO) << "Generate weights matrices and bias successfuly!";
         LOG(INFO) << "initialize Net, done!";
     }
 
 
+    /**
+     * Weights and bias of all layers live in params_, gradients in grads_, both with the layout
+     * [W_1 | W_2 | ... | W_L-1 | b_1 | b_2 | ... | b_L-1], each block padded to kParamAlign floats.
+     * The padding stays zero, so optimizer steps and norms can run over the whole buffer in one pass.
+     **/
+    void Net::alloc_params() {
+        long w_size = 0;
+        long b_size = 0;
+        for (int i = 1; i < num_layers; i++) {
+            w_size += align_size(long(layers_neuron_num[i]) * layers_neuron_num[i - 1]);
+            b_size += align_size(layers_neuron_num[i]);
+        }
+        weights_size_ = w_size;
+        prune_mask_.resize(0);
+
+        {
+            LU_NET_ALLOC_TAG(params);
+            params_ = VectorXf::Zero(w_size + b_size);
+        }
+        {
+            LU_NET_ALLOC_TAG(grads);
+            grads_ = VectorXf::Zero(w_size + b_size);
+        }
+
+        weights.clear();
+        bias.clear();
+        nabla_w.clear();
+        nabla_b.clear();
+
+        // index 0 is unused
+        weights.emplace_back(nullptr, 0, 0);
+        bias.emplace_back(nullptr, 0);
+        nabla_w.emplace_back(nullptr, 0, 0);
+        nabla_b.emplace_back(nullptr, 0);
+
+        long w_offset = 0;
+        long b_offset = weights_size_;
+        for (int i = 1; i < num_layers; i++) {
+            int rows = layers_neuron_num[i];
+            int cols = layers_neuron_num[i - 1];
+
+            weights.emplace_back(params_.data() + w_offset, rows, cols);
+            nabla_w.emplace_back(grads_.data() + w_offset, rows, cols);
+            bias.emplace_back(params_.data() + b_offset, rows);
+            nabla_b.emplace_back(grads_.data() + b_offset, rows);
+
+            w_offset += align_size(long(rows) * cols);
+            b_offset += align_size(rows);
+        }
+    }
+
+
+    void Net::set_params(const VectorXf &params) {
+        assert(params.size() == params_.size());
+        // element-wise copy, the views keep pointing into params_
+        params_ = params;
+    }
+
+
+    void Net::prune(float sparsity) {
+        LU_NET_PROFILE_SCOPE("prune");
+        if (prune_mask_.size() != weights_size_) {
+            prune_mask_ = VectorXf::Ones(weights_size_);
+        }
+
+        vector<float> magnitudes;
+        long offset = 0;
+        for (int i = 1; i < num_layers; i++) {
+            long size = weights[i].size();
+            Map<VectorXf> w(weights[i].data(), size);
+            Map<VectorXf> mask(prune_mask_.data() + offset, size);
+            offset += align_size(size);
+
+            long k = min(size, long(sparsity * size));
+            if (k == 0) {
+                continue;
+            }
+
+            // threshold is the k-th smallest magnitude, weights pruned before are zero and go first
+            magnitudes.resize(size);
+            VectorXf::Map(magnitudes.data(), size) = w.cwiseAbs();
+            nth_element(magnitudes.begin(), magnitudes.begin() + (k - 1), magnitudes.end());
+            float threshold = magnitudes[k - 1];
+
+            mask = (w.array().abs() > threshold).cast<float>();
+            w.array() *= mask.array();
+        }
+        LOG(INFO) << "prune weights, sparsity:" << sparsity;
+    }
+
+
+    void Net::clear_pruning() {
+        prune_mask_.resize(0);
+    }
+
+
+    /**
+     * Seed of the random streams of one initWeights or initBias call, layer i draws from stream i.
+     * It comes from the random_generator of the calling thread, so set_random_seed() reproduces the
+     * parameters and every call gives new ones.
+     **/
+    static uint64_t init_seed() {
+        std::mt19937 &gen = random_generator::get_instance()();
+        uint64_t high = gen();
+        return high << 32 | gen();
+    }
+
+
     /**
      * Initialize each weight using a Gaussian distribution with mean 0 and standard deviation 1 over the square root
      * of the number of weights connecting to the same neuron.  Initialize the biases using a Gaussian distribution with
      * mean 0 and standard deviation 1.
      **/
     void Net::initWeights(double w) {
+        initWeights(weight_init::scheme::lecun);
+    }
+
+
+    void Net::initWeights(weight_init::scheme scheme) {
+        initWeights(vector<weight_init::scheme>(num_layers > 1 ? num_layers - 1 : 0, scheme));
+    }
+
+
+    // The weights are drawn in bulk straight into params_, the layers do not depend on each other.
+    void Net::initWeights(const vector<weight_init::scheme> &schemes) {
+        assert(int(schemes.size()) == num_layers - 1);
+        const uint64_t seed = init_seed();
         for (int i = 1; i < num_layers; i++) {
-            weights[i] = MatrixXf::Zero(as[i].rows(), as[i - 1].rows())
-                    .unaryExpr(ptr_fun(gaussian_random)) / sqrt(float(as[i - 1].rows()));
+            random_stream rng(seed, uint64_t(i));
+            weight_init::fill(schemes[i - 1], weights[i].data(), weights[i].rows(), weights[i].cols(), rng);
+            LOG(INFO) << "layer " << i << " weights: " << weight_init::scheme_name(schemes[i - 1]);
         }
     }
 
@@ -67,20 +211,52 @@ namespace lu_net {
      * Initialize each weight using a Gaussian distribution with mean 0 and standard deviation 1.
      * */
     void Net::initBias(double w) {
+        const uint64_t seed = init_seed();
         for (int i = 1; i < num_layers; i++) {
-            bias[i] = VectorXf::Zero(as[i].rows()).unaryExpr(ptr_fun(gaussian_random));
+            random_stream rng(seed, uint64_t(i));
+            rng.gaussian(bias[i].data(), bias[i].size(), 0, 1);
+        }
+    }
+
+
+    // The masks of layer i come from stream i, with the seed drawn as for initWeights.
+    void Net::set_dropout(int layer, float keep_prob) {
+        assert(layer >= 1 && layer < num_layers - 1);
+        assert(keep_prob > 0);
+        if (keep_prob >= 1) {
+            dropouts_[layer].reset();
+            return;
+        }
+        dropouts_[layer] = make_shared<dropout_layer>(layers_neuron_num[layer], keep_prob, net_phase::test,
+                                                      random_stream(init_seed(), uint64_t(layer)));
+    }
+
+
+    void Net::set_phase(net_phase phase) {
+        for (auto &dropout : dropouts_) {
+            if (dropout) dropout->set_phase(phase);
         }
     }
 
     // farward
     void Net::farward(VectorXf x) {
+        LU_NET_PROFILE_SCOPE("farward");
+        LU_NET_ALLOC_TAG(activations);
+        metrics::clock::time_point t0;
+        if (metrics_) t0 = metrics::clock::now();
         as[0] = x;
 
         for (int i = 1; i < num_layers; i++){
             //weighted input
             VectorXf z = weights[i] * as[i - 1] + bias[i];
             zs[i] = z;
-            as[i] = activation::sigmoid::f(z);
+            if (dropouts_[i]) {
+                as[i].resize(z.size());
+                dropouts_[i]->forward_sigmoid(z.data(), as[i].data(), z.size());
+            } else {
+                as[i] = activation::sigmoid::f(z);
+            }
+            if (metrics_) t0 = metrics_->lap(metrics::phase::farward, t0, i);
         }
     }
 
@@ -89,98 +265,165 @@ namespace lu_net {
      * Compute the w and b gradient of the cost function C_x
      * */
     template <typename E>
-    void Net::backward(const VectorXf &y, vector<MatrixXf> &nabla_w, vector<VectorXf> &nabla_b) {
+    void Net::backward(const VectorXf &y) {
+        LU_NET_PROFILE_SCOPE("backward");
+        LU_NET_ALLOC_TAG(activations);
+        metrics::clock::time_point t0;
+        if (metrics_) t0 = metrics::clock::now();
+
         // error of last layer
         // VectorXf delta = cost_derivative(layers[num_layers - Black_Footed_Albatross], y).array() * sigmoid_prime(zs[num_layers -Black_Footed_Albatross]).array();
         VectorXf delta = E::df(as[num_layers - 1], y).array() * activation::sigmoid::df(zs[num_layers -1]).array();
-        nabla_b[num_layers - 1] = delta;
-        nabla_w[num_layers - 1] = delta * as[num_layers -2].transpose();
 
-        for (int i = num_layers - 2; i >= 1; i--) {
-            delta = (weights[i + 1].transpose() * delta).array() * activation::sigmoid::df(zs[i]).array();
-            nabla_b[i] = delta;
-            nabla_w[i] = delta * as[i - 1].transpose();
+        // gradient of layer i, then the error of layer i - 1 through the weights of layer i
+        for (int i = num_layers - 1; i >= 1; i--) {
+            nabla_b[i] += delta;
+            nabla_w[i].noalias() += delta * as[i - 1].transpose();
+            if (i > 1) {
+                delta = (weights[i].transpose() * delta).array() * activation::sigmoid::df(zs[i - 1]).array();
+                if (dropouts_[i - 1]) dropouts_[i - 1]->back_propagation(delta, delta);
+            }
+            if (metrics_) t0 = metrics_->lap(metrics::phase::backward, t0, i);
         }
     }
 
 
     /**
-     * Update the network's weights and biases by applying gradient descent using backpropagation to a single mini batch.
-     * The mini_batch is a list of tuples (x, y), and lr is the learning rate.
-     * @n is the total size of the training data set.
+     * Mixed precision minibatch: one fp32 GEMM per layer and minibatch, the activations kept for
+     * backward are stored in bf16, which has the exponent range of fp32 so no loss scaling is needed.
+     * zs is not stored, sigmoid'(z) = a * (1 - a) is recomputed from the activations.
+     * After dropout a = m * sigmoid(z) / keep_prob, and m * sigmoid'(z) / keep_prob = a * (1 - keep_prob * a),
+     * so the masks need not be kept either.
+     * The weights, nabla_w and nabla_b stay fp32.
      * */
-    template <typename E, typename Optimizer>
-    void Net::update_batch(Optimizer &optimizer, const vector<tensor_t>& in, const vector<tensor_t>& t, int batch_size, int n) {
-        // Change accumulated
-        vector<MatrixXf> acum_nabla_w;
-        acum_nabla_w.resize(num_layers);
-
-        vector<VectorXf> acum_nabla_b;
-        acum_nabla_b.resize(num_layers);
+    template <typename E>
+    float Net::farward_backward_mixed(const vector<tensor_t> &in, const vector<tensor_t> &t, int batch_size) {
+        LU_NET_PROFILE_SCOPE("farward_backward_mixed");
+        LU_NET_ALLOC_TAG(activations);
+        metrics::clock::time_point t0;
+        if (metrics_) t0 = metrics::clock::now();
+
+        // inputs and targets, one column per sample
+        MatrixXf a(layers_neuron_num[0], batch_size);
+        MatrixXf y(layers_neuron_num[num_layers - 1], batch_size);
+        for (int j = 0; j < batch_size; j++) {
+            a.col(j) = Map<const VectorXf>(&in[j][0][0], in[j][0].size());
+            y.col(j) = Map<const VectorXf>(&t[j][0][0], t[j][0].size());
+        }
+        if (metrics_) t0 = metrics_->lap(metrics::phase::data, t0);
 
-        // Initial all zeros;
+        // the fp32 activations only live until the next layer
+        as_bf16.resize(num_layers);
+        as_bf16[0] = a.cast<bfloat16>();
+        MatrixXf z;
         for (int i = 1; i < num_layers; i++) {
-            acum_nabla_w[i] = MatrixXf::Zero(as[i].rows(), as[i - 1].rows());
-            acum_nabla_b[i] = VectorXf::Zero(as[i].rows());
+            z.noalias() = weights[i] * a;
+            z.colwise() += bias[i];
+            a.resize(z.rows(), z.cols());
+            if (dropouts_[i]) {
+                dropouts_[i]->forward_sigmoid(z.data(), a.data(), z.size());
+            } else {
+                kernels().sigmoid(z.data(), a.data(), z.size());
+            }
+            as_bf16[i] = a.cast<bfloat16>();
+            if (metrics_) t0 = metrics_->lap(metrics::phase::farward, t0, i);
         }
 
-        vector<MatrixXf> delta_nabla_w;
-        delta_nabla_w.resize(num_layers);
-
-        vector<VectorXf> delta_nabla_b;
-        delta_nabla_b.resize(num_layers);
-
-        // Accumulate loss in a batch
-        float batch_sum_loss = 0.0;
+        // error of last layer
+        float sum_loss = 0.0;
+        MatrixXf delta(a.rows(), batch_size);
+        for (int j = 0; j < batch_size; j++) {
+            sum_loss += E::f(a.col(j), y.col(j));
+            delta.col(j) = E::df(a.col(j), y.col(j));
+        }
+        delta = delta.array() * a.array() * (1.0 - a.array());
+
+        MatrixXf a_prev;
+        for (int i = num_layers - 1; i >= 1; i--) {
+            a_prev = as_bf16[i - 1].cast<float>();
+            nabla_w[i].noalias() += delta * a_prev.transpose();
+            nabla_b[i] += delta.rowwise().sum();
+
+            if (i > 1) {
+                z.noalias() = weights[i].transpose() * delta;
+                float keep = dropouts_[i - 1] ? dropouts_[i - 1]->keep_prob() : 1.0f;
+                delta = z.array() * a_prev.array() * (1.0 - keep * a_prev.array());
+            }
+            if (metrics_) t0 = metrics_->lap(metrics::phase::backward, t0, i);
+        }
 
-        // Train samples one by one
-        for(int i = 0; i < batch_size; i++) {
-            // Convert from std::vector to Eigen
-            // VectorXf x(&in[i][0], in[i][0].size());
-            VectorXf x(in[i][0].size());
-            VectorXf y(t[i][0].size());
+        return sum_loss;
+    }
 
-            for (int k = 0; k < in[i][0].size(); ++k) {
-                x[k] = in[i][0][k];
-            }
 
-            for (int k = 0; k < t[i][0].size(); ++k) {
-                y[k] = t[i][0][k];
-            }
+    /**
+     * Update the network's weights and biases by applying gradient descent using backpropagation to a single mini batch.
+     * The mini_batch is a list of tuples (x, y), and lr is the learning rate.
+     * @n is the total size of the training data set.
+     * */
+    template <typename E, typename Optimizer>
+    void Net::update_batch(Optimizer &optimizer, const vector<tensor_t>& in, const vector<tensor_t>& t, int batch_size, int n,
+                           float lr) {
+        LU_NET_PROFILE_SCOPE("update_batch");
 
-            farward(x);
-            backward<E>(y, delta_nabla_w, delta_nabla_b);
+        // Change accumulated in grads_, initial all zeros
+        grads_.setZero();
 
-            float loss = E::f(as[num_layers - 1], y);
-            batch_sum_loss += loss;
+        // Accumulate loss in a batch
+        float batch_sum_loss = 0.0;
 
-            // Accumulate changes of all samples
-            for (int j = 1; j < num_layers; ++j) {
-                acum_nabla_w[j] = acum_nabla_w[j] + delta_nabla_w[j];
-                acum_nabla_b[j] = acum_nabla_b[j] + delta_nabla_b[j];
+        // Train the whole batch at once in mixed precision, or samples one by one
+        if (mixed_precision) {
+            batch_sum_loss = farward_backward_mixed<E>(in, t, batch_size);
+        } else {
+            for(int i = 0; i < batch_size; i++) {
+                // Convert from std::vector to Eigen
+                // VectorXf x(&in[i][0], in[i][0].size());
+                metrics::clock::time_point t0;
+                if (metrics_) t0 = metrics::clock::now();
+                LU_NET_ALLOC_TAG(dataset);
+                VectorXf x(in[i][0].size());
+                VectorXf y(t[i][0].size());
+
+                for (int k = 0; k < in[i][0].size(); ++k) {
+                    x[k] = in[i][0][k];
+                }
+
+                for (int k = 0; k < t[i][0].size(); ++k) {
+                    y[k] = t[i][0][k];
+                }
+                if (metrics_) metrics_->lap(metrics::phase::data, t0);
+
+                // Accumulate changes of all samples
+                farward(x);
+                backward<E>(y);
+
+                float loss = E::f(as[num_layers - 1], y);
+                batch_sum_loss += loss;
             }
         }
 
         // 一批样本改变的平均值作为最后的改变
-        for (int k = 1; k < num_layers; ++k) {
-            // L2 Regular weights[k] = ( Black_Footed_Albatross - learning_rate * (lmbda / n) ) * weights[k] - learning_rate / batch_size * acum_nabla_w[k];
-            MatrixXf avg_nabla_w = acum_nabla_w[k] / batch_size;
-            optimizer.update_w(weights[k], avg_nabla_w, learning_rate);
-
-            VectorXf avg_nabla_b = acum_nabla_b[k] / batch_size;
-            optimizer.update_b(bias[k], avg_nabla_b, learning_rate);
+        // L2 Regular weights[k] = ( Black_Footed_Albatross - learning_rate * (lmbda / n) ) * weights[k] - learning_rate / batch_size * acum_nabla_w[k];
+        {
+            LU_NET_PROFILE_SCOPE("optimizer");
+            metrics::clock::time_point t0;
+            if (metrics_) t0 = metrics::clock::now();
+            grads_ /= float(batch_size);
+            optimizer.update(params_.data(), grads_.data(), params_.size(), lr);
+
+            // keep pruned weights at zero, the optimizer state may move them
+            if (prune_mask_.size() == weights_size_) {
+                params_.head(weights_size_).array() *= prune_mask_.array();
+            }
+            if (metrics_) metrics_->lap(metrics::phase::update, t0);
         }
 
         // Average of loss.
         batch_loss = batch_sum_loss / batch_size;
 
         // Add regularization term.
-        float sum_squares_weights = 0;
-        for (int k = 1; k < num_layers; k++)
-        {
-            sum_squares_weights += weights[k].array().square().matrix().sum();
-        }
-        // batch_loss += 0.5 * (lmbda / batch_size) * sum_squares_weights;
+        // batch_loss += 0.5 * (lmbda / batch_size) * params_.head(weights_size_).squaredNorm();
     }
 
 
@@ -192,11 +435,19 @@ namespace lu_net {
     * @param batch_size the number of data points to use in this batch
     */
     template <typename E, typename Optimizer>
-    void Net::train_onebatch(Optimizer &optimizer, const tensor_t* in, const tensor_t* t, int batch_size, int n) {
-        vector<tensor_t> in_batch(&in[0], &in[0] + batch_size);
-        vector<tensor_t> t_batch(&t[0], &t[0] + batch_size);
+    void Net::train_onebatch(Optimizer &optimizer, const tensor_t* in, const tensor_t* t, int batch_size, int n, float lr) {
+        vector<tensor_t> in_batch, t_batch;
+        {
+            LU_NET_PROFILE_SCOPE("data");
+            LU_NET_ALLOC_TAG(dataset);
+            metrics::clock::time_point t0;
+            if (metrics_) t0 = metrics::clock::now();
+            in_batch.assign(&in[0], &in[0] + batch_size);
+            t_batch.assign(&t[0], &t[0] + batch_size);
+            if (metrics_) metrics_->lap(metrics::phase::data, t0);
+        }
 
-        update_batch<E>(optimizer, in_batch, t_batch, batch_size, n);
+        update_batch<E>(optimizer, in_batch, t_batch, batch_size, n, lr);
     }
 
 
@@ -209,11 +460,12 @@ namespace lu_net {
     void Net::train_once(Optimizer &optimizer, const tensor_t *in,
                     const tensor_t *t,
                     int size,
-                    int n) {
+                    int n,
+                    float lr) {
         if (size == 1) {
 
         } else {
-            train_onebatch<E>(optimizer, in, t, size, n);
+            train_onebatch<E>(optimizer, in, t, size, n, lr);
         }
     }
 
@@ -233,6 +485,7 @@ namespace lu_net {
     template <typename E, typename Optimizer>
     bool Net::train(Optimizer &optimizer, const vector<vec_t> &inputs, const vector<label_t> &class_labels,
                     int batch_size, int epoch) {
+        LU_NET_PROFILE_SCOPE("train");
         if (inputs.size() != class_labels.size()) {
             return false;
         }
@@ -245,31 +498,108 @@ namespace lu_net {
 
         // Convert to tensor_t type.
         vector<tensor_t> input_tensor, output_tensor, t_cost_tensor;
-        normalize_tensor(inputs, input_tensor);
-        normalize_tensor(class_labels, output_tensor);
+        {
+            LU_NET_PROFILE_SCOPE("data");
+            LU_NET_ALLOC_TAG(dataset);
+            normalize_tensor(inputs, input_tensor);
+            normalize_tensor(class_labels, output_tensor);
+        }
+
+        // Minibatches of one epoch, the scheduler counts iterations over all epochs.
+        long iters_per_epoch = (n + batch_size - 1) / batch_size;
+        long iteration = 0;
+        if (lr_scheduler_) {
+            lr_scheduler_->begin(learning_rate, iters_per_epoch, epoch);
+        }
+        if (pruning_) {
+            pruning_->begin(iters_per_epoch, epoch);
+        }
+        if (metrics_) {
+            metrics_->begin(layers_neuron_num);
+        }
+
+        set_phase(net_phase::train);
+
+        // Early stopping state, the best weights are kept in a copy of the flat parameter buffer.
+        bool validation = val_inputs_ != nullptr && !val_inputs_->empty();
+        float best_val_loss = numeric_limits<float>::infinity();
+        float val_loss = best_val_loss;
+        int bad_validations = 0;
+        VectorXf best_params;
 
         // Train training set epoch times
         for (int iter = 0; iter < epoch; iter++) {
             LOG(INFO) << "epoch:" << iter;
-            LOG(INFO) << "learning rate:" << learning_rate;
+            LOG(INFO) << "learning rate:" << (lr_scheduler_ ? lr_scheduler_->lr(iteration) : learning_rate);
 
+            float epoch_sum_loss = 0.0;
             for (int i = 0; i < inputs.size(); i += batch_size) {
+                // learning_rate stays the base of the scheduler, the next train() starts from it again
+                float lr = lr_scheduler_ ? lr_scheduler_->lr(iteration) : learning_rate;
+                if (pruning_ && iteration % pruning_->frequency == 0) {
+                    prune(pruning_->sparsity(iteration));
+                }
+
                 // train on one minibatch
                 train_once<E>(optimizer, &input_tensor[i],
                            &output_tensor[i],
                            static_cast<int>(min<int>(batch_size, inputs.size() - i)),
-                           n);
+                           n, lr);
+                epoch_sum_loss += batch_loss;
+                if (metrics_) {
+                    metrics_->batch_end(iter, iteration, static_cast<int>(min<int>(batch_size, inputs.size() - i)), batch_loss);
+                }
+                iteration++;
             }
 
             LOG(INFO) << "last batch_loss:" << batch_loss;
 
-            //change learning rate
-            if (iter % output_interval == 0)
+            bool stop = false;
+            bool validated = validation && (iter + 1) % validation_interval == 0;
+            if (validated) {
+                result val_result;
+                val_loss = validate<E>(val_result);
+                LOG(INFO) << "val loss:" << val_loss << " val accuracy:" << val_result.accuracy();
+
+                if (val_loss < best_val_loss) {
+                    best_val_loss = val_loss;
+                    LU_NET_ALLOC_TAG(params);
+                    best_params = params_;
+                    bad_validations = 0;
+                } else if (patience > 0 && ++bad_validations >= patience) {
+                    LOG(INFO) << "early stopping, no improvement in " << patience << " validations.";
+                    stop = true;
+                }
+            }
+
+            //change learning rate, with a validation set only epochs which measured a new val loss count
+            if (lr_scheduler_) {
+                if (!validation) {
+                    lr_scheduler_->epoch_end(iter, epoch_sum_loss / iters_per_epoch);
+                } else if (validated) {
+                    lr_scheduler_->epoch_end(iter, val_loss);
+                }
+            }
+            else if (iter % output_interval == 0)
             {
                 learning_rate *= fine_tune_factor;
             }
+
+            if (stop) {
+                break;
+            }
         }
 
+        if (restore_best && best_params.size() == params_.size()) {
+            LOG(INFO) << "restore best weights, val loss:" << best_val_loss;
+            set_params(best_params);
+        }
+
+        if (metrics_) {
+            metrics_->end();
+        }
+
+        set_phase(net_phase::test);
         LOG(INFO) << "End training.";
 
         return true;
@@ -278,12 +608,23 @@ namespace lu_net {
     // instance for template function
     template bool Net::train<cross_entropy>(optimizer::gradient_descent &optimizer, const vector<vec_t> &inputs, const vector<label_t> &class_labels, int batch_size,
                                             int epoch);
+    template bool Net::train<cross_entropy>(optimizer::momentum &optimizer, const vector<vec_t> &inputs, const vector<label_t> &class_labels, int batch_size,
+                                            int epoch);
+    template bool Net::train<cross_entropy>(optimizer::adagrad &optimizer, const vector<vec_t> &inputs, const vector<label_t> &class_labels, int batch_size,
+                                            int epoch);
+    template bool Net::train<cross_entropy>(optimizer::RMSprop &optimizer, const vector<vec_t> &inputs, const vector<label_t> &class_labels, int batch_size,
+                                            int epoch);
+    template bool Net::train<cross_entropy>(optimizer::adam &optimizer, const vector<vec_t> &inputs, const vector<label_t> &class_labels, int batch_size,
+                                            int epoch);
+    template bool Net::train<cross_entropy>(optimizer::adamw &optimizer, const vector<vec_t> &inputs, const vector<label_t> &class_labels, int batch_size,
+                                            int epoch);
 
 
     /**
     * test and generate confusion-matrix for classification task
     **/
     result Net::test(const std::vector<vec_t> &inputs, const std::vector<label_t> &class_labels) {
+        LU_NET_PROFILE_SCOPE("test");
         result test_result;
 
         if (inputs.empty())
@@ -292,28 +633,118 @@ namespace lu_net {
             return test_result;
         }
 
-        for (int i = 0; i < inputs.size(); i++) {
-            //change inputs format from vector toVectorXf
-            VectorXf x(inputs[i].size());
-            for (int k = 0; k < inputs[i].size(); ++k) {
-                x[k] = inputs[i][k];
-            }
+        MatrixXf out;
+        for (size_t i = 0; i < inputs.size(); i += kTestBatchSize) {
+            size_t size = min(kTestBatchSize, inputs.size() - i);
+            farward_batch(inputs, i, size, out);
+            count_predictions(out, &class_labels[i], test_result);
+        }
 
-            label_t predicted = fprop_max_index(x);
-            label_t actual = class_labels[i];
+        return test_result;
+    }
 
-            if (predicted == actual) {
-                test_result.num_success += 1;
-            }
 
-            test_result.num_total += 1;
-            test_result.confusion_matrix[predicted][actual]++;
+    result Net::test(const float_t *inputs, const label_t *class_labels, long n) {
+        LU_NET_PROFILE_SCOPE("test");
+        result test_result;
+        const long input_size = layers_neuron_num[0];
+
+        // a row-major n x input_size array is column-major input_size x n, one column per sample
+        MatrixXf out;
+        for (long i = 0; i < n; i += kTestBatchSize) {
+            long size = min(long(kTestBatchSize), n - i);
+            farward_batch(Map<const MatrixXf>(inputs + i * input_size, input_size, size), out);
+            count_predictions(out, class_labels + i, test_result);
         }
 
         return test_result;
     }
 
 
+    void Net::predict(const float_t *inputs, long n, float_t *outputs) {
+        const long input_size = layers_neuron_num[0];
+        const long output_size = layers_neuron_num[num_layers - 1];
+
+        MatrixXf out;
+        for (long i = 0; i < n; i += kTestBatchSize) {
+            long size = min(long(kTestBatchSize), n - i);
+            farward_batch(Map<const MatrixXf>(inputs + i * input_size, input_size, size), out);
+            Map<MatrixXf>(outputs + i * output_size, output_size, size) = out;
+        }
+    }
+
+
+    void Net::set_validation_data(const std::vector<vec_t> &inputs, const std::vector<label_t> &class_labels) {
+        assert(inputs.size() == class_labels.size());
+        val_inputs_ = &inputs;
+        val_labels_ = &class_labels;
+    }
+
+
+    /**
+     * farward a batch of samples, same computation as farward but one column per sample
+     */
+    void Net::farward_batch(const std::vector<vec_t> &inputs, size_t begin, size_t size, MatrixXf &out) {
+        LU_NET_ALLOC_TAG(activations);
+        MatrixXf x(layers_neuron_num[0], size);
+        for (size_t j = 0; j < size; j++) {
+            x.col(j) = Map<const VectorXf>(&inputs[begin + j][0], inputs[begin + j].size());
+        }
+        farward_batch(x, out);
+    }
+
+
+    void Net::farward_batch(const Ref<const MatrixXf> &x, MatrixXf &out) {
+        LU_NET_ALLOC_TAG(activations);
+        MatrixXf z;
+        for (int i = 1; i < num_layers; i++) {
+            if (i == 1) {
+                z.noalias() = weights[i] * x;
+            } else {
+                z.noalias() = weights[i] * out;
+            }
+            z.colwise() += bias[i];
+            // sigmoid on every column
+            out.resize(z.rows(), z.cols());
+            kernels().sigmoid(z.data(), out.data(), z.size());
+        }
+    }
+
+
+    template <typename E>
+    float Net::validate(result &val_result) {
+        const vector<vec_t> &inputs = *val_inputs_;
+        const vector<label_t> &class_labels = *val_labels_;
+        float sum_loss = 0.0;
+
+        MatrixXf out;
+        VectorXf y = VectorXf::Zero(layers_neuron_num[num_layers - 1]);
+        for (size_t i = 0; i < inputs.size(); i += kTestBatchSize) {
+            size_t size = min(kTestBatchSize, inputs.size() - i);
+            farward_batch(inputs, i, size, out);
+
+            for (size_t j = 0; j < size; j++) {
+                int max_index = 0;
+                out.col(j).maxCoeff(&max_index);
+                label_t actual = class_labels[i + j];
+
+                // one hot target
+                y[actual] = 1;
+                sum_loss += E::f(out.col(j), y);
+                y[actual] = 0;
+
+                if (label_t(max_index) == actual) {
+                    val_result.num_success += 1;
+                }
+                val_result.num_total += 1;
+                val_result.confusion_matrix[label_t(max_index)][actual]++;
+            }
+        }
+
+        return sum_loss / inputs.size();
+    }
+
+
     /**
      * farward prop and retun the index of last layer
      */
@@ -324,6 +755,10 @@ namespace lu_net {
         return label_t(max_index);
     }
 
+    int Net::predict_one(const vec_t &input) {
+        return int(fprop_max_index(Map<const VectorXf>(&input[0], input.size())));
+    }
+
     /**
      * sava model
      */
@@ -353,7 +788,13 @@ namespace lu_net {
             //repeated的内嵌对象类型使用add传指针出来添加
             MatrixMsg *weightsData = weightsMsg->add_weights();
             VectorMsg *biasData = weightsMsg->add_bias();
-            WriteMatrix(weights[i], weightsData);
+            // pruned layers as CSR when it is smaller, a non-zero takes a value and a column index
+            long non_zeros = (weights[i].array() != 0).count();
+            if (2 * non_zeros + weights[i].rows() + 1 < weights[i].size()) {
+                WriteSparseMatrix(weights[i], weightsData);
+            } else {
+                WriteMatrix(weights[i], weightsData);
+            }
             WriteVector(bias[i], biasData);
         }
 
@@ -366,26 +807,81 @@ namespace lu_net {
             switch (what) {
                 case content_type::weights_and_model :
                     WriteProtoToTextFile(modelWeightsMsg, filename.c_str());
+                    break;
                 case content_type::weights :
                     WriteProtoToTextFile(*weightsMsg, filename.c_str());
+                    break;
                 case content_type::model :
                     WriteProtoToTextFile(*modelMsg, filename.c_str());
+                    break;
             }
         }
         else if (format == file_format::binary) {
             switch (what) {
                 case content_type::weights_and_model :
                     WriteProtoToBinaryFile(modelWeightsMsg, filename.c_str());
+                    break;
                 case content_type::weights :
                     WriteProtoToBinaryFile(*weightsMsg, filename.c_str());
+                    break;
                 case content_type::model :
                     WriteProtoToBinaryFile(*modelMsg, filename.c_str());
+                    break;
             }
         }
 
-        // Optional:  Delete all global objects allocated by libprotobuf.
-        google::protobuf::ShutdownProtobufLibrary();
+        return true;
+    }
+
+
+    bool Net::load(const string &filename,
+                   content_type what,
+                   file_format format) {
+        GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+        // weights and model alone are read into the fields of the whole message
+        ModelWeightsMsg modelWeightsMsg;
+        Message *msg = &modelWeightsMsg;
+        if (what == content_type::weights) {
+            msg = modelWeightsMsg.mutable_weights();
+        } else if (what == content_type::model) {
+            msg = modelWeightsMsg.mutable_model();
+        }
+
+        bool success = format == file_format::json ? ReadProtoFromTextFile(filename.c_str(), msg)
+                                                   : ReadProtoFromBinaryFile(filename.c_str(), msg);
+        if (!success) {
+            return false;
+        }
+
+        /***************load model param*************/
+        if (what != content_type::weights) {
+            const ModelMsg &modelMsg = modelWeightsMsg.model();
+            const auto &neuron_num = modelMsg.net_param().layers_neuron_num();
+            initNet(vector<int>(neuron_num.begin(), neuron_num.end()), modelMsg.learning_rate(), lmbda);
+            if (what == content_type::model) {
+                return true;
+            }
+        }
 
-        return 0;
+        /****************load weights*************/
+        const WeightsMsg &weightsMsg = modelWeightsMsg.weights();
+        if (weightsMsg.weights_size() != num_layers - 1 || weightsMsg.bias_size() != num_layers - 1) {
+            return false;
+        }
+        MatrixXf w;
+        VectorXf b;
+        for (int i = 1; i < num_layers; ++i) {
+            if (!ReadMatrix(weightsMsg.weights(i - 1), &w)) {
+                return false;
+            }
+            ReadVector(weightsMsg.bias(i - 1), &b);
+            if (w.rows() != weights[i].rows() || w.cols() != weights[i].cols() || b.size() != bias[i].size()) {
+                return false;
+            }
+            weights[i] = w;
+            bias[i] = b;
+        }
+        return true;
     }
 }
\ No newline at end of file
@@ -0,0 +1,530 @@
+//
+// Created by 芦yafei  on 17/9/2.
+//
+
+#include "profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace lu_net {
+    namespace profiler {
+
+        // Durations are counted in log2 buckets split in four, bucket 4 * e + s holds [(4 + s) << (e - 2), (5 + s) << (e - 2))
+        static const int kHistogramBuckets = 64 * 4;
+
+        static inline uint64_t now_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return uint64_t(chrono::duration_cast<chrono::nanoseconds>(
+                    chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        static inline int bucket_of(uint64_t ticks) {
+            if (ticks < 4) {
+                return int(ticks);
+            }
+            int e = 63 - __builtin_clzll(ticks);
+            return 4 * e + int((ticks >> (e - 2)) & 3);
+        }
+
+        // middle of a bucket
+        static inline double bucket_value(int bucket) {
+            if (bucket < 4) {
+                return bucket;
+            }
+            int e = bucket / 4, s = bucket % 4;
+            return double(4 + s) * double(uint64_t(1) << (e - 2)) + double(uint64_t(1) << (e - 2)) / 2;
+        }
+
+        static atomic<bool> counters_enabled(false);
+
+        /**
+         * perf_event_open counters of one thread in one group, read together by one system call.
+         * Counters which can not be opened are left out, they read as 0.
+         **/
+        struct counter_group {
+            bool opened = false;        // open was tried
+            int size = 0;
+            int index[kCounters];       // position in the group, -1 if not available
+            vector<int> fds;
+
+            counter_group() {
+                fill(index, index + kCounters, -1);
+            }
+
+            ~counter_group() {
+#ifdef __linux__
+                for (int fd : fds) close(fd);
+#endif
+            }
+
+#ifdef __linux__
+            static bool counter_attr(counter c, perf_event_attr &attr) {
+                memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                switch (c) {
+                    case counter::cycles:
+                        attr.type = PERF_TYPE_HARDWARE;
+                        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                        return true;
+                    case counter::instructions:
+                        attr.type = PERF_TYPE_HARDWARE;
+                        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                        return true;
+                    case counter::llc_misses:
+                        attr.type = PERF_TYPE_HW_CACHE;
+                        attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                        return true;
+                    case counter::branch_misses:
+                        attr.type = PERF_TYPE_HARDWARE;
+                        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                        return true;
+                    case counter::fp_ops:
+#if defined(__x86_64__) || defined(__i386__)
+                        // FP_ARITH_INST_RETIRED, umask of the scalar, 128, 256 and 512 bit single precision
+                        if (__builtin_cpu_is("intel")) {
+                            attr.type = PERF_TYPE_RAW;
+                            attr.config = 0xC7 | (0xAA << 8);
+                            return true;
+                        }
+#endif
+                        return false;
+                    case counter::page_faults:
+                        attr.type = PERF_TYPE_SOFTWARE;
+                        attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+                        attr.exclude_kernel = 0;
+                        return true;
+                }
+                return false;
+            }
+#endif
+
+            // counters of the calling thread
+            void open() {
+                opened = true;
+#ifdef __linux__
+                int leader = -1;
+                for (int c = 0; c < kCounters; c++) {
+                    perf_event_attr attr;
+                    if (!counter_attr(counter(c), attr)) continue;
+                    int fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+                    if (fd < 0) continue;
+                    if (leader < 0) leader = fd;
+                    fds.push_back(fd);
+                    index[c] = size++;
+                }
+#endif
+            }
+
+            // values of the counters, scaled when the kernel multiplexed the group
+            void read_values(uint64_t *values) const {
+                uint64_t buf[3 + kCounters];
+#ifdef __linux__
+                ssize_t bytes = read(fds[0], buf, sizeof(buf));
+                if (bytes < ssize_t(3 * sizeof(uint64_t))) {
+                    fill(values, values + kCounters, uint64_t(0));
+                    return;
+                }
+#endif
+                // buf holds the number of counters, time enabled, time running, then the values
+                double scale = buf[2] > 0 && buf[2] < buf[1] ? double(buf[1]) / double(buf[2]) : 1.0;
+                for (int c = 0; c < kCounters; c++) {
+                    values[c] = index[c] >= 0 ? uint64_t(double(buf[3 + index[c]]) * scale) : 0;
+                }
+            }
+        };
+
+        // a scope at one path, children are found by comparing the name pointers
+        struct node {
+            const char *name;
+            int parent;
+            vector<int> children;
+            long count = 0;
+            uint64_t total = 0;
+            uint64_t max = 0;
+            vector<uint32_t> histogram;
+            long counted = 0;                   // scopes read with counters
+            uint64_t counters[kCounters] = {0, 0, 0, 0, 0, 0};
+
+            node(const char *name, int parent) : name(name), parent(parent), histogram(kHistogramBuckets, 0) {}
+        };
+
+        struct event {
+            int node;
+            uint64_t begin;
+            uint64_t end;
+        };
+
+        // recorded by one thread only
+        struct thread_buffer {
+            int tid;
+            vector<node> nodes;         // 0 is the root, the thread itself
+            int current = 0;            // innermost open scope
+            vector<event> ring;
+            uint64_t events = 0;        // events recorded, ring holds the last kTraceEvents of them
+            counter_group counters;
+
+            explicit thread_buffer(int tid) : tid(tid) {
+                nodes.emplace_back("", -1);
+                ring.resize(kTraceEvents);
+            }
+
+            int enter(const char *name) {
+                for (int child : nodes[current].children) {
+                    if (nodes[child].name == name) {
+                        return current = child;
+                    }
+                }
+                int id = int(nodes.size());
+                nodes.emplace_back(name, current);
+                nodes[current].children.push_back(id);
+                return current = id;
+            }
+
+            void leave(int id, uint64_t begin, uint64_t end) {
+                node &n = nodes[id];
+                uint64_t ticks = end - begin;
+                n.count++;
+                n.total += ticks;
+                n.max = std::max(n.max, ticks);
+                n.histogram[bucket_of(ticks)]++;
+                current = n.parent;
+
+                event &e = ring[events % kTraceEvents];
+                e.node = id;
+                e.begin = begin;
+                e.end = end;
+                events++;
+            }
+
+            // read the counters at the start of a scope, false if they are not enabled
+            bool start_counters(uint64_t *values) {
+                if (!counters_enabled.load(memory_order_relaxed)) {
+                    return false;
+                }
+                if (!counters.opened) {
+                    counters.open();
+                }
+                if (counters.size == 0) {
+                    return false;
+                }
+                counters.read_values(values);
+                return true;
+            }
+
+            void stop_counters(int id, const uint64_t *start) {
+                uint64_t values[kCounters];
+                counters.read_values(values);
+                node &n = nodes[id];
+                n.counted++;
+                for (int c = 0; c < kCounters; c++) {
+                    n.counters[c] += values[c] - start[c];
+                }
+            }
+
+            void clear() {
+                nodes.clear();
+                nodes.emplace_back("", -1);
+                current = 0;
+                events = 0;
+            }
+        };
+
+        // buffers of all threads, kept after the threads exit
+        struct registry {
+            mutex lock;
+            vector<unique_ptr<thread_buffer> > buffers;
+            uint64_t start_ticks = now_ticks();
+            chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+
+            thread_buffer *add() {
+                lock_guard<mutex> guard(lock);
+                buffers.emplace_back(new thread_buffer(int(buffers.size())));
+                return buffers.back().get();
+            }
+
+            // microseconds per tick, measured over the time since the first scope
+            double us_per_tick() {
+#if defined(__x86_64__) || defined(__i386__)
+                uint64_t ticks = now_ticks() - start_ticks;
+                double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start_time).count();
+                return ticks > 0 ? us / double(ticks) : 0;
+#else
+                return 1e-3;
+#endif
+            }
+        };
+
+        static registry &get_registry() {
+            static registry instance;
+            return instance;
+        }
+
+        static thread_buffer *local_buffer() {
+            thread_local thread_buffer *buffer = get_registry().add();
+            return buffer;
+        }
+
+
+        scope::scope(const char *name) {
+            thread_buffer *buffer = local_buffer();
+            buffer_ = buffer;
+            node_ = buffer->enter(name);
+            counting_ = buffer->start_counters(counters_);
+            begin_ = now_ticks();
+        }
+
+
+        scope::~scope() {
+            uint64_t end = now_ticks();
+            thread_buffer *buffer = static_cast<thread_buffer *>(buffer_);
+            if (counting_) {
+                buffer->stop_counters(node_, counters_);
+            }
+            buffer->leave(node_, begin_, end);
+        }
+
+
+        const char *counter_name(counter c) {
+            static const char *names[kCounters] = {"cycles", "instructions", "llc_misses", "branch_misses",
+                                                   "fp_ops", "page_faults"};
+            return names[int(c)];
+        }
+
+
+        bool enable_counters() {
+#ifdef LU_NET_PROFILE
+            counters_enabled = true;
+            thread_buffer *buffer = local_buffer();
+            if (!buffer->counters.opened) {
+                buffer->counters.open();
+            }
+            return buffer->counters.size > 0;
+#else
+            return false;
+#endif
+        }
+
+
+        void disable_counters() {
+            counters_enabled = false;
+        }
+
+
+        // names joined by separator
+        static string path_of(const thread_buffer &buffer, int id, char separator) {
+            string path = buffer.nodes[id].name;
+            for (int p = buffer.nodes[id].parent; p > 0; p = buffer.nodes[p].parent) {
+                path = string(buffer.nodes[p].name) + separator + path;
+            }
+            return path;
+        }
+
+
+        // merged node of all threads
+        struct merged_node {
+            int depth = 0;
+            long count = 0;
+            uint64_t total = 0;
+            uint64_t max = 0;
+            vector<uint64_t> histogram = vector<uint64_t>(kHistogramBuckets, 0);
+            long counted = 0;
+            uint64_t counters[kCounters] = {0, 0, 0, 0, 0, 0};
+            bool available[kCounters] = {false, false, false, false, false, false};
+        };
+
+        static double percentile(const merged_node &m, double q) {
+            long rank = long(q * (m.count - 1));
+            long seen = 0;
+            for (int b = 0; b < kHistogramBuckets; b++) {
+                seen += long(m.histogram[b]);
+                if (seen > rank) {
+                    return std::min(bucket_value(b), double(m.max));
+                }
+            }
+            return double(m.max);
+        }
+
+
+        vector<scope_stats> summary() {
+            registry &r = get_registry();
+            const double us_per_tick = r.us_per_tick();
+
+            // sorted by path, the separator sorts before any character of the names so that
+            // the children of a scope come right after it
+            const char separator = '\x01';
+            map<string, merged_node> merged;
+            {
+                lock_guard<mutex> guard(r.lock);
+                for (const auto &buffer : r.buffers) {
+                    for (int id = 1; id < int(buffer->nodes.size()); id++) {
+                        const node &n = buffer->nodes[id];
+                        if (n.count == 0) continue;
+                        merged_node &m = merged[path_of(*buffer, id, separator)];
+                        m.count += n.count;
+                        m.total += n.total;
+                        m.max = std::max(m.max, n.max);
+                        for (int b = 0; b < kHistogramBuckets; b++) {
+                            m.histogram[b] += n.histogram[b];
+                        }
+                        if (n.counted > 0) {
+                            m.counted += n.counted;
+                            for (int c = 0; c < kCounters; c++) {
+                                m.counters[c] += n.counters[c];
+                                m.available[c] = m.available[c] || buffer->counters.index[c] >= 0;
+                            }
+                        }
+                        m.depth = 0;
+                        for (int p = n.parent; p > 0; p = buffer->nodes[p].parent) {
+                            m.depth++;
+                        }
+                    }
+                }
+            }
+
+            vector<scope_stats> stats;
+            for (const auto &kv : merged) {
+                const merged_node &m = kv.second;
+                scope_stats s;
+                s.path = kv.first;
+                replace(s.path.begin(), s.path.end(), separator, '/');
+                s.depth = m.depth;
+                s.count = m.count;
+                s.total_ms = m.total * us_per_tick / 1000;
+                s.mean_us = m.total * us_per_tick / m.count;
+                s.p50_us = percentile(m, 0.5) * us_per_tick;
+                s.p90_us = percentile(m, 0.9) * us_per_tick;
+                s.p99_us = percentile(m, 0.99) * us_per_tick;
+                s.max_us = m.max * us_per_tick;
+                if (m.counted > 0) {
+                    for (int c = 0; c < kCounters; c++) {
+                        s.counters.push_back(m.available[c] ? double(m.counters[c]) : -1.0);
+                    }
+                }
+                stats.push_back(s);
+            }
+            return stats;
+        }
+
+
+        void print_summary(ostream &out) {
+            vector<scope_stats> stats = summary();
+            if (stats.empty()) {
+                return;
+            }
+
+            ios::fmtflags flags = out.flags();
+            out << left << setw(48) << "scope" << right << setw(10) << "count" << setw(12) << "total ms"
+                << setw(11) << "mean us" << setw(11) << "p50 us" << setw(11) << "p90 us"
+                << setw(11) << "p99 us" << setw(11) << "max us" << "\n";
+            out << fixed << setprecision(2);
+            for (const auto &s : stats) {
+                // indent the last name of the path by depth
+                string name = string(2 * s.depth, ' ') + s.path.substr(s.path.rfind('/') + 1);
+                out << left << setw(48) << name << right << setw(10) << s.count << setw(12) << s.total_ms
+                    << setw(11) << s.mean_us << setw(11) << s.p50_us << setw(11) << s.p90_us
+                    << setw(11) << s.p99_us << setw(11) << s.max_us << "\n";
+            }
+
+            // derived counter rates of the scopes read with counters, "-" where a counter is not available
+            bool counted = false;
+            for (const auto &s : stats) counted = counted || !s.counters.empty();
+            if (counted) {
+                auto rate = [](const scope_stats &s, counter a, double scale, counter b) -> string {
+                    double x = s.counters[int(a)];
+                    double y = s.counters[int(b)];
+                    if (x < 0 || y <= 0) return "-";
+                    ostringstream text;
+                    text << fixed << setprecision(2) << x * scale / y;
+                    return text.str();
+                };
+                out << "\n" << left << setw(48) << "scope" << right << setw(10) << "IPC"
+                    << setw(14) << "LLC/kinst" << setw(14) << "brmiss/kinst" << setw(14) << "fp/cycle"
+                    << setw(14) << "page faults" << "\n";
+                for (const auto &s : stats) {
+                    if (s.counters.empty()) continue;
+                    string name = string(2 * s.depth, ' ') + s.path.substr(s.path.rfind('/') + 1);
+                    double faults = s.counters[int(counter::page_faults)];
+                    out << left << setw(48) << name << right
+                        << setw(10) << rate(s, counter::instructions, 1, counter::cycles)
+                        << setw(14) << rate(s, counter::llc_misses, 1000, counter::instructions)
+                        << setw(14) << rate(s, counter::branch_misses, 1000, counter::instructions)
+                        << setw(14) << rate(s, counter::fp_ops, 1, counter::cycles)
+                        << setw(14) << (faults < 0 ? string("-") : to_string(long(faults))) << "\n";
+                }
+            }
+            out.flags(flags);
+        }
+
+
+        bool write_chrome_trace(const string &filename) {
+            registry &r = get_registry();
+            const double us_per_tick = r.us_per_tick();
+            lock_guard<mutex> guard(r.lock);
+
+            uint64_t events = 0;
+            for (const auto &buffer : r.buffers) {
+                events += buffer->events;
+            }
+            ofstream file;
+            if (events > 0) {
+                file.open(filename);
+            }
+            if (!file.is_open()) {
+                return false;
+            }
+
+            // complete events, the viewer nests them by time
+            file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            bool first = true;
+            char line[256];
+            for (const auto &buffer : r.buffers) {
+                uint64_t size = std::min<uint64_t>(buffer->events, kTraceEvents);
+                for (uint64_t i = buffer->events - size; i < buffer->events; i++) {
+                    const event &e = buffer->ring[i % kTraceEvents];
+                    snprintf(line, sizeof(line), "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                             first ? "" : ",", buffer->nodes[e.node].name, buffer->tid,
+                             double(e.begin - r.start_ticks) * us_per_tick, double(e.end - e.begin) * us_per_tick);
+                    file << line;
+                    first = false;
+                }
+            }
+            file << "\n]}\n";
+            return file.good();
+        }
+
+
+        void clear() {
+            registry &r = get_registry();
+            lock_guard<mutex> guard(r.lock);
+            for (auto &buffer : r.buffers) {
+                buffer->clear();
+            }
+        }
+    }
+}
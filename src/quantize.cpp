@@ -0,0 +1,174 @@
+//
+// Created by 芦yafei  on 17/8/21.
+//
+
+#include "quantize.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "cpu_dispatch.h"
+
+using namespace std;
+using namespace Eigen;
+
+namespace lu_net {
+
+    // Rows of weights and columns of activations are padded to kQuantAlign bytes, one 256 bit register.
+    static const int kQuantAlign = 32;
+
+    // Largest quantized activation, 7 bits.
+    static const int kQuantMax = 127;
+
+    // Number of samples farward at once by test.
+    static const size_t kQuantBatchSize = 256;
+
+
+    static int align_quant(int size) {
+        return (size + kQuantAlign - 1) / kQuantAlign * kQuantAlign;
+    }
+
+
+    QuantizedNet::QuantizedNet(const Net &net, const std::vector<vec_t> &calibration_inputs) {
+        assert(!calibration_inputs.empty());
+        const int num_layers = net.num_layers;
+
+        // ranges of the input of every layer on the calibration set, farward in fp32
+        vector<float> in_min(num_layers, numeric_limits<float>::infinity());
+        vector<float> in_max(num_layers, -numeric_limits<float>::infinity());
+        MatrixXf out, z;
+        for (size_t i = 0; i < calibration_inputs.size(); i += kQuantBatchSize) {
+            size_t size = min(kQuantBatchSize, calibration_inputs.size() - i);
+            out.resize(net.layers_neuron_num[0], size);
+            for (size_t j = 0; j < size; j++) {
+                out.col(j) = Map<const VectorXf>(&calibration_inputs[i + j][0], calibration_inputs[i + j].size());
+            }
+
+            for (int l = 1; l < num_layers; l++) {
+                in_min[l] = min(in_min[l], out.minCoeff());
+                in_max[l] = max(in_max[l], out.maxCoeff());
+                z.noalias() = net.get_weights(l) * out;
+                z.colwise() += net.get_bias(l);
+                out = (1.0 + (-z).array().exp()).inverse();
+            }
+        }
+
+        layers_.resize(num_layers - 1);
+        for (int l = 1; l < num_layers; l++) {
+            Layer &layer = layers_[l - 1];
+            const auto &W = net.get_weights(l);
+            layer.rows = int(W.rows());
+            layer.cols = int(W.cols());
+            layer.stride = align_quant(layer.cols);
+
+            // asymmetric, the range always holds 0 so that the zero point is in [0, kQuantMax]
+            float lo = min(0.0f, in_min[l]);
+            float hi = max(0.0f, in_max[l]);
+            layer.in_scale = hi > lo ? (hi - lo) / kQuantMax : 1.0f;
+            layer.in_zero_point = int(std::round(-lo / layer.in_scale));
+
+            // symmetric per row, sum of the quantized row folds the zero point into the bias
+            layer.w.assign(size_t(layer.rows) * layer.stride, 0);
+            layer.scale.resize(layer.rows);
+            layer.bias.resize(layer.rows);
+            for (int r = 0; r < layer.rows; r++) {
+                float max_abs = W.row(r).cwiseAbs().maxCoeff();
+                float w_scale = max_abs > 0 ? max_abs / 127 : 1.0f;
+                int32_t row_sum = 0;
+                for (int c = 0; c < layer.cols; c++) {
+                    int q = int(std::round(W(r, c) / w_scale));
+                    layer.w[size_t(r) * layer.stride + c] = int8_t(max(-127, min(127, q)));
+                    row_sum += q;
+                }
+                layer.scale[r] = w_scale * layer.in_scale;
+                layer.bias[r] = net.get_bias(l)[r] - layer.scale[r] * layer.in_zero_point * row_sum;
+            }
+        }
+    }
+
+
+    void QuantizedNet::quantize_input(int i, const float *x, uint8_t *q) const {
+        const Layer &layer = layers_[i];
+        const float inv_scale = 1.0f / layer.in_scale;
+        const float offset = layer.in_zero_point + 0.5f;
+        kernels().quantize_u8(x, q, layer.cols, inv_scale, offset);
+        // padding meets zero weights
+        fill(q + layer.cols, q + layer.stride, uint8_t(0));
+    }
+
+
+    void QuantizedNet::farward_batch(const std::vector<vec_t> &inputs, size_t begin, size_t size, MatrixXf &out) {
+        const int L = int(layers_.size());
+
+        a_.resize(size * layers_[0].stride);
+        for (size_t j = 0; j < size; j++) {
+            assert(inputs[begin + j].size() == size_t(layers_[0].cols));
+            quantize_input(0, &inputs[begin + j][0], &a_[j * layers_[0].stride]);
+        }
+
+        const kernel_table &kernel = kernels();
+        for (int i = 0; i < L; i++) {
+            const Layer &layer = layers_[i];
+            z_.resize(layer.rows, size);
+
+            // int8 GEMM in blocks of four rows by two columns. The last blocks repeat the last row
+            // and column when rows or size are not multiples of them.
+            int32_t acc0[4], acc1[4];
+            const int8_t *w[4];
+            for (size_t j = 0; j < size; j += 2) {
+                const uint8_t *a0 = &a_[j * layer.stride];
+                const uint8_t *a1 = j + 1 < size ? a0 + layer.stride : a0;
+                for (int r = 0; r < layer.rows; r += 4) {
+                    for (int k = 0; k < 4; k++) {
+                        w[k] = &layer.w[size_t(min(r + k, layer.rows - 1)) * layer.stride];
+                    }
+                    kernel.dot4x2_u8s8(a0, a1, w, layer.stride, acc0, acc1);
+                    for (int k = 0; k < 4 && r + k < layer.rows; k++) {
+                        z_(r + k, j) = float(acc0[k]);
+                        if (j + 1 < size) {
+                            z_(r + k, j + 1) = float(acc1[k]);
+                        }
+                    }
+                }
+            }
+
+            // dequantize into the bias, then sigmoid on every column
+            z_ = (z_.array().colwise() * layer.scale.array()).colwise() + layer.bias.array();
+            kernel.sigmoid(z_.data(), z_.data(), z_.size());
+
+            if (i + 1 < L) {
+                const int stride = layers_[i + 1].stride;
+                a_next_.resize(size * stride);
+                for (size_t j = 0; j < size; j++) {
+                    quantize_input(i + 1, z_.col(j).data(), &a_next_[j * stride]);
+                }
+                a_.swap(a_next_);
+            }
+        }
+
+        out = z_;
+    }
+
+
+    result QuantizedNet::test(const std::vector<vec_t> &inputs, const std::vector<label_t> &class_labels) {
+        result test_result;
+
+        MatrixXf out;
+        for (size_t i = 0; i < inputs.size(); i += kQuantBatchSize) {
+            size_t size = min(kQuantBatchSize, inputs.size() - i);
+            farward_batch(inputs, i, size, out);
+
+            count_predictions(out, &class_labels[i], test_result);
+        }
+
+        return test_result;
+    }
+
+
+    size_t QuantizedNet::weights_bytes() const {
+        size_t bytes = 0;
+        for (const Layer &layer : layers_) {
+            bytes += layer.w.size() + (layer.scale.size() + layer.bias.size()) * sizeof(float);
+        }
+        return bytes;
+    }
+}
@@ -0,0 +1,89 @@
+//
+// Created by 芦yafei  on 17/8/14.
+//
+
+#include "recurrent.h"
+#include "alloc_tracker.h"
+#include <algorithm>
+
+namespace lu_net{
+    SequenceState::SequenceState(int x_dim, int gate_rows, int hidden_dim, int cell_rows, int batch_size)
+            : x_dim_(x_dim),
+              gate_rows_(gate_rows),
+              hidden_dim_(hidden_dim),
+              cell_rows_(cell_rows),
+              batch_size_(batch_size)
+    {
+        reset();
+    }
+
+    SequenceState::~SequenceState() {}
+
+    void SequenceState::reset() {
+        steps_ = 0;
+        cols_ = 0;
+        offsets_.clear();
+        sizes_.clear();
+        s0_.setZero(cell_rows_, batch_size_);
+        h0_.setZero(hidden_dim_, batch_size_);
+    }
+
+    void SequenceState::reset(int batch_size) {
+        batch_size_ = batch_size;
+        reset();
+    }
+
+    void SequenceState::drop_front(int n) {
+        assert(n <= steps_);
+        if (n == 0) {
+            return;
+        }
+
+        // sequences finished before step n - 1 are not used any more
+        s0_.leftCols(sizes_[n - 1]) = s(n - 1);
+        h0_.leftCols(sizes_[n - 1]) = h(n - 1);
+
+        // move the kept steps to the front, column by column from the left as the ranges may overlap
+        int from = n < steps_ ? offsets_[n] : cols_;
+        int keep = cols_ - from;
+        for (int c = 0; c < keep; c++) {
+            x_.col(c) = x_.col(from + c);
+            gates_.col(c) = gates_.col(from + c);
+            s_.col(c) = s_.col(from + c);
+            h_.col(c) = h_.col(from + c);
+        }
+
+        offsets_.erase(offsets_.begin(), offsets_.begin() + n);
+        sizes_.erase(sizes_.begin(), sizes_.begin() + n);
+        for (int &offset : offsets_) {
+            offset -= from;
+        }
+        steps_ -= n;
+        cols_ = keep;
+    }
+
+    void SequenceState::reserve(int steps) {
+        // enough for all sequences running at every step
+        int cols = cols_ + std::max(0, steps - steps_) * batch_size_;
+        if (cols <= capacity_) {
+            return;
+        }
+
+        // grow geometrically so that appending steps one by one is amortized O(1)
+        LU_NET_ALLOC_TAG(activations);
+        capacity_ = std::max(cols, 2 * capacity_);
+        x_.conservativeResize(x_dim_, capacity_);
+        gates_.conservativeResize(gate_rows_, capacity_);
+        s_.conservativeResize(cell_rows_, capacity_);
+        h_.conservativeResize(hidden_dim_, capacity_);
+    }
+
+    int SequenceState::push_step(int active) {
+        assert(0 < active && active <= (steps_ > 0 ? sizes_.back() : batch_size_));
+        reserve(steps_ + 1);
+        offsets_.push_back(cols_);
+        sizes_.push_back(active);
+        cols_ += active;
+        return steps_++;
+    }
+}
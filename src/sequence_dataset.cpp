@@ -0,0 +1,84 @@
+//
+// Created by 芦yafei  on 17/8/16.
+//
+
+#include "sequence_dataset.h"
+#include "random.h"
+#include <algorithm>
+#include <numeric>
+
+namespace lu_net{
+    void SequenceDataset::add(const Eigen::MatrixXf &x, const Eigen::MatrixXf &y) {
+        assert(x.cols() == y.cols() && x.cols() > 0);
+        assert(x_.empty() || (x.rows() == x_[0].rows() && y.rows() == y_[0].rows()));
+        x_.push_back(x);
+        y_.push_back(y);
+    }
+
+    SequenceBatcher::SequenceBatcher(const SequenceDataset &dataset, int batch_size, bool shuffle)
+            :dataset_(dataset),
+             batch_size_(batch_size),
+             shuffle_(shuffle)
+    {
+        assert(batch_size > 0);
+        begin_epoch();
+    }
+
+    void SequenceBatcher::begin_epoch() {
+        order_.resize(dataset_.size());
+        std::iota(order_.begin(), order_.end(), 0);
+
+        // shuffle first, the stable sort keeps the random order of sequences of the same length
+        if (shuffle_) {
+            std::shuffle(order_.begin(), order_.end(), random_generator::get_instance()());
+        }
+        std::stable_sort(order_.begin(), order_.end(), [this](size_t a, size_t b) {
+            return dataset_.length(a) > dataset_.length(b);
+        });
+
+        batches_.clear();
+        for (size_t first = 0; first < order_.size(); first += batch_size_) {
+            batches_.push_back(first);
+        }
+        if (shuffle_) {
+            std::shuffle(batches_.begin(), batches_.end(), random_generator::get_instance()());
+        }
+        cursor_ = 0;
+    }
+
+    bool SequenceBatcher::next(SequenceBatch &batch) {
+        if (cursor_ >= batches_.size()) {
+            return false;
+        }
+
+        size_t first = batches_[cursor_++];
+        size_t last = std::min(first + batch_size_, order_.size());
+        batch.index.assign(order_.begin() + first, order_.begin() + last);
+
+        // sequences are longest first, so the running ones at step t are a prefix of the minibatch
+        const int n_seq = int(batch.index.size());
+        const int steps = dataset_.length(batch.index[0]);
+        batch.batch_sizes.assign(steps, 0);
+        int cols = 0;
+        for (int n = 0; n < n_seq; n++) {
+            int length = dataset_.length(batch.index[n]);
+            for (int t = 0; t < length; t++) {
+                batch.batch_sizes[t]++;
+            }
+            cols += length;
+        }
+
+        const SequenceDataset &d = dataset_;
+        batch.x.resize(d.x(batch.index[0]).rows(), cols);
+        batch.y.resize(d.y(batch.index[0]).rows(), cols);
+        int offset = 0;
+        for (int t = 0; t < steps; t++) {
+            for (int n = 0; n < batch.batch_sizes[t]; n++) {
+                batch.x.col(offset + n) = d.x(batch.index[n]).col(t);
+                batch.y.col(offset + n) = d.y(batch.index[n]).col(t);
+            }
+            offset += batch.batch_sizes[t];
+        }
+        return true;
+    }
+}
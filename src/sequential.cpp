@@ -0,0 +1,198 @@
+//
+// Created by 芦yafei  on 17/9/14.
+//
+
+#include "sequential.h"
+#include <cassert>
+#include <iomanip>
+
+using namespace std;
+using namespace Eigen;
+
+namespace lu_net {
+
+    // Offset of a layer block in params_ and grads_ is rounded up to kParamAlign floats.
+    static const long kParamAlign = 16;
+
+    static long align_size(long size) {
+        return (size + kParamAlign - 1) / kParamAlign * kParamAlign;
+    }
+
+    // grow v to at least size floats, keeping its memory otherwise
+    static float *reserve(VectorXf &v, long size) {
+        if (v.size() < size) {
+            v.resize(size);
+        }
+        return v.data();
+    }
+
+
+    sequential &sequential::add(shared_ptr<layer> l) {
+        assert(!set_up_);
+        long out = l->out_size(out_size());
+        assert(out > 0);
+        layers_.push_back(l);
+        sizes_.push_back(out);
+        return *this;
+    }
+
+
+    void sequential::setup() {
+        if (set_up_) {
+            return;
+        }
+        long size = 0;
+        offsets_.clear();
+        for (size_t i = 0; i < layers_.size(); i++) {
+            offsets_.push_back(size);
+            size += align_size(layers_[i]->param_size(i == 0 ? in_size_ : sizes_[i - 1]));
+        }
+        params_ = VectorXf::Zero(size);
+        grads_ = VectorXf::Zero(size);
+        for (size_t i = 0; i < layers_.size(); i++) {
+            layers_[i]->setup(i == 0 ? in_size_ : sizes_[i - 1], params_.data() + offsets_[i], grads_.data() + offsets_[i]);
+        }
+        set_up_ = true;
+    }
+
+
+    void sequential::init_params(uint64_t seed) {
+        setup();
+        for (size_t i = 0; i < layers_.size(); i++) {
+            random_stream rng(seed, uint64_t(i));
+            layers_[i]->init_params(rng);
+        }
+    }
+
+
+    /**
+     * Output i is read by layer i + 1 in farward, and by back_prop if layer i + 1 needs its input or
+     * layer i its output. Outputs read only in farward are free once layer i + 1 has run, the buffer
+     * of the last output is kept as the result. Buffers are given first fit in the order of the layers.
+     **/
+    sequential::plan &sequential::get_plan(net_phase phase) {
+        plan &p = plans_[int(phase)];
+        if (p.done) {
+            return p;
+        }
+        const int n = int(layers_.size());
+        p.buffer.assign(n, -1);
+        p.buffers = 0;
+        vector<int> free_after(n, n);       // last layer which reads output i, n if it is kept
+        vector<bool> in_use;
+        for (int i = 0; i < n; i++) {
+            bool kept = i == n - 1 || (phase == net_phase::train &&
+                                       (layers_[i]->backward_needs_output() || layers_[i + 1]->backward_needs_input()));
+            if (!kept) {
+                free_after[i] = i + 1;
+            }
+            // buffers of outputs read for the last time by layer i - 1 are free again
+            for (int k = 0; k < i; k++) {
+                if (free_after[k] == i - 1 && p.buffer[k] >= 0) {
+                    in_use[p.buffer[k]] = false;
+                }
+            }
+            int b = 0;
+            while (b < p.buffers && in_use[b]) {
+                b++;
+            }
+            if (b == p.buffers) {
+                p.buffers++;
+                in_use.push_back(false);
+            }
+            in_use[b] = true;
+            p.buffer[i] = b;
+        }
+        p.done = true;
+        return p;
+    }
+
+
+    int sequential::buffers(net_phase phase) {
+        return get_plan(phase).buffers;
+    }
+
+
+    const_batch_t sequential::activation(int i, const plan &p) const {
+        if (i == 0) {
+            return const_batch_t(in_data_, in_size_, cols_);
+        }
+        return const_batch_t(buffers_[p.buffer[i - 1]].data(), sizes_[i - 1], cols_);
+    }
+
+
+    const_batch_t sequential::farward(const Ref<const MatrixXf> &x, net_phase phase) {
+        assert(x.rows() == in_size_ && !layers_.empty());
+        setup();
+        const plan &p = get_plan(phase);
+        if (int(buffers_.size()) < p.buffers) {
+            buffers_.resize(p.buffers);
+        }
+
+        // layers read the input through a plain pointer. backward reads it again if the first layer needs
+        // its input, x may then be a temporary of the caller and is copied.
+        bool keep_input = phase == net_phase::train && layers_[0]->backward_needs_input();
+        if (!keep_input && x.outerStride() == x.rows()) {
+            in_data_ = x.data();
+        } else {
+            input_ = x;
+            in_data_ = input_.data();
+        }
+        cols_ = x.cols();
+        for (size_t i = 0; i < layers_.size(); i++) {
+            reserve(buffers_[p.buffer[i]], sizes_[i] * cols_);
+        }
+
+        for (int i = 0; i < int(layers_.size()); i++) {
+            batch_t out(buffers_[p.buffer[i]].data(), sizes_[i], cols_);
+            layers_[i]->farward_prop(activation(i, p), out, phase);
+        }
+        backward_ready_ = phase == net_phase::train;
+        return activation(int(layers_.size()), p);
+    }
+
+
+    void sequential::backward(const Ref<const MatrixXf> &out_grad) {
+        assert(backward_ready_ && out_grad.rows() == out_size() && out_grad.cols() == cols_);
+        const plan &p = get_plan(net_phase::train);
+        const const_batch_t none(nullptr, 0, 0);
+
+        MatrixXf contiguous;
+        const float *grad = out_grad.data();
+        if (out_grad.outerStride() != out_grad.rows()) {
+            contiguous = out_grad;
+            grad = contiguous.data();
+        }
+
+        int next = 0;
+        for (int i = int(layers_.size()) - 1; i >= 0; i--) {
+            const long in_size = i == 0 ? in_size_ : sizes_[i - 1];
+            const_batch_t g(grad, sizes_[i], cols_);
+            batch_t in_grad(i > 0 ? reserve(grad_buffers_[next], in_size * cols_) : nullptr, in_size, cols_);
+            layers_[i]->back_prop(layers_[i]->backward_needs_input() ? activation(i, p) : none,
+                                  layers_[i]->backward_needs_output() ? activation(i + 1, p) : none,
+                                  g, i > 0 ? &in_grad : nullptr);
+            grad = in_grad.data();
+            next = 1 - next;
+        }
+    }
+
+
+    void sequential::print(ostream &out) {
+        setup();
+        const plan &train = get_plan(net_phase::train);
+        const plan &test = get_plan(net_phase::test);
+        ios::fmtflags flags = out.flags();
+        out << left << setw(4) << "#" << setw(18) << "layer" << right << setw(10) << "in" << setw(10) << "out"
+            << setw(12) << "params" << setw(14) << "buffer train" << setw(13) << "buffer test" << "\n";
+        for (size_t i = 0; i < layers_.size(); i++) {
+            long in = i == 0 ? in_size_ : sizes_[i - 1];
+            out << left << setw(4) << i << setw(18) << layers_[i]->layer_type() << right << setw(10) << in
+                << setw(10) << sizes_[i] << setw(12) << layers_[i]->param_size(in)
+                << setw(14) << train.buffer[i] << setw(13) << test.buffer[i] << "\n";
+        }
+        out << "buffers train:" << train.buffers << " test:" << test.buffers
+            << " params:" << params_.size() << "\n";
+        out.flags(flags);
+    }
+}
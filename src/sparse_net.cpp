@@ -0,0 +1,76 @@
+//
+// Created by 芦yafei  on 17/8/24.
+//
+
+#include "sparse_net.h"
+#include "cpu_dispatch.h"
+#include <algorithm>
+
+using namespace std;
+using namespace Eigen;
+
+namespace lu_net {
+
+    // Number of samples farward at once by test.
+    static const size_t kSparseBatchSize = 256;
+
+    SparseNet::SparseNet(const Net &net) {
+        for (int i = 1; i < net.num_layers; i++) {
+            weights_.push_back(net.get_weights(i).sparseView());
+            weights_.back().makeCompressed();
+            bias_.push_back(net.get_bias(i));
+        }
+    }
+
+
+    void SparseNet::farward_batch(const std::vector<vec_t> &inputs, size_t begin, size_t size, MatrixXf &out) {
+        a_.resize(weights_[0].cols(), size);
+        for (size_t j = 0; j < size; j++) {
+            a_.col(j) = Map<const VectorXf>(&inputs[begin + j][0], inputs[begin + j].size());
+        }
+
+        for (size_t i = 0; i < weights_.size(); i++) {
+            z_.noalias() = weights_[i] * a_;
+            z_.colwise() += bias_[i];
+            // sigmoid on every column
+            a_.resize(z_.rows(), z_.cols());
+            kernels().sigmoid(z_.data(), a_.data(), z_.size());
+        }
+        out = a_;
+    }
+
+
+    result SparseNet::test(const std::vector<vec_t> &inputs, const std::vector<label_t> &class_labels) {
+        result test_result;
+
+        MatrixXf out;
+        for (size_t i = 0; i < inputs.size(); i += kSparseBatchSize) {
+            size_t size = min(kSparseBatchSize, inputs.size() - i);
+            farward_batch(inputs, i, size, out);
+
+            count_predictions(out, &class_labels[i], test_result);
+        }
+
+        return test_result;
+    }
+
+
+    long SparseNet::non_zeros() const {
+        long n = 0;
+        for (const auto &w : weights_) {
+            n += w.nonZeros();
+        }
+        return n;
+    }
+
+
+    size_t SparseNet::weights_bytes() const {
+        size_t bytes = 0;
+        for (size_t i = 0; i < weights_.size(); i++) {
+            bytes += weights_[i].nonZeros() * (sizeof(float) + sizeof(int))
+                     + (weights_[i].outerSize() + 1) * sizeof(int)
+                     + bias_[i].size() * sizeof(float);
+        }
+        return bytes;
+    }
+}
@@ -0,0 +1,68 @@
+//
+// Created by 芦yafei  on 17/9/13.
+//
+
+#include "weight_init.h"
+#include <cmath>
+#include <eigen3/Eigen/Dense>
+
+using namespace std;
+using namespace Eigen;
+
+namespace lu_net {
+    namespace weight_init {
+
+        const char *scheme_name(scheme s) {
+            static const char *names[] = {"lecun", "xavier", "he", "orthogonal"};
+            return names[int(s)];
+        }
+
+
+        /**
+         * Q of the QR decomposition of a Gaussian matrix, with the signs of diag(R) so that Q is uniform over the
+         * orthogonal matrices. The QR runs on the transpose when there are more inputs than neurons, so w has
+         * orthonormal columns if fan_out >= fan_in and orthonormal rows otherwise.
+         **/
+        static void fill_orthogonal(float *w, long fan_out, long fan_in, random_stream &rng) {
+            const bool tall = fan_out >= fan_in;
+            const long rows = tall ? fan_out : fan_in;
+            const long cols = tall ? fan_in : fan_out;
+            MatrixXf a(rows, cols);
+            rng.gaussian(a.data(), a.size(), 0, 1);
+
+            HouseholderQR<MatrixXf> qr(a);
+            MatrixXf q = qr.householderQ() * MatrixXf::Identity(rows, cols);
+            for (long j = 0; j < cols; j++) {
+                if (qr.matrixQR()(j, j) < 0) q.col(j) = -q.col(j);
+            }
+
+            Map<MatrixXf> out(w, fan_out, fan_in);
+            if (tall) {
+                out = q;
+            } else {
+                out = q.transpose();
+            }
+        }
+
+
+        void fill(scheme s, float *w, long fan_out, long fan_in, random_stream &rng) {
+            const long size = fan_out * fan_in;
+            switch (s) {
+                case scheme::lecun:
+                    rng.gaussian(w, size, 0, 1.0f / sqrt(float(fan_in)));
+                    break;
+                case scheme::xavier: {
+                    float a = sqrt(6.0f / float(fan_in + fan_out));
+                    rng.uniform(w, size, -a, a);
+                    break;
+                }
+                case scheme::he:
+                    rng.gaussian(w, size, 0, sqrt(2.0f / float(fan_in)));
+                    break;
+                case scheme::orthogonal:
+                    fill_orthogonal(w, fan_out, fan_in, rng);
+                    break;
+            }
+        }
+    }
+}
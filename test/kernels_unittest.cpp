@@ -0,0 +1,147 @@
+//
+// Created by 芦yafei  on 17/8/28.
+//
+
+#include "cpu_dispatch.h"
+#include <gtest/gtest.h>
+#include <eigen3/Eigen/Dense>
+#include <cmath>
+#include <vector>
+
+using namespace lu_net;
+
+// lengths around the vector widths, so the main loops and the tails of every level run
+static const long kSizes[] = {1, 7, 16, 33, 1003};
+
+// kernels of every level the CPU supports above generic, the level is restored afterwards
+static std::vector<cpu_level> levels_above_generic() {
+    std::vector<cpu_level> levels;
+    for (int i = int(cpu_level::generic) + 1; i <= int(detect_cpu_level()); i++) {
+        levels.push_back(cpu_level(i));
+    }
+    return levels;
+}
+
+static const kernel_table &kernels_at(cpu_level level) {
+    set_cpu_level(level);
+    return kernels();
+}
+
+class KernelsTest : public ::testing::Test {
+protected:
+    void TearDown() override { set_cpu_level(detect_cpu_level()); }
+};
+
+TEST_F(KernelsTest, Sigmoid) {
+    for (long size : kSizes) {
+        Eigen::VectorXf z = 8 * Eigen::VectorXf::Random(size), expected(size), a(size);
+        kernels_at(cpu_level::generic).sigmoid(z.data(), expected.data(), size);
+        for (cpu_level level : levels_above_generic()) {
+            kernels_at(level).sigmoid(z.data(), a.data(), size);
+            EXPECT_LT((a - expected).cwiseAbs().maxCoeff(), 1e-6) << cpu_level_name(level) << " size " << size;
+        }
+    }
+}
+
+// W, state 0 and state 1 after two updates of every optimizer with the kernels of level
+static std::vector<Eigen::VectorXf> optimizer_updates(cpu_level level, long size, int optimizer) {
+    const kernel_table &k = kernels_at(level);
+    Eigen::VectorXf W = Eigen::VectorXf::LinSpaced(size, -1, 1);
+    Eigen::VectorXf s0 = Eigen::VectorXf::Zero(size), s1 = Eigen::VectorXf::Zero(size);
+    for (int step = 0; step < 2; step++) {
+        Eigen::VectorXf dW = Eigen::VectorXf::LinSpaced(size, 0.5f + step, -0.3f);
+        switch (optimizer) {
+            case 0: k.gradient_descent(W.data(), dW.data(), size, 0.1f, 0.01f); break;
+            case 1: k.momentum(W.data(), s0.data(), dW.data(), size, 0.1f, 0.01f, 0.9f); break;
+            case 2: k.adagrad(W.data(), s0.data(), dW.data(), size, 0.1f, 1e-8f); break;
+            case 3: k.rmsprop(W.data(), s0.data(), dW.data(), size, 0.1f, 0.99f, 1e-8f); break;
+            case 4: k.adam(W.data(), s0.data(), s1.data(), dW.data(), size, 0.9f, 0.999f, 0.01f, 1e-8f, 0.0f); break;
+            default: k.adam(W.data(), s0.data(), s1.data(), dW.data(), size, 0.9f, 0.999f, 0.01f, 1e-8f, 1e-3f); break;
+        }
+    }
+    return {W, s0, s1};
+}
+
+TEST_F(KernelsTest, OptimizerUpdates) {
+    const char *names[] = {"gradient_descent", "momentum", "adagrad", "rmsprop", "adam", "adamw"};
+    for (int optimizer = 0; optimizer < 6; optimizer++) {
+        for (long size : kSizes) {
+            std::vector<Eigen::VectorXf> expected = optimizer_updates(cpu_level::generic, size, optimizer);
+            for (cpu_level level : levels_above_generic()) {
+                std::vector<Eigen::VectorXf> result = optimizer_updates(level, size, optimizer);
+                for (size_t i = 0; i < result.size(); i++) {
+                    EXPECT_LT((result[i] - expected[i]).cwiseAbs().maxCoeff(), 1e-5)
+                                        << names[optimizer] << " " << cpu_level_name(level) << " size " << size;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(KernelsTest, QuantizeU8) {
+    for (long size : kSizes) {
+        Eigen::VectorXf x = 1.2f * Eigen::VectorXf::Random(size);
+        std::vector<uint8_t> expected(size), q(size);
+        kernels_at(cpu_level::generic).quantize_u8(x.data(), expected.data(), size, 63.5f, 63.5f);
+        for (cpu_level level : levels_above_generic()) {
+            kernels_at(level).quantize_u8(x.data(), q.data(), size, 63.5f, 63.5f);
+            for (long i = 0; i < size; i++) {
+                // an FMA may round a value on a step boundary to the other side
+                EXPECT_LE(std::abs(int(q[i]) - int(expected[i])), 1) << cpu_level_name(level) << " size " << size;
+                EXPECT_LE(q[i], 127);
+            }
+        }
+    }
+}
+
+TEST_F(KernelsTest, Dot4x2U8S8) {
+    const int n = 96;
+    std::vector<uint8_t> a0(n), a1(n);
+    std::vector<int8_t> rows(4 * n);
+    for (int i = 0; i < n; i++) {
+        a0[i] = uint8_t((i * 37) % 128);
+        a1[i] = uint8_t(127 - (i * 11) % 128);
+    }
+    for (int i = 0; i < 4 * n; i++) {
+        rows[i] = int8_t((i * 53) % 255 - 127);
+    }
+    const int8_t *w[4] = {&rows[0], &rows[n], &rows[2 * n], &rows[3 * n]};
+
+    int32_t expected0[4], expected1[4], out0[4], out1[4];
+    kernels_at(cpu_level::generic).dot4x2_u8s8(a0.data(), a1.data(), w, n, expected0, expected1);
+    for (int r = 0; r < 4; r++) {
+        int32_t sum0 = 0, sum1 = 0;
+        for (int i = 0; i < n; i++) {
+            sum0 += int32_t(a0[i]) * w[r][i];
+            sum1 += int32_t(a1[i]) * w[r][i];
+        }
+        EXPECT_EQ(expected0[r], sum0);
+        EXPECT_EQ(expected1[r], sum1);
+    }
+    for (cpu_level level : levels_above_generic()) {
+        kernels_at(level).dot4x2_u8s8(a0.data(), a1.data(), w, n, out0, out1);
+        for (int r = 0; r < 4; r++) {
+            EXPECT_EQ(out0[r], expected0[r]) << cpu_level_name(level);
+            EXPECT_EQ(out1[r], expected1[r]) << cpu_level_name(level);
+        }
+    }
+}
+
+TEST_F(KernelsTest, SigmoidDropout) {
+    for (long size : kSizes) {
+        Eigen::VectorXf z = 8 * Eigen::VectorXf::Random(size), expected(size), a(size);
+        std::vector<uint32_t> mask((size + 31) / 32);
+        for (size_t i = 0; i < mask.size(); i++) {
+            mask[i] = 0x9E3779B9u * uint32_t(i + 1);
+        }
+        kernels_at(cpu_level::generic).sigmoid_dropout(z.data(), expected.data(), mask.data(), 2.0f, size);
+        for (long j = 0; j < size; j++) {
+            bool kept = mask[j / 32] >> (j % 32) & 1u;
+            EXPECT_NEAR(expected[j], kept ? 2.0f / (1.0f + std::exp(-z[j])) : 0.0f, 1e-6) << "size " << size;
+        }
+        for (cpu_level level : levels_above_generic()) {
+            kernels_at(level).sigmoid_dropout(z.data(), a.data(), mask.data(), 2.0f, size);
+            EXPECT_LT((a - expected).cwiseAbs().maxCoeff(), 1e-6) << cpu_level_name(level) << " size " << size;
+        }
+    }
+}
@@ -0,0 +1,226 @@
+//
+// Created by 芦yafei  on 17/8/18.
+//
+
+#include "lstm.h"
+#include "gru.h"
+#include <gtest/gtest.h>
+
+using namespace lu_net;
+
+// loss = sum(h .* R), so the derivative with respect to h is R
+template <typename Layer>
+static double weighted_sum(Layer &layer, const Eigen::MatrixXf &x, const std::vector<int> &batch_sizes,
+                           const Eigen::MatrixXf &R) {
+    layer.farward_prop(x, batch_sizes);
+    return (layer.h().array() * R.array()).template cast<double>().sum();
+}
+
+// max difference between the analytic diffs and central differences of the loss
+template <typename Layer>
+static double max_gradient_error(Layer &layer, float *w, const float *w_diff, long size,
+                                 const Eigen::MatrixXf &x, const std::vector<int> &batch_sizes,
+                                 const Eigen::MatrixXf &R) {
+    const float eps = 1e-2;
+    double max_err = 0;
+    for (long k = 0; k < size; k++) {
+        float origin = w[k];
+        w[k] = origin + eps;
+        double loss_plus = weighted_sum(layer, x, batch_sizes, R);
+        w[k] = origin - eps;
+        double loss_minus = weighted_sum(layer, x, batch_sizes, R);
+        w[k] = origin;
+        max_err = std::max(max_err, std::abs((loss_plus - loss_minus) / (2 * eps) - w_diff[k]));
+    }
+    return max_err;
+}
+
+TEST(LstmLayerTest, GradientCheck) {
+    const int H = 5, X = 3;
+    // three sequences of lengths 4, 3 and 1, packed
+    const std::vector<int> batch_sizes = {3, 2, 2, 1};
+    LstmParam param(H, X);
+    LstmLayer layer(param);
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(X, 8);
+    Eigen::MatrixXf R = Eigen::MatrixXf::Random(H, 8);
+
+    weighted_sum(layer, x, batch_sizes, R);
+    layer.back_prop(R);
+
+    EXPECT_LT(max_gradient_error(layer, param.w.data(), param.w_diff.data(), param.w.size(), x, batch_sizes, R), 1e-3);
+    EXPECT_LT(max_gradient_error(layer, param.b.data(), param.b_diff.data(), param.b.size(), x, batch_sizes, R), 1e-3);
+}
+
+TEST(LstmLayerTest, BatchMatchesSingleSequences) {
+    const int H = 4, X = 3, T = 5, B = 3;
+    LstmParam param(H, X);
+    LstmLayer batch(param), single(param);
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(X, T * B);
+
+    batch.farward_prop(x, B);
+    for (int n = 0; n < B; n++) {
+        Eigen::MatrixXf xn(X, T);
+        for (int t = 0; t < T; t++) {
+            xn.col(t) = x.col(t * B + n);
+        }
+        single.farward_prop(xn, 1);
+        for (int t = 0; t < T; t++) {
+            EXPECT_LT((batch.h().col(t * B + n) - single.h().col(t)).cwiseAbs().maxCoeff(), 1e-6);
+        }
+    }
+}
+
+TEST(LstmInferenceTest, MatchesLayer) {
+    const int H = 4, X = 3, T = 6;
+    LstmParam param(H, X);
+    LstmLayer layer(param);
+    LstmInference inference(param);
+    LstmSession session = inference.new_session();
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(X, T);
+
+    layer.farward_prop(x, 1);
+    for (int t = 0; t < T; t++) {
+        inference.step(session, x.col(t));
+        EXPECT_LT((session.h - layer.h().col(t)).cwiseAbs().maxCoeff(), 1e-6);
+    }
+}
+
+// B streams stepped together in reverse order through the sessions of inference match the layer
+template <typename Layer, typename Inference>
+static void expect_sessions_match_layer(Layer &layer, Inference &inference, int X, int T, int B) {
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(X, T * B);
+    layer.farward_prop(x, B);
+
+    std::vector<decltype(inference.new_session())> sessions(B, inference.new_session());
+    std::vector<decltype(inference.new_session()) *> reversed;
+    for (int n = B - 1; n >= 0; n--) {
+        reversed.push_back(&sessions[n]);
+    }
+    for (int t = 0; t < T; t++) {
+        Eigen::MatrixXf xt = x.middleCols(t * B, B).rowwise().reverse();
+        inference.step(reversed, xt);
+        for (int n = 0; n < B; n++) {
+            EXPECT_LT((sessions[n].h - layer.h().col(t * B + n)).cwiseAbs().maxCoeff(), 1e-5);
+        }
+    }
+}
+
+TEST(LstmInferenceTest, SessionsMatchLayer) {
+    LstmParam param(4, 3);
+    LstmLayer layer(param);
+    LstmInference inference(param);
+    expect_sessions_match_layer(layer, inference, 3, 6, 3);
+}
+
+TEST(GruInferenceTest, MatchesLayer) {
+    const int H = 4, X = 3, T = 6;
+    GruParam param(H, X);
+    GruLayer layer(param);
+    GruInference inference(param);
+    GruSession session = inference.new_session();
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(X, T);
+
+    layer.farward_prop(x, 1);
+    for (int t = 0; t < T; t++) {
+        inference.step(session, x.col(t));
+        EXPECT_LT((session.h - layer.h().col(t)).cwiseAbs().maxCoeff(), 1e-6);
+    }
+}
+
+TEST(GruInferenceTest, SessionsMatchLayer) {
+    GruParam param(4, 3);
+    GruLayer layer(param);
+    GruInference inference(param);
+    expect_sessions_match_layer(layer, inference, 3, 6, 3);
+}
+
+TEST(GruLayerTest, GradientCheck) {
+    const int H = 5, X = 3;
+    const std::vector<int> batch_sizes = {3, 2, 2, 1};
+    GruParam param(H, X);
+    GruLayer layer(param);
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(X, 8);
+    Eigen::MatrixXf R = Eigen::MatrixXf::Random(H, 8);
+
+    weighted_sum(layer, x, batch_sizes, R);
+    layer.back_prop(R);
+
+    EXPECT_LT(max_gradient_error(layer, param.w.data(), param.w_diff.data(), param.w.size(), x, batch_sizes, R), 1e-3);
+    EXPECT_LT(max_gradient_error(layer, param.b.data(), param.b_diff.data(), param.b.size(), x, batch_sizes, R), 1e-3);
+    EXPECT_LT(max_gradient_error(layer, param.b_hn.data(), param.b_hn_diff.data(), param.b_hn.size(), x, batch_sizes, R), 1e-3);
+}
+
+// MSE loss of the trainer, between the first y.rows() rows of h and y
+static double mse_sum(const Eigen::MatrixXf &h, const Eigen::MatrixXf &y) {
+    return 0.5 * (h.topRows(y.rows()) - y).cast<double>().squaredNorm();
+}
+
+TEST(LstmTbpttTest, OneWindowMatchesBptt) {
+    const int H = 4, X = 3, Y = 2, T = 5, B = 2;
+    LstmParam param(H, X);
+    LstmParam reference = param;
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(X, T * B);
+    Eigen::MatrixXf y = Eigen::MatrixXf::Random(Y, T * B);
+
+    LstmTbpttTrainer trainer(param, T, T, 1.0f);
+    trainer.train(x, y, B);
+
+    LstmLayer layer(reference);
+    layer.farward_prop(x, B);
+    Eigen::MatrixXf top_diff_h = Eigen::MatrixXf::Zero(H, T * B);
+    top_diff_h.topRows(Y) = layer.h().topRows(Y) - y;
+    layer.back_prop(top_diff_h);
+    reference.param_update(1.0f);
+
+    EXPECT_LT((param.w - reference.w).cwiseAbs().maxCoeff(), 1e-5);
+    EXPECT_LT((param.b - reference.b).cwiseAbs().maxCoeff(), 1e-5);
+}
+
+// loss of a window stepped from the states of sessions
+static double window_loss(const LstmParam &param, std::vector<LstmSession> sessions,
+                          const Eigen::MatrixXf &x, const Eigen::MatrixXf &y) {
+    LstmInference inference(param);
+    const int B = int(sessions.size());
+    double loss = 0;
+    for (int c = 0; c < x.cols(); c++) {
+        inference.step(sessions[c % B], x.col(c));
+        loss += mse_sum(sessions[c % B].h, y.col(c));
+    }
+    return loss;
+}
+
+TEST(LstmTbpttTest, CarriedStateIsDetached) {
+    const int H = 4, X = 3, Y = 2, K = 3, B = 2;
+    LstmParam param(H, X);
+    LstmParam first = param;
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(X, 2 * K * B);
+    Eigen::MatrixXf y = Eigen::MatrixXf::Random(Y, 2 * K * B);
+
+    LstmTbpttTrainer trainer(param, K, K, 1.0f);
+    trainer.train(x.leftCols(K * B), y.leftCols(K * B), B);
+    LstmParam second = param;
+    trainer.train(x.rightCols(K * B), y.rightCols(K * B), B);
+
+    // states carried into the second window, computed with the parameters of the first one
+    LstmInference inference(first);
+    std::vector<LstmSession> sessions(B, inference.new_session());
+    for (int c = 0; c < K * B; c++) {
+        inference.step(sessions[c % B], x.col(c));
+    }
+
+    // the update of the second window is its gradient with the carried states held constant
+    Eigen::MatrixXf x2 = x.rightCols(K * B), y2 = y.rightCols(K * B);
+    const float eps = 1e-2;
+    double max_err = 0;
+    for (int k = 0; k < second.w.size(); k++) {
+        float origin = second.w(k);
+        second.w(k) = origin + eps;
+        double loss_plus = window_loss(second, sessions, x2, y2);
+        second.w(k) = origin - eps;
+        double loss_minus = window_loss(second, sessions, x2, y2);
+        second.w(k) = origin;
+        double diff = second.w(k) - param.w(k);
+        max_err = std::max(max_err, std::abs((loss_plus - loss_minus) / (2 * eps) - diff));
+    }
+    EXPECT_LT(max_err, 1e-3);
+}
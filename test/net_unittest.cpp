@@ -0,0 +1,48 @@
+//
+// Created by 芦yafei  on 17/9/6.
+//
+
+#include "net.h"
+#include "optimizer.h"
+#include "loss_function.h"
+#include "random.h"
+#include <gtest/gtest.h>
+
+using namespace lu_net;
+
+// change of the parameters by one gradient descent step over two samples, hidden layers with dropout keep_prob
+static Eigen::VectorXf one_step(bool mixed_precision, float keep_prob) {
+    std::vector<vec_t> x(2, vec_t(8));
+    std::vector<label_t> y = {1, 3};
+    for (int i = 0; i < 8; i++) {
+        x[0][i] = 0.1f * i;
+        x[1][i] = 1 - 0.1f * i;
+    }
+
+    Net net;
+    net.initNet({8, 16, 12, 10}, 1.0, 0);
+    set_random_seed(11);
+    net.initWeights(0);
+    net.initBias(0);
+    net.set_dropout(1, keep_prob);
+    net.set_dropout(2, keep_prob);
+    net.mixed_precision = mixed_precision;
+
+    Eigen::VectorXf before = net.get_params();
+    optimizer::gradient_descent op;
+    net.train<cross_entropy>(op, x, y, 2, 1);
+    return net.get_params() - before;
+}
+
+// the mixed precision backward through dropout, a * (1 - keep * a) on the scaled activations, gives the
+// gradient of the per-sample path up to bf16 rounding, both draw the same masks
+TEST(NetDropoutTest, MixedMatchesPerSample) {
+    Eigen::VectorXf per_sample = one_step(false, 0.5f);
+    Eigen::VectorXf mixed = one_step(true, 0.5f);
+    EXPECT_LT((mixed - per_sample).norm(), 1e-2 * per_sample.norm());
+
+    // and dropout does change the step
+    Eigen::VectorXf no_dropout = one_step(false, 1.0f);
+    EXPECT_GT((no_dropout - per_sample).norm(), 0.1 * per_sample.norm());
+    EXPECT_LT((one_step(true, 1.0f) - no_dropout).norm(), 1e-2 * no_dropout.norm());
+}
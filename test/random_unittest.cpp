@@ -0,0 +1,111 @@
+//
+// Created by 芦yafei  on 17/9/8.
+//
+
+#include "random.h"
+#include "cpu_dispatch.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace lu_net;
+
+// known answers of Philox4x32-10 from the kat_vectors of Random123: counter, key, output
+TEST(PhiloxTest, KnownAnswers) {
+    const uint32_t kat[3][10] = {
+            {0, 0, 0, 0, 0, 0, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+            {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                    0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+            {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+                    0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+    for (const uint32_t *k : kat) {
+        uint32_t out[4];
+        philox4x32_10(k, k + 4, out);
+        for (int i = 0; i < 4; i++) {
+            EXPECT_EQ(out[i], k[6 + i]);
+        }
+    }
+}
+
+class RandomStreamTest : public ::testing::Test {
+protected:
+    void TearDown() override { set_cpu_level(detect_cpu_level()); }
+};
+
+// the bulk kernels of every level give the uniforms of the scalar stream bit for bit, and its normals up to
+// rounding, the scalar stream draws them four at a time through the tail of the same kernel
+TEST_F(RandomStreamTest, BulkMatchesScalarAtEveryLevel) {
+    const long size = 1001;
+    for (int level = int(cpu_level::generic); level <= int(detect_cpu_level()); level++) {
+        set_cpu_level(cpu_level(level));
+        random_stream bulk(42, stream_id(3, 7)), scalar(42, stream_id(3, 7));
+        std::vector<float> u(size);
+        bulk.uniform(u.data(), size, -1, 1);
+        for (long i = 0; i < size; i++) {
+            ASSERT_EQ(u[i], scalar.uniform(-1, 1)) << cpu_level_name(get_cpu_level()) << " value " << i;
+        }
+
+        // the scalar stream drops the rest of its last block, the bulk one never starts a block it does not use
+        scalar.seek(bulk.block());
+        std::vector<float> g(size);
+        bulk.gaussian(g.data(), size, 1, 2);
+        for (long i = 0; i < size; i++) {
+            ASSERT_NEAR(g[i], scalar.gaussian(1, 2), 2e-5f) << cpu_level_name(get_cpu_level()) << " value " << i;
+        }
+    }
+}
+
+// uniforms are integer arithmetic and agree across levels exactly, normals up to the rounding of log and sincos
+TEST_F(RandomStreamTest, LevelsAgree) {
+    const long size = 1003;
+    std::vector<float> u0(size), g0(size), u(size), g(size);
+    set_cpu_level(cpu_level::generic);
+    random_stream generic(7, 1);
+    generic.uniform(u0.data(), size, 0, 1);
+    generic.gaussian(g0.data(), size, 0, 1);
+    for (int level = int(cpu_level::generic) + 1; level <= int(detect_cpu_level()); level++) {
+        set_cpu_level(cpu_level(level));
+        random_stream s(7, 1);
+        s.uniform(u.data(), size, 0, 1);
+        s.gaussian(g.data(), size, 0, 1);
+        for (long i = 0; i < size; i++) {
+            EXPECT_EQ(u[i], u0[i]) << cpu_level_name(get_cpu_level());
+            EXPECT_NEAR(g[i], g0[i], 1e-5f) << cpu_level_name(get_cpu_level());
+        }
+    }
+}
+
+// bit j of a mask is uniform(0, 1)[j] < p of the same stream, at every level, and the bits past size are clear
+TEST_F(RandomStreamTest, MaskMatchesUniformAtEveryLevel) {
+    const long size = 1000;
+    const float p = 0.3f;
+    for (int level = int(cpu_level::generic); level <= int(detect_cpu_level()); level++) {
+        set_cpu_level(cpu_level(level));
+        random_stream masks(3, 9), uniforms(3, 9);
+        std::vector<uint32_t> mask((size + 31) / 32);
+        std::vector<float> u(size);
+        masks.bernoulli(mask.data(), size, p);
+        uniforms.uniform(u.data(), size, 0, 1);
+        for (long j = 0; j < size; j++) {
+            EXPECT_EQ(bool(mask[j / 32] >> (j % 32) & 1u), u[j] < p) << cpu_level_name(get_cpu_level()) << " bit " << j;
+        }
+        EXPECT_EQ(mask.back() >> (size % 32), 0u);
+        EXPECT_EQ(masks.block(), uniforms.block());
+    }
+}
+
+// value i of a stream depends on the seed, the stream and i only
+TEST_F(RandomStreamTest, SeekReproduces) {
+    random_stream a(5, 9), b(5, 9), other(5, 10);
+    std::vector<float> first(64), again(64), different(64);
+    a.uniform(first.data(), 64, 0, 1);
+    a.seek(0);
+    a.uniform(again.data(), 64, 0, 1);
+    EXPECT_EQ(first, again);
+
+    b.seek(8);
+    b.uniform(again.data(), 32, 0, 1);
+    EXPECT_TRUE(std::equal(again.begin(), again.begin() + 32, first.begin() + 32));
+
+    other.uniform(different.data(), 64, 0, 1);
+    EXPECT_NE(first, different);
+}
@@ -0,0 +1,77 @@
+//
+// Created by 芦yafei  on 17/8/16.
+//
+
+#include "sequence_dataset.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+
+using namespace lu_net;
+
+// sequences of the given lengths, x(0, t) = 10 * sequence + t and y(0, t) = -x(0, t)
+static SequenceDataset make_dataset(const std::vector<int> &lengths) {
+    SequenceDataset dataset;
+    for (size_t i = 0; i < lengths.size(); i++) {
+        Eigen::MatrixXf x(2, lengths[i]);
+        for (int t = 0; t < lengths[i]; t++) {
+            x(0, t) = 10.0f * i + t;
+            x(1, t) = 1.0f;
+        }
+        dataset.add(x, -x.topRows(1));
+    }
+    return dataset;
+}
+
+// every column of batch is step t of sequence index[n] at offset(t) + n, and nothing else
+static void expect_packed(const SequenceDataset &dataset, const SequenceBatch &batch) {
+    long offset = 0;
+    for (int t = 0; t < batch.steps(); t++) {
+        for (int n = 0; n < batch.batch_sizes[t]; n++) {
+            EXPECT_EQ(batch.x.col(offset + n), dataset.x(batch.index[n]).col(t));
+            EXPECT_EQ(batch.y.col(offset + n), dataset.y(batch.index[n]).col(t));
+        }
+        offset += batch.batch_sizes[t];
+    }
+    EXPECT_EQ(offset, batch.x.cols());
+}
+
+TEST(SequenceBatcherTest, PacksLongestFirstWithoutPadding) {
+    SequenceDataset dataset = make_dataset({3, 5, 1, 5, 2});
+    SequenceBatcher batcher(dataset, 3, false);
+    EXPECT_EQ(batcher.batches(), 2u);
+
+    // without shuffle ties keep the dataset order: 1, 3, 0 then 4, 2
+    SequenceBatch batch;
+    ASSERT_TRUE(batcher.next(batch));
+    EXPECT_EQ(batch.index, std::vector<size_t>({1, 3, 0}));
+    EXPECT_EQ(batch.batch_sizes, std::vector<int>({3, 3, 3, 2, 2}));
+    EXPECT_EQ(batch.x.cols(), 13);
+    EXPECT_EQ(batch.padded_cols(), 15);
+    expect_packed(dataset, batch);
+
+    ASSERT_TRUE(batcher.next(batch));
+    EXPECT_EQ(batch.index, std::vector<size_t>({4, 2}));
+    EXPECT_EQ(batch.batch_sizes, std::vector<int>({2, 1}));
+    expect_packed(dataset, batch);
+
+    EXPECT_FALSE(batcher.next(batch));
+}
+
+TEST(SequenceBatcherTest, ShuffledEpochCoversEverySequenceOnce) {
+    SequenceDataset dataset = make_dataset({4, 2, 7, 2, 4, 1, 3});
+    SequenceBatcher batcher(dataset, 2, true);
+    for (int epoch = 0; epoch < 3; epoch++) {
+        batcher.begin_epoch();
+        std::vector<size_t> seen;
+        SequenceBatch batch;
+        while (batcher.next(batch)) {
+            for (size_t n = 1; n < batch.index.size(); n++) {
+                EXPECT_GE(dataset.length(batch.index[n - 1]), dataset.length(batch.index[n]));
+            }
+            expect_packed(dataset, batch);
+            seen.insert(seen.end(), batch.index.begin(), batch.index.end());
+        }
+        std::sort(seen.begin(), seen.end());
+        EXPECT_EQ(seen, std::vector<size_t>({0, 1, 2, 3, 4, 5, 6}));
+    }
+}
@@ -0,0 +1,95 @@
+//
+// Created by 芦yafei  on 17/9/14.
+//
+
+#include "sequential.h"
+#include <gtest/gtest.h>
+
+using namespace lu_net;
+
+// loss = sum(out .* R), so the gradient by the output is R
+static double weighted_sum(sequential &net, const Eigen::MatrixXf &x, const Eigen::MatrixXf &R) {
+    return (net.farward(x).array() * R.array()).cast<double>().sum();
+}
+
+TEST(SequentialTest, GradientCheck) {
+    sequential net(4);
+    net.add(std::make_shared<layers::fully_connected>(6)).add(std::make_shared<layers::sigmoid>())
+       .add(std::make_shared<layers::fully_connected>(5, weight_init::scheme::he)).add(std::make_shared<layers::relu>())
+       .add(std::make_shared<layers::fully_connected>(3, weight_init::scheme::orthogonal));
+    net.init_params(7);
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(4, 5);
+    Eigen::MatrixXf R = Eigen::MatrixXf::Random(3, 5);
+
+    net.farward(x, net_phase::train);
+    net.grads().setZero();
+    net.backward(R);
+
+    const float eps = 1e-2;
+    double max_err = 0;
+    Eigen::VectorXf &w = net.params();
+    for (long k = 0; k < w.size(); k++) {
+        float origin = w[k];
+        w[k] = origin + eps;
+        double loss_plus = weighted_sum(net, x, R);
+        w[k] = origin - eps;
+        double loss_minus = weighted_sum(net, x, R);
+        w[k] = origin;
+        max_err = std::max(max_err, std::abs((loss_plus - loss_minus) / (2 * eps) - net.grads()[k]));
+    }
+    EXPECT_LT(max_err, 1e-3);
+}
+
+TEST(SequentialTest, BackwardAfterTemporaryInput) {
+    sequential net(4);
+    net.add(std::make_shared<layers::fully_connected>(3)).add(std::make_shared<layers::sigmoid>());
+    net.init_params(5);
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(4, 6);
+    Eigen::MatrixXf R = Eigen::MatrixXf::Random(3, 6);
+
+    Eigen::MatrixXf x2 = 2 * x;
+    net.farward(x2, net_phase::train);
+    net.grads().setZero();
+    net.backward(R);
+    Eigen::VectorXf expected = net.grads();
+
+    // the input is an expression, Ref materializes it into a temporary gone before backward
+    net.farward(2 * x, net_phase::train);
+    net.grads().setZero();
+    net.backward(R);
+    EXPECT_LT((net.grads() - expected).cwiseAbs().maxCoeff(), 1e-6);
+}
+
+TEST(SequentialTest, SharesBuffersNotNeededByBackward) {
+    sequential net(8);
+    net.add(std::make_shared<layers::fully_connected>(16)).add(std::make_shared<layers::sigmoid>())
+       .add(std::make_shared<layers::fully_connected>(16)).add(std::make_shared<layers::relu>())
+       .add(std::make_shared<layers::dropout>(0.5f))
+       .add(std::make_shared<layers::fully_connected>(4)).add(std::make_shared<layers::sigmoid>());
+    net.init_params(1);
+
+    // the outputs of the fully_connected layers are read by nothing in backward, neither is the one of relu
+    EXPECT_EQ(net.buffers(net_phase::train), 5);
+    EXPECT_EQ(net.buffers(net_phase::test), 2);
+
+    // the result does not depend on the phase which planned the buffers
+    Eigen::MatrixXf x = Eigen::MatrixXf::Random(8, 3);
+    Eigen::MatrixXf test = net.farward(x);
+    net.farward(x, net_phase::train);
+    EXPECT_LT((Eigen::MatrixXf(net.farward(x)) - test).cwiseAbs().maxCoeff(), 1e-6);
+}
+
+TEST(SequentialTest, DropoutOnlyInTrainPhase) {
+    const float keep_prob = 0.25f;
+    sequential net(1000);
+    net.add(std::make_shared<layers::dropout>(keep_prob));
+    net.init_params(3);
+    Eigen::MatrixXf x = Eigen::MatrixXf::Constant(1000, 2, 1.0f);
+
+    EXPECT_EQ(Eigen::MatrixXf(net.farward(x)), x);
+
+    Eigen::MatrixXf out = net.farward(x, net_phase::train);
+    long kept = (out.array() != 0).count();
+    EXPECT_NEAR(kept / 2000.0, keep_prob, 0.03);
+    EXPECT_TRUE(((out.array() == 0) || (out.array() == 1 / keep_prob)).all());
+}